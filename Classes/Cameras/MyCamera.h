@@ -1,6 +1,6 @@
 #pragma once
 
-class MyCamera {
+class MyCamera : public SceneAttachment {
 
 public:
     glm::vec3 position; //position of the camera in the world
@@ -10,6 +10,7 @@ public:
     float distance; //distance from the camera to the target
     glm::mat4 viewMatrix; //view matrix
     glm::mat4 projectionMatrix; //projection matrix
+    glm::vec3 renderPosition, renderTarget; //position and target used when drawing
 
     //constructor for the camera class
     MyCamera(glm::vec3 position, glm::vec3 target, glm::vec3 up, float zNear, float zFar) {
@@ -18,15 +19,28 @@ public:
         this->up = up;
         this->zNear = zNear;
         this->zFar = zFar;
+        renderPosition = position;
+        renderTarget = target;
         distance = glm::length(target - position); //computes for the distance from the camera to its target
     }
 
+    //places the camera at the origin of a node looking along the z axis of the node
+    void followTransform(glm::mat4 worldTransform) override {
+        position = glm::vec3(worldTransform[3]);
+        target = position + distance * glm::normalize(glm::vec3(worldTransform[2]));
+    }
+
+    //computes for the view matrix from the position and target used when drawing
+    void computeViewMatrix() {
+        viewMatrix = glm::lookAt(renderPosition, renderTarget, up);
+    }
+
     //set the value of the view matrix in the shader
     void setViewMatrix(Shader shader) {
         shader.useProgram();
 
         //computes for the view matrix
-        viewMatrix = glm::lookAt(position, target, up);
+        computeViewMatrix();
 
         //set the value of the view matrix in the shader
         unsigned int viewLoc = glGetUniformLocation(shader.shaderProgram, "view");
@@ -38,9 +52,18 @@ public:
 
         //set the value of the cameraPos in the shader
         unsigned int cameraPosLoc = glGetUniformLocation(shader.shaderProgram, "cameraPos");
-        glUniform3fv(cameraPosLoc, 1, glm::value_ptr(position));
+        glUniform3fv(cameraPosLoc, 1, glm::value_ptr(renderPosition));
     }
 
+    //updates the position and target used when drawing, cameras that are simulated blend the last two ticks
+    virtual void interpolate(float /*alpha*/) {
+        renderPosition = position;
+        renderTarget = target;
+    }
+
+    //pure virtual function that computes for the projection matrix
+    virtual void computeProjectionMatrix() = 0;
+
     //pure virtual function that sets the value of the projection matrix in the shader
     virtual void setProjectionMatrix(Shader shader) = 0;
 };
\ No newline at end of file
@@ -5,11 +5,22 @@ class OrthoCamera : public MyCamera {
 public:
     float xLast, yLast; //stores the last cursor position
     bool isInitialized;//checks if the values of xLast and yLast have been initialized
+    glm::vec3 previousPosition, previousTarget; //position and target at the previous simulation tick
+
+    static constexpr float PAN_SPEED = 30.0f; //units per second
+    static constexpr float MOUSE_SENSITIVITY = 0.01f; //units of panning per pixel of cursor movement
 
     //constructor for the orthographic camera class
     OrthoCamera(glm::vec3 position, glm::vec3 target, glm::vec3 up, float zNear, float zFar) : MyCamera(position, target, up, zNear, zFar) {
         xLast = yLast = 0.0f;
         isInitialized = false;
+        previousPosition = position;
+        previousTarget = target;
+    }
+
+    //compute for the projection matrix
+    void computeProjectionMatrix() override {
+        projectionMatrix = glm::ortho(-WIDTH / 50, WIDTH / 50, -HEIGHT / 50, HEIGHT / 50, zNear, zFar);
     }
 
     //set the value of the projection matrix in the shader
@@ -17,39 +28,63 @@ public:
         shader.useProgram();
 
         //compute for the projection matrix
-        projectionMatrix = glm::ortho(-WIDTH / 50, WIDTH / 50, -HEIGHT / 50, HEIGHT / 50, zNear, zFar);
+        computeProjectionMatrix();
 
         //set the value of the projection matrix in the shader
         unsigned int projectionLoc = glGetUniformLocation(shader.shaderProgram, "projection");
         glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projectionMatrix));
     }
 
-    //process keyboard inputs and update the object attributes
-    void processKeyboard(int key) {
-        float sensitivity = 1.0f;
+    //saves the state of the camera before a simulation tick changes it
+    void storePreviousState() {
+        previousPosition = position;
+        previousTarget = target;
+    }
+
+    //blends the state of the last two simulation ticks to get the position and target used when drawing
+    void interpolate(float alpha) override {
+        renderPosition = glm::mix(previousPosition, position, alpha);
+        renderTarget = glm::mix(previousTarget, target, alpha);
+    }
+
+    //moves the camera to a new position without blending from the old one
+    void snap() {
+        storePreviousState();
+        renderPosition = position;
+        renderTarget = target;
+    }
+
+    //pans the camera based on the held keys over a simulation tick of deltaTime seconds
+    void update(InputState& input, float deltaTime) {
+        float distance = PAN_SPEED * deltaTime;
 
         // traverse forward
-        if (key == GLFW_KEY_W) {           
-            position.z -= sensitivity;
-            target.z -= sensitivity;
+        if (input.isForward) {
+            position.z -= distance;
+            target.z -= distance;
         }
         // traverse backward
-        if (key == GLFW_KEY_S) {
-            position.z += sensitivity;
-            target.z += sensitivity;
+        if (input.isBackward) {
+            position.z += distance;
+            target.z += distance;
         }
         // rotate to left
-        if (key == GLFW_KEY_A) {
-            position.x -= sensitivity;
-            target.x -= sensitivity;
+        if (input.isLeft) {
+            position.x -= distance;
+            target.x -= distance;
         }
         // rotate to right
-        if (key == GLFW_KEY_D) {
-            position.x += sensitivity;
-            target.x += sensitivity;
+        if (input.isRight) {
+            position.x += distance;
+            target.x += distance;
         }
     }
 
+    //computes how far a drag of the cursor pans the camera
+    static glm::vec3 getPanOffset(float xDiff, float yDiff) {
+        return glm::vec3(xDiff * MOUSE_SENSITIVITY, 0.0f, -yDiff * MOUSE_SENSITIVITY);
+    }
+
     //process the mouse inputs and updates the object attributes
     void processMouse(float xPos, float yPos, bool isValid) {
         //initialize the value of xLast and yLast
@@ -59,8 +94,6 @@ public:
             isInitialized = true;
         }
 
-        float sensitivity = 0.01f; //controls rotation senstivity
-
         //compute the displacement from the previous position
         float xDiff = xPos - xLast;
         float yDiff = yLast - yPos;
@@ -72,11 +105,13 @@ public:
         // update only when the mouse movement is valid(i.e., cursor was used to drag the view)
         if (isValid) {
             //update camera position and target based on camera movement
-            position.x += xDiff * sensitivity;
-            target.x += xDiff * sensitivity;
+            glm::vec3 offset = getPanOffset(xDiff, yDiff);
+            position += offset;
+            target += offset;
 
-            position.z -= yDiff * sensitivity;
-            target.z -= yDiff * sensitivity;
+            //drags are applied right away, so shift the previous tick as well to avoid blending them in
+            previousPosition += offset;
+            previousTarget += offset;
         }
     }
 
@@ -11,6 +11,8 @@ public:
     float pitch; //the rotation of the camera around the x axis
     float yaw; //the rotation of the camera around the y axis
 
+    static constexpr float MOUSE_SENSITIVITY = 1.0f; //degrees of rotation per pixel of cursor movement
+
     //constructor for the perspective camera class
     PerspectiveCamera(glm::vec3 position, glm::vec3 target, glm::vec3 up, float zNear, float zFar) : MyCamera(position, target, up, zNear, zFar) {
         //initialize values for mouse position
@@ -23,40 +25,67 @@ public:
         distance = glm::length(position - target); //calculate the distance from the camera to the target
     }
 
-    //set the value of the projection matrix in the shader
-    void setProjectionMatrix(Shader shader) override {
-        shader.useProgram();
-
-        //compute for the projection matrix
+    //compute for the projection matrix
+    void computeProjectionMatrix() override {
         projectionMatrix = glm::perspective(
             glm::radians(45.0f),
             WIDTH / HEIGHT,
             zNear,
             zFar
         );
+    }
+
+    //set the value of the projection matrix in the shader
+    void setProjectionMatrix(Shader shader) override {
+        shader.useProgram();
+
+        //compute for the projection matrix
+        computeProjectionMatrix();
 
         //set the value of the projection matrix in the shader
         unsigned int projectionLoc = glGetUniformLocation(shader.shaderProgram, "projection");
         glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projectionMatrix));
     }
 
-    //update the fields for the first perspective camera
-    void updateFields(glm::vec3 position, glm::vec3 direction) {
-        this->position = position;
-        this->target = position + distance * direction;
+    //computes the direction from the camera to the point it orbits from the values of yaw and pitch
+    static glm::vec3 getOrbitDirection(float yaw, float pitch) {
+        glm::vec3 forward;
+        forward.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch)); //the x component is influenced by the x component of the yaw and pitch
+        forward.y = sin(glm::radians(pitch)); //the y component is influenced by the y component of the pitch
+        forward.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));//the z component is influenced by the y component of the yaw and the x component of the pitch
+        return glm::normalize(forward);
     }
 
-    //update the fields for the third perspective camera
-    void updateFields(glm::vec3 position) {
-        //recompute the position of the camera depending on the values of yaw and pitch
-        glm::vec3 newPosition;
-        newPosition.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch)); //the x component is influenced by the x component of the yaw and pitch
-        newPosition.y = sin(glm::radians(pitch)); //the y component is influenced by the y component of the pitch
-        newPosition.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));//the z component is influenced by the y component of the yaw and the x component of the pitch
-        newPosition = distance * glm::normalize(newPosition); //ensure that the distance between the camera and the target relative to the camera position is always the same
-
-        this->position = position - newPosition;
-        this->target = position;
+    //limits the pitch so that lookAt does not flip
+    static float clampPitch(float pitch) {
+        //prevent lookAt flip by limiting the rotation along the x-axis to be greater than -90 deegress
+        if (pitch < -90.0f) {
+            pitch = -89.99f;
+        }
+
+        //prevent lookAt flip by limiting the rotation along the x-axis to be less than 90 deegress
+        if (pitch > 90.0f) {
+            pitch = 89.99f;
+        }
+
+        return pitch;
+    }
+
+    //computes the placement of the camera relative to the point it orbits from the values of yaw and pitch
+    //the camera is moved back from the point and its z axis faces the point
+    glm::mat4 getOrbitTransform() {
+        glm::vec3 forward = getOrbitDirection(yaw, pitch);
+
+        glm::vec3 right = glm::normalize(glm::cross(up, forward));
+        glm::vec3 cameraUp = glm::cross(forward, right);
+
+        glm::mat4 orbitTransform = glm::mat4(1.0f);
+        orbitTransform[0] = glm::vec4(right, 0.0f);
+        orbitTransform[1] = glm::vec4(cameraUp, 0.0f);
+        orbitTransform[2] = glm::vec4(forward, 0.0f);
+        orbitTransform[3] = glm::vec4(-distance * forward, 1.0f); //ensure that the distance between the camera and the target is always the same
+
+        return orbitTransform;
     }
 
     //process the mouse inputs and updates the object attributes
@@ -68,8 +97,6 @@ public:
             isInitialized = true;
         }
 
-        float sensitivity = 1.0f; //controls rotation senstivity
-
         //compute the displacement from the previous position
         float xDiff = xPos - xLast;
         float yDiff = yLast - yPos;
@@ -81,18 +108,8 @@ public:
         //update only when the mouse movement is valid (i.e., cursor was used to drag the view)
         if (isValid) {
             //updates the value of the pitch and yaw
-            yaw += xDiff * sensitivity;
-            pitch += yDiff * sensitivity;
-
-            //prevent lookAt flip by limiting the rotation along the x-axis to be greater than -90 deegress
-            if (pitch < -90.0f) {
-                pitch = -89.99f;
-            }
-
-            //prevent lookAt flip by limiting the rotation along the x-axis to be less than 90 deegress
-            if (pitch > 90.0f) {
-                pitch = 89.99f;
-            }
+            yaw += xDiff * MOUSE_SENSITIVITY;
+            pitch = clampPitch(pitch + yDiff * MOUSE_SENSITIVITY);
         }
         
     }
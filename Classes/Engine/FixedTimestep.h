@@ -0,0 +1,46 @@
+#pragma once
+
+//FixedTimestep class converts the variable time between frames into a whole number of fixed length simulation ticks
+class FixedTimestep {
+public:
+    double tickLength; //length of a simulation tick in seconds
+    double maxFrameTime; //longest frame that is simulated in full, longer frames are slowed down instead of spiralling
+    double accumulator; //time that has passed but has not been simulated yet
+    double lastTime; //time when the previous frame started, negative before the first frame
+    long long tickCount; //number of ticks simulated so far
+
+    //constructor for the fixed timestep class
+    FixedTimestep(double ticksPerSecond) {
+        tickLength = 1.0 / ticksPerSecond;
+        maxFrameTime = 0.25;
+        accumulator = 0.0;
+        lastTime = -1.0;
+        tickCount = 0;
+    }
+
+    //adds the time since the previous frame and returns the number of ticks that should be simulated this frame
+    int advance(double currentTime) {
+        //nothing has elapsed before the first frame
+        if (lastTime < 0.0) {
+            lastTime = currentTime;
+        }
+
+        double frameTime = glm::min(currentTime - lastTime, maxFrameTime);
+        lastTime = currentTime;
+        accumulator += frameTime;
+
+        int ticks = 0;
+        while (accumulator >= tickLength) {
+            accumulator -= tickLength;
+            ticks++;
+        }
+        tickCount += ticks;
+
+        return ticks;
+    }
+
+    //returns how far the current frame is between the previous tick and the next one, from 0 to 1
+    float getAlpha() {
+        return (float)(accumulator / tickLength);
+    }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+//FrameLimiter class caps how many frames the gpu can fall behind the cpu by waiting on a fence of an older frame
+//
+//the driver queues frames ahead when the gpu is the bottleneck, and every queued frame is another frame between
+//reading the input and showing it. waiting until the gpu finished frame N - maxFramesInFlight before frame N samples
+//its input keeps that queue short.
+class FrameLimiter {
+public:
+    int maxFramesInFlight; //number of frames the gpu may fall behind, 0 to not wait at all
+    std::deque<GLsync> fences; //fences placed after the frames that were not finished by the gpu yet
+
+    //constructor for the frame limiter class
+    FrameLimiter(int maxFramesInFlight) {
+        this->maxFramesInFlight = maxFramesInFlight;
+    }
+
+    //destructor for the frame limiter class
+    ~FrameLimiter() {
+        for (int i = 0; i < fences.size(); i++) {
+            glDeleteSync(fences[i]);
+        }
+    }
+
+    //blocks until the gpu has room for another frame
+    void waitForGpu() {
+        PROFILE_ZONE("FrameLimiter::waitForGpu");
+
+        while (maxFramesInFlight > 0 && fences.size() >= maxFramesInFlight) {
+            //flush so that the fence is sent to the gpu, and wake up every second to report a gpu that is stuck
+            GLenum result = glClientWaitSync(fences.front(), GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            if (result == GL_TIMEOUT_EXPIRED) {
+                LOG_WARNING("FRAME LIMITER", "[FRAME LIMITER] The gpu has not finished a frame for a second, still waiting");
+                continue;
+            }
+
+            //a fence that cannot be waited on never signals, so it is dropped
+            if (result == GL_WAIT_FAILED) {
+                LOG_ERROR("FRAME LIMITER", "[FRAME LIMITER] Waiting on the fence of a frame failed");
+            }
+            glDeleteSync(fences.front());
+            fences.pop_front();
+        }
+    }
+
+    //places a fence after the gl calls of the frame that was just submitted
+    void endFrame() {
+        if (maxFramesInFlight > 0) {
+            fences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        }
+    }
+};
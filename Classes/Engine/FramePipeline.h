@@ -0,0 +1,81 @@
+#pragma once
+
+//FramePipeline class overlaps the simulation of the next frame with the submission of the current one
+//
+//the job system runs the simulation, visibility tests, and draw packet building of frame N+1 into the back snapshot
+//while the main thread issues the gl calls of frame N from the front snapshot. the two snapshots are swapped once both
+//stages are done, so a frame costs the longer of the two stages instead of their sum, at the price of one frame of latency.
+class FramePipeline {
+public:
+    RenderSnapshot* snapshots[2]; //snapshots that are alternately built and submitted
+    int frontIndex; //index of the snapshot that is submitted by the main thread
+
+    JobSystem* jobSystem; //runs the jobs that build the back snapshot
+    JobCounter simulateCounter; //counts the job that simulates the next frame
+    JobCounter buildCounter; //counts the job that builds the back snapshot once the simulation is done
+    std::function<void()> simulateTask; //simulation of the frame that is being built
+    std::function<void(RenderSnapshot&)> buildTask; //records the simulated frame into the back snapshot
+
+    std::chrono::steady_clock::time_point buildStart; //time when the simulation of the next frame started
+    double buildMilliseconds; //time the jobs spent on the last snapshot
+
+    //constructor for the frame pipeline class which takes ownership of the two snapshots
+    FramePipeline(JobSystem* jobSystem, RenderSnapshot* front, RenderSnapshot* back) {
+        this->jobSystem = jobSystem;
+        snapshots[0] = front;
+        snapshots[1] = back;
+        frontIndex = 0;
+        buildMilliseconds = 0.0;
+    }
+
+    //destructor for the frame pipeline class
+    ~FramePipeline() {
+        //the jobs may still be writing to the back snapshot
+        waitForBuild();
+
+        delete snapshots[0];
+        delete snapshots[1];
+    }
+
+    //returns the snapshot that is submitted by the main thread
+    RenderSnapshot& getFront() {
+        return *snapshots[frontIndex];
+    }
+
+    //returns the snapshot that is built by the jobs
+    RenderSnapshot& getBack() {
+        return *snapshots[1 - frontIndex];
+    }
+
+    //queues the simulation of the next frame followed by the job that records it into the back snapshot
+    //
+    //the tasks are kept in the pipeline and the jobs only capture pointers, which keeps the jobs small enough that
+    //std::function does not allocate them
+    void beginBuild(const std::function<void()>& simulate, const std::function<void(RenderSnapshot&)>& build) {
+        RenderSnapshot* back = &getBack();
+        simulateTask = simulate;
+        buildTask = build;
+
+        jobSystem->run([this]() {
+            buildStart = std::chrono::steady_clock::now();
+            simulateTask();
+        }, &simulateCounter);
+
+        jobSystem->runAfter(&simulateCounter, [this, back]() {
+            buildTask(*back);
+            buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+        }, &buildCounter);
+    }
+
+    //runs jobs on the calling thread until the back snapshot has been built
+    void waitForBuild() {
+        PROFILE_ZONE("FramePipeline::waitForBuild");
+
+        jobSystem->wait(&buildCounter);
+    }
+
+    //makes the snapshot that was just built the one that is submitted next
+    void swap() {
+        frontIndex = 1 - frontIndex;
+    }
+};
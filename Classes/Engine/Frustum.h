@@ -0,0 +1,46 @@
+#pragma once
+
+//Frustum class stores the six clipping planes of a camera and tests bounding spheres against them
+class Frustum {
+public:
+    glm::vec4 planes[6]; //left, right, bottom, top, near, and far planes as (normal, distance) pointing inwards
+
+    //constructor for the frustum class
+    Frustum() {
+        for (int i = 0; i < 6; i++) {
+            planes[i] = glm::vec4(0.0f);
+        }
+    }
+
+    //extracts the planes from the combined projection and view matrix
+    void extract(glm::mat4 viewProjection) {
+        //glm stores the matrix by columns so the rows are gathered from every column
+        glm::vec4 rows[4];
+        for (int i = 0; i < 4; i++) {
+            rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        }
+
+        planes[0] = rows[3] + rows[0];
+        planes[1] = rows[3] - rows[0];
+        planes[2] = rows[3] + rows[1];
+        planes[3] = rows[3] - rows[1];
+        planes[4] = rows[3] + rows[2];
+        planes[5] = rows[3] - rows[2];
+
+        //normalize the planes so that the distances are in world units
+        for (int i = 0; i < 6; i++) {
+            planes[i] /= glm::length(glm::vec3(planes[i]));
+        }
+    }
+
+    //checks if a sphere is at least partially inside the frustum
+    bool isSphereVisible(glm::vec3 center, float radius) {
+        for (int i = 0; i < 6; i++) {
+            if (glm::dot(glm::vec3(planes[i]), center) + planes[i].w < -radius) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+//stores a key, cursor, or mouse button event from the window callbacks together with the time it arrived
+struct InputEvent {
+    static const int KEY = 0; //a key was pressed, released, or repeated
+    static const int CURSOR = 1; //the cursor moved
+    static const int MOUSE_BUTTON = 2; //a mouse button was pressed or released
+
+    int type; //kind of event
+    int code; //key or mouse button of the event
+    int action; //GLFW_PRESS, GLFW_RELEASE, or GLFW_REPEAT
+    double x, y; //position of the cursor
+    double time; //time of the event in seconds since glfw was initialized
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+//InputQueue class is a fixed size single producer single consumer ring of input events
+//
+//the window callbacks push events on the main thread while glfwPollEvents runs and the simulation job pops them on
+//whichever thread runs it, so the environment is only changed by input at the start of a simulation. each index is
+//written by one side only, so no locks are needed. events that arrive while the ring is full are dropped.
+class InputQueue {
+public:
+    static const int CAPACITY = 1024; //maximum number of queued events, must be a power of two
+    static const int MASK = CAPACITY - 1; //turns an index into a slot of the ring
+
+    std::atomic<unsigned int> head; //index of the oldest event, only changed by the consumer
+    std::atomic<unsigned int> tail; //index after the newest event, only changed by the producer
+    std::vector<InputEvent> events; //ring of queued events
+    std::atomic<int> droppedCount; //number of events lost because the ring was full
+
+    //constructor for the input queue class
+    InputQueue() : events(CAPACITY) {
+        head = 0;
+        tail = 0;
+        droppedCount = 0;
+    }
+
+    //adds an event at the end, only called by the producer
+    bool push(InputEvent& event) {
+        unsigned int t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= CAPACITY) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        events[t & MASK] = event;
+
+        //the event has to be written before the consumer can see the new tail
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    //removes the oldest event, only called by the consumer
+    bool pop(InputEvent& event) {
+        unsigned int h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        event = events[h & MASK];
+
+        //the slot can only be reused once the event has been copied out
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
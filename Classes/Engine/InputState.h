@@ -0,0 +1,27 @@
+#pragma once
+
+//InputState class stores which movement keys are held down at the start of a simulation tick
+class InputState {
+public:
+    bool isForward; //W is held
+    bool isBackward; //S is held
+    bool isLeft; //A is held
+    bool isRight; //D is held
+    bool isAscending; //Q is held
+    bool isDescending; //E is held
+
+    //constructor for the input state class
+    InputState() {
+        isForward = isBackward = isLeft = isRight = isAscending = isDescending = false;
+    }
+
+    //reads the current state of the movement keys from the window
+    void poll(GLFWwindow* window) {
+        isForward = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+        isBackward = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+        isLeft = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+        isRight = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
+        isAscending = glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS;
+        isDescending = glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS;
+    }
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+//LateLatch class redoes the view matrix of a snapshot with the cursor position read right before the frame is drawn
+//
+//a snapshot is built a frame ahead of the one that is drawn, so a camera drag would reach the screen a frame late.
+//the latch only changes the matrices of the snapshot, the camera itself picks the same movement up from the input
+//queue on the next simulation. the models were culled with the old view, so a fast drag can show an object at the
+//edge of the screen a frame late.
+class LateLatch {
+public:
+    //applies the cursor movement since the snapshot was built to its view, returns true if the view changed
+    static bool apply(RenderSnapshot& snapshot, double cursorX, double cursorY) {
+        LatchState& latch = snapshot.latch;
+        if (latch.mode == LatchState::NONE) {
+            return false;
+        }
+
+        //compute the displacement from the position that the camera already moved to
+        float xDiff = (float)(cursorX - latch.cursorX);
+        float yDiff = (float)(latch.cursorY - cursorY);
+        if (xDiff == 0.0f && yDiff == 0.0f) {
+            return false;
+        }
+
+        glm::vec3 position = latch.position;
+        glm::vec3 target = latch.target;
+
+        if (latch.mode == LatchState::ORBIT) {
+            //turn the camera around the point it orbits
+            float yaw = latch.yaw + xDiff * PerspectiveCamera::MOUSE_SENSITIVITY;
+            float pitch = PerspectiveCamera::clampPitch(latch.pitch + yDiff * PerspectiveCamera::MOUSE_SENSITIVITY);
+            float distance = glm::length(target - position);
+            position = target - distance * PerspectiveCamera::getOrbitDirection(yaw, pitch);
+        }
+        else {
+            //move the camera and its target together
+            glm::vec3 offset = OrthoCamera::getPanOffset(xDiff, yDiff);
+            position += offset;
+            target += offset;
+        }
+
+        snapshot.viewMatrix = glm::lookAt(position, target, latch.up);
+        snapshot.cameraPosition = position;
+        return true;
+    }
+};
@@ -0,0 +1,511 @@
+#pragma once
+
+//size and format of a render target that the graph creates
+struct RenderTargetDesc {
+    int width, height; //resolution of the target
+    GLenum format; //internal format, GL_RGBA8, GL_RGBA16F, or GL_DEPTH_COMPONENT24
+
+    //checks if a texture made for one description can hold the other
+    bool operator==(const RenderTargetDesc& other) const {
+        return width == other.width && height == other.height && format == other.format;
+    }
+};
+
+//fixed function state a pass is drawn with, set by the graph before the pass runs
+struct RenderPassState {
+    bool isBlending; //checks if the pass blends with what is already in its targets
+    GLenum blendSource, blendDestination; //blend factors, only read while blending
+    glm::vec4 blendColor; //constant color of the blend factors, only read while blending
+    bool isDepthWriting; //checks if the pass writes depth
+    GLenum depthFunction; //depth test of the pass
+
+    //constructor for the render pass state struct, which starts at the state the rest of the program expects
+    RenderPassState() {
+        isBlending = false;
+        blendSource = GL_ONE;
+        blendDestination = GL_ZERO;
+        blendColor = glm::vec4(0.0f);
+        isDepthWriting = true;
+        depthFunction = GL_LESS;
+    }
+
+    //checks if two passes can follow each other without changing any state
+    bool operator==(const RenderPassState& other) const {
+        if (isBlending != other.isBlending || isDepthWriting != other.isDepthWriting || depthFunction != other.depthFunction) {
+            return false;
+        }
+        return !isBlending || (blendSource == other.blendSource && blendDestination == other.blendDestination && blendColor == other.blendColor);
+    }
+};
+
+//a texture or framebuffer that passes read and write
+struct RenderResource {
+    std::string name; //name shown in the log
+    bool isImported; //checks if the resource is the framebuffer bound when the graph runs instead of a texture of the graph
+    RenderTargetDesc desc; //size and format of a transient target
+    int firstUse, lastUse; //positions in the pass order of the first and last pass that touch a transient target
+    int physical; //index of the texture a transient target is placed in, -1 while it has none
+};
+
+//a step of the frame that declares the resources it reads and writes
+struct RenderPass {
+    std::string name; //name of the gpu scope the pass is measured in
+    std::vector<int> reads; //resources the pass samples
+    std::vector<int> writes; //resources the pass draws into
+    RenderPassState state; //fixed function state the pass is drawn with
+    std::function<void()> execute; //draw calls of the pass
+    bool isCulled; //checks if nothing that reaches an imported resource uses the output of the pass
+    GLuint framebuffer; //framebuffer of the transient targets the pass writes, 0 if it writes the imported framebuffer
+    int width, height; //size of the transient targets the pass writes
+};
+
+//texture that holds the transient targets whose lifetimes do not overlap
+struct PhysicalTarget {
+    RenderTargetDesc desc; //size and format of the texture
+    GLuint texture; //id of the texture
+    int allocation; //id of the texture in the residency manager
+    int lastUse; //position in the pass order of the last pass that uses the texture, only valid while compiling
+};
+
+//RenderGraph class orders the passes of a frame from the resources they declare instead of the order they are written in
+//
+//a pass lists the resources it reads and writes and gives a function with its draw calls. compile turns the
+//declarations into dependencies: a pass that reads a resource comes after the pass that last wrote it, and a pass that
+//writes a resource comes after the passes that used it before. passes that do not lead to an imported resource are
+//culled, and the rest are sorted so that a pass follows its dependencies, preferring the pass with the same state as
+//the previous one and then the order they were added in.
+//
+//transient targets only live from the first to the last pass that uses them in that order, so targets of the same
+//size and format whose lifetimes do not overlap share a texture (aliasing). the textures are kept across frames and
+//recompiling reuses them. the state every pass declares is set by the graph, which only changes what differs from
+//the previous pass and puts the default state back after the last one, so the code outside the graph can assume it.
+//
+//the graph is built and compiled once and executed every frame, so executing it does not allocate.
+class RenderGraph {
+public:
+    std::vector<RenderResource> resources; //resources declared by the passes
+    std::vector<RenderPass> passes; //passes in the order they were added
+    std::vector<int> order; //indices of the passes that are not culled, in the order they run
+    std::vector<PhysicalTarget>* physicalTargets; //textures the transient targets are placed in, may be shared by several graphs
+    bool isSharingTargets; //checks if the textures belong to another graph
+    GPUProfiler* profiler; //measures the gpu time of each pass, NULL to not measure
+    RenderPassState currentState; //state that was last set on the context
+
+    //constructor for the render graph class, the textures of another graph can be shared when only one of them runs at a time
+    RenderGraph(GPUProfiler* profiler, RenderGraph* shareTargetsWith = NULL) {
+        this->profiler = profiler;
+        isSharingTargets = shareTargetsWith != NULL;
+        physicalTargets = isSharingTargets ? shareTargetsWith->physicalTargets : new std::vector<PhysicalTarget>();
+    }
+
+    //destructor for the render graph class
+    ~RenderGraph() {
+        for (int i = 0; i < passes.size(); i++) {
+            glDeleteFramebuffers(1, &passes[i].framebuffer);
+        }
+
+        if (isSharingTargets) {
+            return;
+        }
+
+        for (int i = 0; i < physicalTargets->size(); i++) {
+            PhysicalTarget& target = (*physicalTargets)[i];
+            glDeleteTextures(1, &target.texture);
+            ResidencyManager::instance().release(target.allocation);
+        }
+        delete physicalTargets;
+    }
+
+    //declares the framebuffer bound when the graph executes, which the final passes draw into
+    int importFramebuffer(std::string name) {
+        RenderResource resource;
+        resource.name = name;
+        resource.isImported = true;
+        resource.desc.width = resource.desc.height = 0;
+        resource.desc.format = GL_NONE;
+        resource.firstUse = resource.lastUse = -1;
+        resource.physical = -1;
+        resources.push_back(resource);
+        return resources.size() - 1;
+    }
+
+    //declares a render target that only lives while the passes that use it run
+    int createTarget(std::string name, int width, int height, GLenum format) {
+        RenderResource resource;
+        resource.name = name;
+        resource.isImported = false;
+        resource.desc.width = width;
+        resource.desc.height = height;
+        resource.desc.format = format;
+        resource.firstUse = resource.lastUse = -1;
+        resource.physical = -1;
+        resources.push_back(resource);
+        return resources.size() - 1;
+    }
+
+    //adds a pass that draws with a state and returns its index
+    int addPass(std::string name, RenderPassState state, std::function<void()> execute) {
+        RenderPass pass;
+        pass.name = name;
+        pass.state = state;
+        pass.execute = execute;
+        pass.isCulled = false;
+        pass.framebuffer = 0;
+        pass.width = pass.height = 0;
+        passes.push_back(pass);
+        return passes.size() - 1;
+    }
+
+    //declares that a pass samples a resource
+    void read(int pass, int resource) {
+        passes[pass].reads.push_back(resource);
+    }
+
+    //declares that a pass draws into a resource
+    void write(int pass, int resource) {
+        passes[pass].writes.push_back(resource);
+    }
+
+    //returns the texture a transient target is placed in, valid once the graph is compiled
+    GLuint getTexture(int resource) {
+        int physical = resources[resource].physical;
+        return physical < 0 ? 0 : (*physicalTargets)[physical].texture;
+    }
+
+    //returns the number of bytes of a texel of a target format
+    static int bytesPerTexel(GLenum format) {
+        switch (format) {
+            case GL_RGBA16F:
+                return 8;
+            default:
+                return 4;
+        }
+    }
+
+    //derives the dependencies, culls the unused passes, orders the rest, and places the transient targets in textures,
+    //must be called on the thread that owns the context
+    void compile() {
+        PROFILE_ZONE("RenderGraph::compile");
+
+        //every pass depends on the last writer of what it reads, and on the last writer and the readers since then of
+        //what it writes so that it does not overwrite a value that is still needed
+        std::vector<std::vector<int>> dependencies(passes.size());
+        std::vector<int> lastWriter(resources.size(), -1);
+        std::vector<std::vector<int>> readersSinceWrite(resources.size());
+
+        for (int i = 0; i < passes.size(); i++) {
+            RenderPass& pass = passes[i];
+            for (int j = 0; j < pass.reads.size(); j++) {
+                int resource = pass.reads[j];
+                if (lastWriter[resource] >= 0) {
+                    dependencies[i].push_back(lastWriter[resource]);
+                }
+                readersSinceWrite[resource].push_back(i);
+            }
+
+            for (int j = 0; j < pass.writes.size(); j++) {
+                int resource = pass.writes[j];
+                if (lastWriter[resource] >= 0) {
+                    dependencies[i].push_back(lastWriter[resource]);
+                }
+                for (int k = 0; k < readersSinceWrite[resource].size(); k++) {
+                    if (readersSinceWrite[resource][k] != i) {
+                        dependencies[i].push_back(readersSinceWrite[resource][k]);
+                    }
+                }
+                readersSinceWrite[resource].clear();
+                lastWriter[resource] = i;
+            }
+        }
+
+        //keep the passes that write an imported resource and everything they depend on
+        std::vector<int> stack;
+        for (int i = 0; i < passes.size(); i++) {
+            passes[i].isCulled = true;
+            for (int j = 0; j < passes[i].writes.size(); j++) {
+                if (resources[passes[i].writes[j]].isImported) {
+                    passes[i].isCulled = false;
+                }
+            }
+            if (!passes[i].isCulled) {
+                stack.push_back(i);
+            }
+        }
+
+        while (!stack.empty()) {
+            int pass = stack.back();
+            stack.pop_back();
+            for (int j = 0; j < dependencies[pass].size(); j++) {
+                int dependency = dependencies[pass][j];
+                if (passes[dependency].isCulled) {
+                    passes[dependency].isCulled = false;
+                    stack.push_back(dependency);
+                }
+            }
+        }
+
+        //sort the passes that are kept, taking a ready pass with the state of the previous one before the others
+        std::vector<int> remaining(passes.size(), 0);
+        std::vector<std::vector<int>> dependents(passes.size());
+        int keptCount = 0;
+        for (int i = 0; i < passes.size(); i++) {
+            if (passes[i].isCulled) {
+                continue;
+            }
+            keptCount++;
+            for (int j = 0; j < dependencies[i].size(); j++) {
+                remaining[i]++;
+                dependents[dependencies[i][j]].push_back(i);
+            }
+        }
+
+        order.clear();
+        std::vector<bool> isScheduled(passes.size(), false);
+        RenderPassState previousState;
+        while (order.size() < keptCount) {
+            int next = -1;
+            for (int i = 0; i < passes.size(); i++) {
+                if (passes[i].isCulled || isScheduled[i] || remaining[i] > 0) {
+                    continue;
+                }
+                if (next < 0) {
+                    next = i;
+                }
+                if (passes[i].state == previousState) {
+                    next = i;
+                    break;
+                }
+            }
+
+            if (next < 0) {
+                LOG_ERROR("RENDER GRAPH", "[RENDER GRAPH] The passes depend on each other in a cycle, {} of {} were ordered", (int)order.size(), keptCount);
+                break;
+            }
+
+            isScheduled[next] = true;
+            order.push_back(next);
+            previousState = passes[next].state;
+            for (int j = 0; j < dependents[next].size(); j++) {
+                remaining[dependents[next][j]]--;
+            }
+        }
+
+        placeTargets();
+        createFramebuffers();
+
+        int targetCount = 0;
+        for (int i = 0; i < resources.size(); i++) {
+            targetCount += !resources[i].isImported && resources[i].physical >= 0;
+        }
+        LOG_INFO("RENDER GRAPH", "[RENDER GRAPH] {} passes, {} culled, {} transient targets in {} textures",
+            (int)passes.size(), (int)(passes.size() - order.size()), targetCount, (int)physicalTargets->size());
+    }
+
+    //finds the lifetime of every transient target and places it in a texture whose last use comes before its first use
+    void placeTargets() {
+        for (int i = 0; i < resources.size(); i++) {
+            resources[i].firstUse = resources[i].lastUse = -1;
+            resources[i].physical = -1;
+        }
+
+        for (int position = 0; position < order.size(); position++) {
+            RenderPass& pass = passes[order[position]];
+            for (int j = 0; j < pass.reads.size() + pass.writes.size(); j++) {
+                RenderResource& resource = resources[j < pass.reads.size() ? pass.reads[j] : pass.writes[j - pass.reads.size()]];
+                if (resource.firstUse < 0) {
+                    resource.firstUse = position;
+                }
+                resource.lastUse = position;
+            }
+        }
+
+        for (int i = 0; i < physicalTargets->size(); i++) {
+            (*physicalTargets)[i].lastUse = -1;
+        }
+
+        //the targets are placed in the order they start, so a texture is free once the target in it ended
+        for (int position = 0; position < order.size(); position++) {
+            for (int i = 0; i < resources.size(); i++) {
+                RenderResource& resource = resources[i];
+                if (resource.isImported || resource.firstUse != position) {
+                    continue;
+                }
+
+                for (int j = 0; j < physicalTargets->size() && resource.physical < 0; j++) {
+                    PhysicalTarget& target = (*physicalTargets)[j];
+                    if (target.desc == resource.desc && target.lastUse < resource.firstUse) {
+                        resource.physical = j;
+                    }
+                }
+
+                if (resource.physical < 0) {
+                    resource.physical = physicalTargets->size();
+                    physicalTargets->push_back(createTexture(resource.desc));
+                }
+                (*physicalTargets)[resource.physical].lastUse = resource.lastUse;
+            }
+        }
+    }
+
+    //creates a texture for transient targets of a size and format
+    static PhysicalTarget createTexture(RenderTargetDesc desc) {
+        PhysicalTarget target;
+        target.desc = desc;
+        target.lastUse = -1;
+
+        GLenum format = GL_RGBA, type = GL_UNSIGNED_BYTE;
+        if (desc.format == GL_RGBA16F) {
+            type = GL_HALF_FLOAT;
+        }
+        if (desc.format == GL_DEPTH_COMPONENT24) {
+            format = GL_DEPTH_COMPONENT;
+            type = GL_UNSIGNED_INT;
+        }
+
+        glGenTextures(1, &target.texture);
+        glBindTexture(GL_TEXTURE_2D, target.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, desc.format, desc.width, desc.height, 0, format, type, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        target.allocation = ResidencyManager::instance().track(ResidencyManager::RENDER_TARGET, "Render graph target",
+            ResidencyManager::textureBytes(desc.width, desc.height, bytesPerTexel(desc.format), false));
+        return target;
+    }
+
+    //creates the framebuffer of every pass that writes transient targets
+    void createFramebuffers() {
+        //a pass that an earlier compile kept may be culled now, it does not draw anymore so its framebuffer goes
+        for (int i = 0; i < passes.size(); i++) {
+            if (passes[i].isCulled && passes[i].framebuffer != 0) {
+                glDeleteFramebuffers(1, &passes[i].framebuffer);
+                passes[i].framebuffer = 0;
+            }
+        }
+
+        for (int position = 0; position < order.size(); position++) {
+            RenderPass& pass = passes[order[position]];
+            glDeleteFramebuffers(1, &pass.framebuffer);
+            pass.framebuffer = 0;
+
+            std::vector<GLenum> attachments;
+            for (int j = 0; j < pass.writes.size(); j++) {
+                RenderResource& resource = resources[pass.writes[j]];
+                if (resource.isImported) {
+                    continue;
+                }
+
+                if (pass.framebuffer == 0) {
+                    glGenFramebuffers(1, &pass.framebuffer);
+                    glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+                    pass.width = resource.desc.width;
+                    pass.height = resource.desc.height;
+                }
+
+                GLenum attachment = resource.desc.format == GL_DEPTH_COMPONENT24 ? GL_DEPTH_ATTACHMENT : GL_COLOR_ATTACHMENT0 + attachments.size();
+                glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, getTexture(pass.writes[j]), 0);
+                if (attachment != GL_DEPTH_ATTACHMENT) {
+                    attachments.push_back(attachment);
+                }
+            }
+
+            if (pass.framebuffer == 0) {
+                continue;
+            }
+
+            if (attachments.empty()) {
+                glDrawBuffer(GL_NONE);
+            }
+            else {
+                glDrawBuffers(attachments.size(), attachments.data());
+            }
+
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+                LOG_ERROR("RENDER GRAPH", "[RENDER GRAPH] The framebuffer of {} is incomplete", pass.name);
+            }
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        }
+    }
+
+    //sets the parts of a state that differ from the state last set
+    void applyState(RenderPassState& state) {
+        if (state.isBlending != currentState.isBlending) {
+            if (state.isBlending) {
+                glEnable(GL_BLEND);
+            }
+            else {
+                glDisable(GL_BLEND);
+            }
+        }
+
+        bool isBlendChanged = !currentState.isBlending || state.blendSource != currentState.blendSource ||
+            state.blendDestination != currentState.blendDestination || state.blendColor != currentState.blendColor;
+        if (state.isBlending && isBlendChanged) {
+            glBlendFunc(state.blendSource, state.blendDestination);
+            glBlendEquation(GL_FUNC_ADD);
+            glBlendColor(state.blendColor.r, state.blendColor.g, state.blendColor.b, state.blendColor.a);
+        }
+
+        if (state.isDepthWriting != currentState.isDepthWriting) {
+            glDepthMask(state.isDepthWriting ? GL_TRUE : GL_FALSE);
+        }
+
+        if (state.depthFunction != currentState.depthFunction) {
+            glDepthFunc(state.depthFunction);
+        }
+
+        currentState = state;
+    }
+
+    //runs the passes in their order, the passes that write the imported resource draw into the framebuffer that is bound
+    //
+    //a pass draws either into the imported framebuffer or into the transient targets it writes, which must share a size
+    void execute() {
+        PROFILE_ZONE("RenderGraph::execute");
+
+        GLint importedFramebuffer = 0;
+        GLint viewport[4];
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &importedFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        GLuint boundFramebuffer = importedFramebuffer;
+
+        for (int position = 0; position < order.size(); position++) {
+            RenderPass& pass = passes[order[position]];
+
+            GLuint framebuffer = pass.framebuffer != 0 ? pass.framebuffer : importedFramebuffer;
+            if (framebuffer != boundFramebuffer) {
+                glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+                boundFramebuffer = framebuffer;
+
+                //a transient target covers its framebuffer, the imported one keeps the viewport it came with
+                if (pass.framebuffer != 0) {
+                    glViewport(0, 0, pass.width, pass.height);
+                }
+                else {
+                    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+                }
+            }
+
+            applyState(pass.state);
+
+            if (profiler) {
+                GPUScope scope(profiler, pass.name);
+                pass.execute();
+            }
+            else {
+                pass.execute();
+            }
+        }
+
+        if (boundFramebuffer != importedFramebuffer) {
+            glBindFramebuffer(GL_FRAMEBUFFER, importedFramebuffer);
+            glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        }
+
+        RenderPassState defaultState;
+        applyState(defaultState);
+    }
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+//RenderGraphCheck class builds a small render graph and checks that it is culled, ordered, and aliased as declared
+//
+//the frame graph of the environment only draws into the screen, so this graph covers what it does not use: a chain
+//of transient targets where the first and the last target can share a texture, and a pass whose output nothing
+//reads. the passes copy a color along the chain into the screen, so the color only arrives if the passes ran in
+//order and the aliased texture was not overwritten while it was still needed.
+class RenderGraphCheck {
+public:
+    static const int SIZE = 16; //width and height of the targets
+
+    std::vector<std::string> executed; //names of the passes in the order they ran
+    int failures; //number of checks that failed
+
+    //constructor for the render graph check class
+    RenderGraphCheck() {
+        failures = 0;
+    }
+
+    //logs a check that failed
+    void expect(bool isPassing, std::string description) {
+        if (!isPassing) {
+            LOG_ERROR("RENDER GRAPH", "[RENDER GRAPH] Check failed: {}", description);
+            failures++;
+        }
+    }
+
+    //copies the whole of a target into another texture or renderbuffer
+    static void copy(GLuint source, GLuint destination, GLenum destinationTarget) {
+        glCopyImageSubData(source, GL_TEXTURE_2D, 0, 0, 0, 0, destination, destinationTarget, 0, 0, 0, 0, SIZE, SIZE, 1);
+    }
+
+    //runs the checks, must be called on the thread that owns the context, returns true if every check passed
+    bool run() {
+        //the screen the graph draws into
+        GLuint screenFBO, screenRBO;
+        glGenRenderbuffers(1, &screenRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, screenRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, SIZE, SIZE);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &screenFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, screenFBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, screenRBO);
+        GLfloat black[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        glClearBufferfv(GL_COLOR, 0, black);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        RenderGraph* graph = new RenderGraph(NULL);
+        int screen = graph->importFramebuffer("Screen");
+        int first = graph->createTarget("First", SIZE, SIZE, GL_RGBA8);
+        int second = graph->createTarget("Second", SIZE, SIZE, GL_RGBA8);
+        int third = graph->createTarget("Third", SIZE, SIZE, GL_RGBA8);
+        int unused = graph->createTarget("Unused", SIZE, SIZE, GL_RGBA8);
+
+        //first -> second -> third -> screen, and a pass that reads first but leads nowhere
+        int clearPass = graph->addPass("Clear", RenderPassState(), [this]() {
+            executed.push_back("Clear");
+            GLfloat color[4] = { 1.0f, 0.5f, 0.25f, 1.0f };
+            glClearBufferfv(GL_COLOR, 0, color);
+        });
+        graph->write(clearPass, first);
+
+        int unusedPass = graph->addPass("Unused", RenderPassState(), [this]() {
+            executed.push_back("Unused");
+        });
+        graph->read(unusedPass, first);
+        graph->write(unusedPass, unused);
+
+        int secondPass = graph->addPass("Second", RenderPassState(), [this, graph, first, second]() {
+            executed.push_back("Second");
+            copy(graph->getTexture(first), graph->getTexture(second), GL_TEXTURE_2D);
+        });
+        graph->read(secondPass, first);
+        graph->write(secondPass, second);
+
+        int thirdPass = graph->addPass("Third", RenderPassState(), [this, graph, second, third]() {
+            executed.push_back("Third");
+            copy(graph->getTexture(second), graph->getTexture(third), GL_TEXTURE_2D);
+        });
+        graph->read(thirdPass, second);
+        graph->write(thirdPass, third);
+
+        int presentPass = graph->addPass("Present", RenderPassState(), [this, graph, third, screenRBO]() {
+            executed.push_back("Present");
+            copy(graph->getTexture(third), screenRBO, GL_RENDERBUFFER);
+        });
+        graph->read(presentPass, third);
+        graph->write(presentPass, screen);
+
+        graph->compile();
+
+        expect(graph->passes[unusedPass].isCulled, "the pass whose output is never read is culled");
+        expect(!graph->passes[clearPass].isCulled && !graph->passes[presentPass].isCulled, "the passes that lead to the screen are kept");
+        int expectedOrder[4] = { clearPass, secondPass, thirdPass, presentPass };
+        expect(graph->order.size() == 4 && std::equal(graph->order.begin(), graph->order.end(), expectedOrder), "the kept passes follow their dependencies");
+        expect(graph->resources[third].physical == graph->resources[first].physical, "the third target reuses the texture of the first");
+        expect(graph->resources[second].physical != graph->resources[first].physical, "the second target does not share a texture with the targets it touches");
+        expect(graph->physicalTargets->size() == 2, "three transient targets fit in two textures");
+        expect(graph->getTexture(unused) == 0, "the target of the culled pass gets no texture");
+
+        //the graph runs with the screen bound, like the frame graph runs with the framebuffer of the frame bound
+        glBindFramebuffer(GL_FRAMEBUFFER, screenFBO);
+        glViewport(0, 0, SIZE, SIZE);
+        graph->execute();
+
+        const char* expectedExecution[4] = { "Clear", "Second", "Third", "Present" };
+        expect(executed.size() == 4 && std::equal(executed.begin(), executed.end(), expectedExecution), "the passes run in the compiled order");
+
+        GLint boundFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &boundFramebuffer);
+        expect(boundFramebuffer == screenFBO, "the screen is bound again after the graph ran");
+
+        //the color cleared into the first target arrives on the screen
+        unsigned char pixel[4] = { 0, 0, 0, 0 };
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, screenFBO);
+        glReadPixels(SIZE / 2, SIZE / 2, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        expect(pixel[0] == 255 && glm::abs(pixel[1] - 128) <= 1 && glm::abs(pixel[2] - 64) <= 1, "the color written by the first pass reaches the screen");
+
+        delete graph;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &screenFBO);
+        glDeleteRenderbuffers(1, &screenRBO);
+
+        if (failures == 0) {
+            LOG_INFO("RENDER GRAPH", "[RENDER GRAPH] Culling, ordering, and aliasing checks passed");
+        }
+        return failures == 0;
+    }
+};
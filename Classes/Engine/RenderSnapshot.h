@@ -0,0 +1,83 @@
+#pragma once
+
+//stores a model together with the transformation matrix it is drawn with
+struct DrawPacket {
+    Model3D* model; //model whose vertex array and textures are drawn
+    glm::mat4 transform; //transformation matrix computed when the snapshot was built
+    glm::mat3 normalMatrix; //inverse transpose of the transformation matrix
+    int vertexCount; //number of vertices drawn
+    TextureLayer albedoLayer; //layer of the shared texture array that holds the color map
+    float animationFrame; //frame of the clip the mesh is posed at, only read for the models that have a clip
+};
+
+//stores the state of the active camera that the view matrix was built from, so that the main thread can redo the
+//view with a newer cursor position right before the frame is drawn
+struct LatchState {
+    static const int NONE = 0; //the camera is not being dragged, the view is kept as is
+    static const int ORBIT = 1; //the third person camera is being rotated around the player
+    static const int PAN = 2; //the orthographic camera is being panned
+
+    int mode; //how the cursor moves the camera
+    glm::vec3 position, target, up; //position, target, and up vector the view matrix was built from
+    float yaw, pitch; //orbit of the third person camera
+    double cursorX, cursorY; //cursor position that the camera state already includes
+};
+
+//RenderSnapshot class stores everything the main thread needs to draw a frame
+//
+//a snapshot is written by the thread that simulates the frame and is only read once it is handed over, so the
+//main thread never looks at the models, cameras, or lights while the next frame is being simulated. the draw packets
+//are placed in a linear allocator of the snapshot that is reset each time a frame is built in it, so building a frame
+//does not allocate once the allocator has grown to the size of a frame.
+class RenderSnapshot {
+public:
+    static const int FRAME_MEMORY_SIZE = 64 * 1024; //starting size of the memory the packets of a frame are placed in
+
+    glm::mat4 viewMatrix; //view matrix of the active camera
+    glm::mat4 projectionMatrix; //projection matrix of the active camera
+    glm::vec3 cameraPosition; //position of the active camera
+    SpotLight spotLight; //copy of the spot light in front of the player
+    DirectionalLight directionalLight; //copy of the directional light
+    bool isFirstPerson; //checks if the frame is seen through the first person camera
+    bool isPlayerVisible; //checks if the player model is drawn
+    DrawPacket playerPacket; //draw packet of the player model
+    LinearAllocator frameMemory; //memory of the packets and the visibility results of the frame
+    ArenaVector<DrawPacket> modelPackets; //draw packets of the other models that passed the visibility test
+    ArenaVector<DrawPacket> animatedPackets; //draw packets of the models that passed the visibility test and are posed by a clip
+    ArenaVector<DrawPacket> impostorPackets; //draw packets of the models that passed the visibility test and are small enough on the screen to be drawn as impostors
+    ArenaVector<DrawPacket> placeholderPackets; //draw packets of the boxes that stand in for the models that are still loading
+    int culledCount; //number of models that were skipped by the visibility test
+    LatchState latch; //camera state used to redo the view with the latest cursor position
+    double inputTime; //time of the newest input that the frame shows, 0 if there was no input yet
+
+    //constructor for the render snapshot class
+    RenderSnapshot(SpotLight& spotLight, DirectionalLight& directionalLight) : spotLight(spotLight), directionalLight(directionalLight),
+        frameMemory(FRAME_MEMORY_SIZE), modelPackets(ArenaAllocator<DrawPacket>(&frameMemory)),
+        animatedPackets(ArenaAllocator<DrawPacket>(&frameMemory)), impostorPackets(ArenaAllocator<DrawPacket>(&frameMemory)),
+        placeholderPackets(ArenaAllocator<DrawPacket>(&frameMemory)) {
+        viewMatrix = glm::mat4(1.0f);
+        projectionMatrix = glm::mat4(1.0f);
+        cameraPosition = glm::vec3(0.0f);
+        isFirstPerson = false;
+        isPlayerVisible = false;
+        playerPacket.model = NULL;
+        playerPacket.transform = glm::mat4(1.0f);
+        playerPacket.normalMatrix = glm::mat3(1.0f);
+        playerPacket.vertexCount = 0;
+        playerPacket.albedoLayer.texture = 0;
+        playerPacket.albedoLayer.layer = 0;
+        playerPacket.animationFrame = 0.0f;
+        culledCount = 0;
+        latch.mode = LatchState::NONE;
+        inputTime = 0.0;
+    }
+
+    //drops the packets of the frame that was last built in the snapshot and frees their memory at once
+    void resetFrame() {
+        modelPackets = ArenaVector<DrawPacket>(ArenaAllocator<DrawPacket>(&frameMemory));
+        animatedPackets = ArenaVector<DrawPacket>(ArenaAllocator<DrawPacket>(&frameMemory));
+        impostorPackets = ArenaVector<DrawPacket>(ArenaAllocator<DrawPacket>(&frameMemory));
+        placeholderPackets = ArenaVector<DrawPacket>(ArenaAllocator<DrawPacket>(&frameMemory));
+        frameMemory.reset();
+    }
+};
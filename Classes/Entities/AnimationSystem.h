@@ -0,0 +1,58 @@
+#pragma once
+
+//AnimationSystem class plays the clips of the animated entities by picking the frame each one is drawn at
+//
+//the vertices are posed by the vertex shader, so the cpu only writes one frame number per entity. entities far from
+//the camera get a new frame less often: the update interval doubles with every FULL_RATE_DISTANCE of distance up to
+//MAX_UPDATE_INTERVAL builds, and the entities that share an interval are staggered by their id so that every build
+//updates about the same number. a distant model then moves at a lower frame rate, which is hard to see at its size.
+class AnimationSystem {
+public:
+    static const int ENTITIES_PER_JOB = 256; //number of entities handled by a single job
+    static const int FULL_RATE_DISTANCE = 40; //distance within which a clip gets a new frame on every build
+    static const int MAX_UPDATE_INTERVAL = 8; //largest number of builds between two frames of a clip
+
+    JobSystem* jobSystem; //splits the pass across the worker threads
+    float time; //seconds of simulation the clips are played at
+    int buildCount; //number of times the frames were picked, staggers the entities that are updated less often
+
+    //constructor for the animation system class
+    AnimationSystem(JobSystem* jobSystem) {
+        this->jobSystem = jobSystem;
+        time = 0.0f;
+        buildCount = 0;
+    }
+
+    //moves the clips forward by a simulation tick
+    void advance(float deltaTime) {
+        time += deltaTime;
+    }
+
+    //picks the frame of every animated entity that is due for an update, the world bounds must be up to date
+    void update(EntityStore& store, glm::vec3 cameraPosition) {
+        PROFILE_ZONE("AnimationSystem::update");
+
+        buildCount++;
+        int build = buildCount;
+        float time = this->time;
+
+        jobSystem->parallelFor(0, store.size(), ENTITIES_PER_JOB, [&store, cameraPosition, build, time](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                VertexAnimation* animation = store.renderHandles[i].animation;
+                if (!animation) {
+                    continue;
+                }
+
+                float distance = glm::distance(glm::vec3(store.worldBounds[i]), cameraPosition);
+                int interval = 1;
+                while (interval < MAX_UPDATE_INTERVAL && distance > FULL_RATE_DISTANCE * interval) {
+                    interval *= 2;
+                }
+
+                if ((build + store.entities[i]) % interval == 0) {
+                    store.animationFrames[i] = animation->frameAt(time + store.animationOffsets[i]);
+                }
+            }
+        });
+    }
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+//identifies an entity in the entity store
+typedef unsigned int Entity;
+
+//stores what the renderer needs to draw an entity
+struct RenderHandle {
+    Model3D* asset; //model that owns the vertex array and the textures, NULL while the model is loading
+    GLuint VAO; //vertex array of the mesh
+    int vertexCount; //number of vertices drawn
+    TextureLayer albedoLayer; //layer of the shared texture array that holds the color map
+    VertexAnimation* animation; //clip the mesh is posed with, NULL if the model is rigid
+    Impostor* impostor; //views the entity is drawn with once it is small on the screen, NULL if the mesh has none
+};
+
+//EntityStore class keeps the components of the entities in contiguous arrays (structure of arrays)
+//
+//the store is a sparse set: the sparse array maps an entity to its slot in the dense arrays and the dense arrays
+//are kept packed by moving the last entity into the slot of a removed one. systems loop over the dense arrays from
+//0 to size() and only touch the arrays they need, so a pass over the transforms never loads the render handles.
+class EntityStore {
+public:
+    static const int INVALID_INDEX = -1; //slot of an entity that is not alive
+
+    std::vector<int> sparse; //slot of every entity id in the dense arrays, INVALID_INDEX if the id is free
+    std::vector<Entity> freeIds; //ids of removed entities that can be reused
+
+    //dense arrays, the same slot refers to the same entity in every array
+    std::vector<Entity> entities; //id of the entity in each slot
+    std::vector<glm::vec3> positions; //position at the latest simulation tick
+    std::vector<glm::vec3> previousPositions; //position at the previous simulation tick
+    std::vector<glm::vec3> renderPositions; //position blended between the last two ticks
+    std::vector<glm::quat> orientations; //rotation at the latest simulation tick
+    std::vector<glm::quat> previousOrientations; //rotation at the previous simulation tick
+    std::vector<glm::quat> renderOrientations; //rotation blended between the last two ticks
+    std::vector<glm::vec3> scales; //scale of the model
+    std::vector<glm::mat4> transforms; //transformation matrix computed from the render state
+    std::vector<glm::mat4> normalMatrices; //inverse transpose of the transformation matrix, only the upper 3x3 is used
+    std::vector<glm::vec4> localBounds; //bounding sphere of the mesh before transformation as center (xyz) and radius (w)
+    std::vector<glm::vec4> worldBounds; //bounding sphere in world space as center (xyz) and radius (w)
+    std::vector<RenderHandle> renderHandles; //what the renderer draws for the entity
+    std::vector<float> animationOffsets; //seconds the clip of the entity is ahead of the others, so that animated models do not move in step
+    std::vector<float> animationFrames; //frame of the clip the entity is drawn at
+
+    //returns the number of living entities
+    int size() {
+        return entities.size();
+    }
+
+    //checks if an entity has not been removed
+    bool isAlive(Entity entity) {
+        return entity < sparse.size() && sparse[entity] != INVALID_INDEX;
+    }
+
+    //returns the slot of an entity in the dense arrays
+    int indexOf(Entity entity) {
+        return isAlive(entity) ? sparse[entity] : INVALID_INDEX;
+    }
+
+    //creates an entity that draws a model at the placement it was loaded with
+    Entity create(Model3D* asset) {
+        Entity entity = createPlaceholder(asset->position, asset->theta, asset->scale, glm::vec4(asset->boundsCenter, asset->boundsRadius));
+        setAsset(entity, asset);
+        return entity;
+    }
+
+    //creates an entity for a model that is still loading, it is drawn as a box around the given bounding sphere
+    Entity createPlaceholder(glm::vec3 position, glm::vec3 theta, glm::vec3 scale, glm::vec4 bounds) {
+        Entity entity;
+        if (!freeIds.empty()) {
+            entity = freeIds.back();
+            freeIds.pop_back();
+        }
+        else {
+            entity = sparse.size();
+            sparse.push_back(0);
+        }
+
+        sparse[entity] = entities.size();
+        entities.push_back(entity);
+
+        positions.push_back(position);
+        previousPositions.push_back(position);
+        renderPositions.push_back(position);
+        glm::quat orientation = TransformBatch::fromEuler(theta);
+        orientations.push_back(orientation);
+        previousOrientations.push_back(orientation);
+        renderOrientations.push_back(orientation);
+        scales.push_back(scale);
+        transforms.push_back(glm::mat4(1.0f));
+        normalMatrices.push_back(glm::mat4(1.0f));
+        localBounds.push_back(bounds);
+        worldBounds.push_back(glm::vec4(position, 0.0f));
+
+        RenderHandle handle;
+        handle.asset = NULL;
+        handle.VAO = 0;
+        handle.vertexCount = 0;
+        handle.albedoLayer.texture = 0;
+        handle.albedoLayer.layer = 0;
+        handle.animation = NULL;
+        handle.impostor = NULL;
+        renderHandles.push_back(handle);
+
+        //spread the offsets over the clip by the golden ratio so that neighbouring ids are far apart
+        float offset = entity * 0.618034f;
+        animationOffsets.push_back((offset - std::floor(offset)) * VertexAnimation::CLIP_SECONDS);
+        animationFrames.push_back(0.0f);
+
+        return entity;
+    }
+
+    //makes an entity draw a model whose buffers exist, replacing its placeholder
+    void setAsset(Entity entity, Model3D* asset) {
+        int index = indexOf(entity);
+        if (index == INVALID_INDEX) {
+            return;
+        }
+
+        localBounds[index] = glm::vec4(asset->boundsCenter, asset->boundsRadius);
+
+        RenderHandle& handle = renderHandles[index];
+        handle.asset = asset;
+        handle.VAO = asset->VAO;
+        handle.vertexCount = asset->getVertexCount();
+        handle.albedoLayer = asset->albedoLayer;
+        handle.animation = asset->animation;
+        handle.impostor = asset->impostor;
+    }
+
+    //draws an entity as its placeholder again while keeping its model, used when the mesh of the model is evicted
+    void clearMesh(Entity entity) {
+        int index = indexOf(entity);
+        if (index == INVALID_INDEX) {
+            return;
+        }
+
+        renderHandles[index].VAO = 0;
+        renderHandles[index].vertexCount = 0;
+    }
+
+    //removes an entity by moving the last entity into its slot
+    void destroy(Entity entity) {
+        int index = indexOf(entity);
+        if (index == INVALID_INDEX) {
+            return;
+        }
+
+        int last = entities.size() - 1;
+        moveSlot(last, index);
+
+        entities.pop_back();
+        positions.pop_back();
+        previousPositions.pop_back();
+        renderPositions.pop_back();
+        orientations.pop_back();
+        previousOrientations.pop_back();
+        renderOrientations.pop_back();
+        scales.pop_back();
+        transforms.pop_back();
+        normalMatrices.pop_back();
+        localBounds.pop_back();
+        worldBounds.pop_back();
+        renderHandles.pop_back();
+        animationOffsets.pop_back();
+        animationFrames.pop_back();
+
+        sparse[entity] = INVALID_INDEX;
+        freeIds.push_back(entity);
+    }
+
+    //copies the components in one slot to another slot and points the moved entity to its new slot
+    void moveSlot(int from, int to) {
+        if (from == to) {
+            return;
+        }
+
+        entities[to] = entities[from];
+        positions[to] = positions[from];
+        previousPositions[to] = previousPositions[from];
+        renderPositions[to] = renderPositions[from];
+        orientations[to] = orientations[from];
+        previousOrientations[to] = previousOrientations[from];
+        renderOrientations[to] = renderOrientations[from];
+        scales[to] = scales[from];
+        transforms[to] = transforms[from];
+        normalMatrices[to] = normalMatrices[from];
+        localBounds[to] = localBounds[from];
+        worldBounds[to] = worldBounds[from];
+        renderHandles[to] = renderHandles[from];
+        animationOffsets[to] = animationOffsets[from];
+        animationFrames[to] = animationFrames[from];
+
+        sparse[entities[to]] = to;
+    }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+//TransformSystem class updates the transform components of every entity in the store
+class TransformSystem {
+public:
+    static const int ENTITIES_PER_JOB = 256; //number of entities handled by a single job
+
+    JobSystem* jobSystem; //splits the passes across the worker threads
+
+    //constructor for the transform system class
+    TransformSystem(JobSystem* jobSystem) {
+        this->jobSystem = jobSystem;
+    }
+
+    //saves the state of every entity before a simulation tick changes it
+    void storePreviousState(EntityStore& store) {
+        store.previousPositions = store.positions;
+        store.previousOrientations = store.orientations;
+    }
+
+    //blends the state of the last two simulation ticks to get the state that is drawn
+    void interpolate(EntityStore& store, float alpha) {
+        PROFILE_ZONE("TransformSystem::interpolate");
+
+        jobSystem->parallelFor(0, store.size(), ENTITIES_PER_JOB, [&store, alpha](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                store.renderPositions[i] = glm::mix(store.previousPositions[i], store.positions[i], alpha);
+                store.renderOrientations[i] = glm::slerp(store.previousOrientations[i], store.orientations[i], alpha);
+            }
+        });
+    }
+
+    //computes the transformation and normal matrices and the world space bounding sphere of every entity from its render state
+    void update(EntityStore& store) {
+        PROFILE_ZONE("TransformSystem::update");
+
+        jobSystem->parallelFor(0, store.size(), ENTITIES_PER_JOB, [&store](int begin, int end) {
+            //compose the matrices of the whole range with the simd kernel
+            TransformBatch::compose(&store.renderPositions[begin], &store.renderOrientations[begin], &store.scales[begin],
+                &store.transforms[begin], &store.normalMatrices[begin], end - begin);
+
+            for (int i = begin; i < end; i++) {
+                glm::mat4& transform = store.transforms[i];
+                glm::vec3 scale = store.scales[i];
+
+                //move the center of the sphere and grow its radius by the largest scale
+                glm::vec4 bounds = store.localBounds[i];
+                float maxScale = glm::max(glm::abs(scale.x), glm::max(glm::abs(scale.y), glm::abs(scale.z)));
+                store.worldBounds[i] = glm::vec4(glm::vec3(transform * glm::vec4(glm::vec3(bounds), 1.0f)), bounds.w * maxScale);
+            }
+        });
+    }
+};
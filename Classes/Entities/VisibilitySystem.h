@@ -0,0 +1,90 @@
+#pragma once
+
+//VisibilitySystem class collects the draw packets of the entities whose bounds are inside the view
+class VisibilitySystem {
+public:
+    static const int ENTITIES_PER_JOB = 256; //number of entities tested by a single job
+    static constexpr float IMPOSTOR_SCREEN_SIZE = 0.25f; //height on the screen, as a fraction of the screen, below which a model with an impostor is drawn as one
+
+    JobSystem* jobSystem; //splits the tests across the worker threads
+
+    //constructor for the visibility system class
+    VisibilitySystem(JobSystem* jobSystem) {
+        this->jobSystem = jobSystem;
+    }
+
+    //appends a draw packet for every visible entity to the snapshot in slot order and returns the number of entities
+    //that were culled
+    //
+    //the results of the tests and the packets are placed in the memory of the frame, which is reset before the next
+    //frame is built in it. the packets are reserved for every entity so that they never grow.
+    //
+    //entities whose model is still loading or whose mesh was evicted go to the placeholder packets, with a transform
+    //that maps the unit cube of the placeholder box onto their bounding sphere. entities with a clip go to the animated
+    //packets, which are drawn with the variant of the shader that poses the vertices. entities with an impostor whose
+    //bounding sphere is shorter than IMPOSTOR_SCREEN_SIZE on the screen go to the impostor packets, the view and
+    //projection of the snapshot must be set to measure them.
+    int collect(EntityStore& store, Frustum& frustum, RenderSnapshot& snapshot) {
+        PROFILE_ZONE("VisibilitySystem::collect");
+
+        unsigned char* visibility = snapshot.frameMemory.allocateArray<unsigned char>(store.size());
+        snapshot.modelPackets.reserve(store.size());
+        snapshot.animatedPackets.reserve(store.size());
+        snapshot.impostorPackets.reserve(store.size());
+        snapshot.placeholderPackets.reserve(store.size());
+
+        //only the world bounds are read while testing
+        jobSystem->parallelFor(0, store.size(), ENTITIES_PER_JOB, [visibility, &store, &frustum](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                glm::vec4 bounds = store.worldBounds[i];
+                visibility[i] = frustum.isSphereVisible(glm::vec3(bounds), bounds.w);
+            }
+        });
+
+        //the transforms and handles are only read for the entities that passed
+        glm::mat4 view = snapshot.viewMatrix;
+        glm::mat4 projection = snapshot.projectionMatrix;
+        int culledCount = 0;
+        for (int i = 0; i < store.size(); i++) {
+            if (!visibility[i]) {
+                culledCount++;
+                continue;
+            }
+
+            DrawPacket packet;
+            packet.model = store.renderHandles[i].asset;
+            packet.transform = store.transforms[i];
+            packet.normalMatrix = glm::mat3(store.normalMatrices[i]);
+            packet.vertexCount = store.renderHandles[i].vertexCount;
+            packet.albedoLayer = store.renderHandles[i].albedoLayer;
+            packet.animationFrame = store.animationFrames[i];
+
+            if (!packet.model || store.renderHandles[i].VAO == 0) {
+                glm::vec4 bounds = store.localBounds[i];
+                packet.transform = glm::scale(glm::translate(packet.transform, glm::vec3(bounds)), glm::vec3(bounds.w));
+                snapshot.placeholderPackets.push_back(packet);
+                continue;
+            }
+
+            if (store.renderHandles[i].impostor) {
+                //the clip space w of the center is the depth of a perspective view and 1 for an orthographic one
+                glm::vec4 bounds = store.worldBounds[i];
+                float viewZ = (view * glm::vec4(glm::vec3(bounds), 1.0f)).z;
+                float w = glm::max(projection[2][3] * viewZ + projection[3][3], 0.0001f);
+                if (bounds.w * projection[1][1] / w < IMPOSTOR_SCREEN_SIZE) {
+                    snapshot.impostorPackets.push_back(packet);
+                    continue;
+                }
+            }
+
+            if (store.renderHandles[i].animation) {
+                snapshot.animatedPackets.push_back(packet);
+                continue;
+            }
+
+            snapshot.modelPackets.push_back(packet);
+        }
+
+        return culledCount;
+    }
+};
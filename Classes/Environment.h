@@ -3,90 +3,162 @@
 class Environment {
 
 public:
+    static const int TEXTURE_LAYER_SIZE = 1024; //size that the color maps of the models are resampled to
+    static const int TEXTURE_LAYERS_PER_ARRAY = 4; //number of color maps that share a texture array, small so that an array empties once its models are demoted
+    static const int UPLOAD_RING_SIZE = 64 * 1024 * 1024; //bytes of staging memory the textures are written to by the loading threads
+    static const int UPLOAD_BYTES_PER_FRAME = 8 * 1024 * 1024; //bytes of streamed models that are uploaded in one frame
+    static const int WORLD_LOAD_RADIUS = 150; //distance from the player within which the cells of the world are loaded
+    static const int WORLD_UNLOAD_RADIUS = 200; //distance from the player beyond which the cells of the world are unloaded
     Player* playerModel;
-    std::vector<Model*> otherModels;
+    ModelStreamer* modelStreamer; //reads the models of the world after the first frame
+    WorldPartition* world; //cells of the world that are loaded around the player
+    PlaceholderBox* placeholderBox; //drawn in place of the models that are still loading
+    EntityStore entities; //placement, bounds, and render handles of the other models
+    TransformSystem* transformSystem;
+    VisibilitySystem* visibilitySystem;
+    AnimationSystem* animationSystem; //picks the frame of the clip every animated model is drawn at
     Skybox* skybox;
     SpotLight* spotLight;
     DirectionalLight* directionalLight;
-    Shader* playerShader;
-    Shader* modelShader;
+    ShaderVariants* playerShaders; //variants of the player shader
+    ShaderVariants* modelShaders; //variants of the model shader
+    Shader* playerShader; //normal mapped variant of the player shader
+    Shader* modelShader; //textured variant of the model shader
+    Shader* untexturedModelShader; //variant of the model shader that draws a flat shade, used by the first person view
+    Shader* animatedModelShader; //textured variant of the model shader that poses the vertices with a clip
+    Shader* untexturedAnimatedModelShader; //flat shaded variant of the model shader that poses the vertices with a clip
+    ShaderVariants* impostorShaders; //variants of the shader that draws the impostors
+    Shader* impostorShader; //textured variant of the impostor shader
+    Shader* untexturedImpostorShader; //flat shaded variant of the impostor shader, used by the first person view
+    ImpostorBaker* impostorBaker; //renders the views of the large models as they arrive
+    GLuint impostorVAO; //empty vertex array bound while the impostors are drawn, their quads have no vertex buffer
+    RenderGraph* renderGraph; //passes that draw the third person and orthographic views
+    RenderGraph* firstPersonGraph; //passes that draw the first person view, shares the targets of renderGraph
+    RenderSnapshot* drawnSnapshot; //snapshot the passes of the render graphs draw, NULL outside of submitSnapshot
     Shader* skyboxShader;
+    TextureArrayManager* textureArrays; //layers that hold the color maps of the models
+    UploadRing* uploadRing; //mapped pixel buffer the textures are staged in before they are uploaded
     PerspectiveCamera* thirdPerspectiveCamera;
     PerspectiveCamera* firstPerspectiveCamera;
     OrthoCamera* orthoCamera;
     MyCamera* activeCamera;
+    SceneGraph sceneGraph; //hierarchy of the objects that move with another object
+    SceneNode playerNode; //follows the position of the player
+    SceneNode headingNode; //follows the rotation of the player, child of the player node
+    SceneNode thirdPersonNode; //orbit of the third person camera around the player, child of the player node
+    SceneNode firstPersonNode; //first person camera inside the player, child of the heading node
+    SceneNode spotLightNode; //spot light in front of the player, child of the heading node
+    JobSystem* jobSystem;
+    ProgramCache* programCache; //cache the shaders are loaded from, NULL if programs are not cached
+    GPUProfiler* gpuProfiler;
+    RenderStats renderStats;
+    RenderSnapshot* snapshot; //snapshot used when a frame is built and drawn on the same thread
     int lastPerspective = 3;
     bool isMouseClicked = false;
+    double inputTime = 0.0; //time of the newest input event that was applied
+    int frameNumber = 0; //number of snapshots that were drawn, tells the world which models were drawn recently
 
     //constructor for the environment class which initializes the objects necessary to render the program such as the models, lights, shaders, and cameras
-    Environment() {
+    Environment(JobSystem* jobSystem, ProgramCache* programCache) {
         // set the color of command line text to be green
+#ifdef _WIN32
         system("Color 0A");
-        std::cout << "############ SETTING UP NO MAN'S SUBMARINE #############\n\n";
+#endif
+        LOG_INFO("SETUP", "############ SETTING UP NO MAN'S SUBMARINE #############\n");
 
-        //load the shader for the players
-        playerShader = new Shader("Shaders/player.vert", "Shaders/player.frag");
+        this->jobSystem = jobSystem;
+        this->programCache = programCache;
+        transformSystem = new TransformSystem(jobSystem);
+        visibilitySystem = new VisibilitySystem(jobSystem);
+        animationSystem = new AnimationSystem(jobSystem);
 
-        //load the shader for the models
-        modelShader = new Shader("Shaders/model.vert", "Shaders/model.frag");
+        //create the profiler that measures the gpu time of each render pass
+        gpuProfiler = new GPUProfiler();
 
-        //load the shader for the skybox
-        skyboxShader = new Shader("Shaders/skybox.vert", "Shaders/skybox.frag");
+        //the jobs and the loader copy the decoded textures into the upload ring, so it is mapped before they start
+        uploadRing = new UploadRing(UPLOAD_RING_SIZE);
 
-        std::cout << "[ SHADERS LOADED ]... \n";
+        //read what the first frame needs on the job system while the shaders are compiled on this thread, the other
+        //models are streamed in behind placeholders once the first frame can be drawn
+        JobCounter loadCounter;
 
         //load the main model and its textures
         /* [Source] Submarine (Player): https://www.cgtrader.com/free-3d-models/watercraft/other/yellow-submarine-a96577f5-f213-4491-8893-bfc08e3f37ae */
-        playerModel = new Player("3D/submarine.obj", glm::vec3(0, -10, 0), glm::vec3(0.00375f, 0.00375f, 0.00375f), glm::vec3(0.0f, 180.0f, 0.0f));
-        playerModel->loadTexture("3D/submarine_texture.png", *playerShader, "tex0");
-        playerModel->loadTexture("3D/submarine_normal.png", *playerShader, "norm_tex");
-
-        std::cout << "[ PLAYER LOADED ]... \n";
-
-        Model* model;
-        //load the megalodon model and its textures
-        /* [Source] Megalodon: https://free3d.com/3d-model/megalodon-battlefield-4-67390.html */
-        model = new Model("3D/megalodon.obj", glm::vec3(40.0f, -30.0f, -75.0f), glm::vec3(0.2f, 0.2f, 0.2f), glm::vec3(-25.0f, 225.0f, -25.0f));
-        model->loadTexture("3D/megalodon_texture.png", *modelShader, "tex0");
-        otherModels.push_back(model);
-
-        //load the turtle model and its textures
-        /* [Source] Turtle: https://3dsky.org/3dmodels/show/cherepakha_3 */
-        model = new Model("3D/turtle.obj", glm::vec3(0.0f, -30.0f, -100.0f), glm::vec3(0.03f, 0.03f, 0.03f), glm::vec3(-25.0f, 225.0f, 0.0f));
-        model->loadTexture("3D/turtle_texture.png", *modelShader, "tex0");
-        otherModels.push_back(model);
-
-        //load the submarine enemy model and its textures
-        /* [Source] Submarine Enemy: https://www.cgtrader.com/free-3d-models/watercraft/military-watercraft/low-polygon-indonesian-submarine */
-        model = new Model("3D/enemy_submarine.obj", glm::vec3(40.0f, -80.0f, -20.0f), glm::vec3(0.5f, 0.5f, 0.5f), glm::vec3(45.0f, 45.0f, 0.0f));
-        model->loadTexture("3D/enemy_submarine_texture.png", *modelShader, "tex0");
-        otherModels.push_back(model);
-
-        //load the seahore model and its textures
-        /* [Source] Seahorse: https://sketchfab.com/3d-models/seahorse-952f35a14f2e4fc0937325ecc09f8175 */
-        model = new Model("3D/seahorse.obj", glm::vec3(-45.0f, -20.0f, -75.0f), glm::vec3(0.03f, 0.03f, 0.03f), glm::vec3(0.0f, 25.0f, 0.0f));
-        model->loadTexture("3D/seahorse_texture.png", *modelShader, "tex0");
-        otherModels.push_back(model);
-
-        //load the starfish model and its textures
-        /* [Source] Starfish: https://sketchfab.com/3d-models/low-poly-starfish-4a763a1c211044089b1315f9f025b027 */
-        model = new Model("3D/starfish.obj", glm::vec3(0.0f, -5.0f, -50.0f), glm::vec3(0.2f, 0.2f, 0.2f), glm::vec3(0.0f, 25.0f, 25.0f));
-        model->loadTexture("3D/starfish_texture.png", *modelShader, "tex0");
-        otherModels.push_back(model);
-
-        //load the koi model and its textures
-        /* [Source] Koi: https://sketchfab.com/3d-models/koi-fish-f7e2e4858f2f438aa2832566220199f4 */
-        model = new Model("3D/koi.obj", glm::vec3(-65.0f, 0.0f, -50.0f), glm::vec3(0.1f, 0.1f, 0.1f), glm::vec3(0.0f, 0.0f, 0.0f));
-        model->loadTexture("3D/koi_texture.png", *modelShader, "tex0");
-        otherModels.push_back(model);
-
-        std::cout << "[ MODELS LOADED ]... \n";
-
-        //load the underwater skybox
+        jobSystem->run([this]() {
+            playerModel = new Player("3D/submarine.obj", glm::vec3(0, -10, 0), glm::vec3(0.00375f, 0.00375f, 0.00375f), glm::vec3(0.0f, 180.0f, 0.0f));
+            playerModel->decodeTexture("3D/submarine_texture.png", "tex0", uploadRing);
+            playerModel->decodeTexture("3D/submarine_normal.png", "norm_tex", uploadRing);
+        }, &loadCounter);
+
+        //load the underwater skybox, every face is decoded by its own job
         /* [Source] Underwater Skybox: https://jkhub.org/files/file/3216-underwater-skybox/ */
         skybox = new Skybox("Skybox/uw_rt.jpg", "Skybox/uw_lf.jpg", "Skybox/uw_up.jpg", "Skybox/uw_dn.jpg", "Skybox/uw_ft.jpg", "Skybox/uw_bk.jpg");
+        for (int i = 0; i < skybox->faces.size(); i++) {
+            jobSystem->run([this, i]() { skybox->decodeFace(i, uploadRing); }, &loadCounter);
+        }
+
+        //start the shaders that are not in the cache, a driver with parallel compilation links them in the background
+        //while this thread helps with the files
+        Shader::startCompilerThreads();
+
+        //load the shader for the players
+        playerShaders = new ShaderVariants("Shaders/player.vert", "Shaders/player.frag", programCache);
+        playerShader = playerShaders->get(ShaderDefines().enable("USE_NORMAL_MAP"));
+
+        //load the shader for the models, with and without the color maps, and for the models that are animated
+        modelShaders = new ShaderVariants("Shaders/model.vert", "Shaders/model.frag", programCache);
+        modelShader = modelShaders->get(ShaderDefines().enable("USE_TEXTURE"));
+        untexturedModelShader = modelShaders->get(ShaderDefines());
+        animatedModelShader = modelShaders->get(ShaderDefines().enable("USE_TEXTURE").enable("USE_VERTEX_ANIMATION"));
+        untexturedAnimatedModelShader = modelShaders->get(ShaderDefines().enable("USE_VERTEX_ANIMATION"));
+
+        //load the shaders that bake and draw the impostors of the large models
+        impostorShaders = new ShaderVariants("Shaders/impostor.vert", "Shaders/impostor.frag", programCache);
+        impostorShader = impostorShaders->get(ShaderDefines().enable("USE_TEXTURE"));
+        untexturedImpostorShader = impostorShaders->get(ShaderDefines());
+        impostorBaker = new ImpostorBaker(programCache);
+
+        //load the shader for the skybox
+        skyboxShader = new Shader("Shaders/skybox.vert", "Shaders/skybox.frag", programCache);
+
+        //help with the remaining files, then create the buffers and textures on this thread since it owns the context
+        jobSystem->wait(&loadCounter);
+
+        //check the link results, which only waits for the driver if a program is still compiling
+        playerShaders->finish();
+        modelShaders->finish();
+        impostorShaders->finish();
+        impostorBaker->shader->finish();
+        skyboxShader->finish();
+
+        if (programCache) {
+            LOG_INFO("SETUP", "[ SHADERS LOADED ]... ({} cached, {} compiled)", programCache->hitCount, programCache->missCount);
+        }
+        else {
+            LOG_INFO("SETUP", "[ SHADERS LOADED ]... ");
+        }
+
+        playerModel->upload(*playerShader, uploadRing);
+
+        LOG_INFO("SETUP", "[ PLAYER LOADED ]... ");
+
+        skybox->upload(uploadRing);
+
+        LOG_INFO("SETUP", "[ SKYBOX LOADED ]... ");
+
+        //the color maps of the models are placed in shared texture arrays as they arrive so that the draws do not rebind textures
+        textureArrays = new TextureArrayManager(TEXTURE_LAYER_SIZE, TEXTURE_LAYERS_PER_ARRAY);
+        placeholderBox = new PlaceholderBox();
+        glGenVertexArrays(1, &impostorVAO);
+
+        //the other models are placed in the cells of the world, the cells around the player get their placeholders
+        //and are read on the loader thread once the world is updated
+        modelStreamer = new ModelStreamer(textureArrays, uploadRing);
+        world = new WorldPartition((float)WORLD_LOAD_RADIUS, (float)WORLD_UNLOAD_RADIUS, &entities, modelStreamer, textureArrays, uploadRing, impostorBaker);
+        world->load("World/ocean.world");
+        world->update(playerModel->position);
 
-        std::cout << "[ SKYBOX LOADED ]... \n";
+        LOG_INFO("SETUP", "[ MODELS STREAMING ]... ");
 
         //create a spotlight in front of the submarine
         spotLight = new SpotLight(0.05f, 1.0f, 16.0f, glm::vec3(1, 1, 1), 0.5f, playerModel->position + playerModel->direction * 1.0f, glm::vec3(0, 0, -1), 25.0f, 35.0f);
@@ -94,7 +166,7 @@ public:
         //create a directional light coming from the top
         directionalLight = new DirectionalLight(0.1f, 0.5f, 16.0f, glm::vec3(1, 1, 1), 1.0f, glm::vec3(0, -1, 0));
 
-        std::cout << "[ LIGHTING LOADED ]... \n";
+        LOG_INFO("SETUP", "[ LIGHTING LOADED ]... ");
 
         //create a third person perspective camera
         thirdPerspectiveCamera = new PerspectiveCamera(playerModel->position - 5.0f * playerModel->direction, playerModel->position, glm::vec3(0, 1.0f, 0), 0.1f, 40.0f);
@@ -105,107 +177,513 @@ public:
         //create an orthographic camera looking down from the top
         orthoCamera = new OrthoCamera(glm::vec3(0.0f, 10.0f, 0.1f), glm::vec3(0, 0, 0), glm::vec3(0, 1.0f, 0), 0.0f, 200.0f);
 
-        std::cout << "[ CAMERAS LOADED ]... \n\n";        
+        LOG_INFO("SETUP", "[ CAMERAS LOADED ]... \n");        
+
+        //attach the cameras and the spot light to the player so that they move with it
+        playerNode = sceneGraph.create(SceneGraph::NO_PARENT, glm::translate(glm::mat4(1.0f), playerModel->position));
+        headingNode = sceneGraph.create(playerNode, playerModel->getRenderHeading());
+        thirdPersonNode = sceneGraph.create(playerNode, thirdPerspectiveCamera->getOrbitTransform());
+        firstPersonNode = sceneGraph.create(headingNode, glm::mat4(1.0f));
+        spotLightNode = sceneGraph.create(headingNode, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+        sceneGraph.attach(thirdPersonNode, thirdPerspectiveCamera);
+        sceneGraph.attach(firstPersonNode, firstPerspectiveCamera);
+        sceneGraph.attach(spotLightNode, spotLight);
+        sceneGraph.update();
 
         //set the third person perspective camera as the active camera
         activeCamera = thirdPerspectiveCamera;
 
+        //create the snapshot that is drawn when the frames are not pipelined
+        snapshot = createSnapshot();
+
+        //order the passes of both views once, every frame runs one of them
+        drawnSnapshot = NULL;
+        renderGraph = new RenderGraph(gpuProfiler);
+        firstPersonGraph = new RenderGraph(gpuProfiler, renderGraph);
+        buildRenderGraph(renderGraph, false);
+        buildRenderGraph(firstPersonGraph, true);
+
         // print the initial info of the submarine        
-        std::cout << "##################### SETUP SUCCESS ######################\n\n";
-        std::cout << "Submarine system initialization... COMPLETE\n";
-        std::cout << "Preparing for underwater exploration...\n\n";
-        std::cout << "[SUBMARINE STATUS]\n";
-        std::cout << "Current ocean depth: " << playerModel->position.y;
+        LOG_INFO("SETUP", "##################### SETUP SUCCESS ######################\n");
+        LOG_INFO("SETUP", "Submarine system initialization... COMPLETE");
+        LOG_INFO("SETUP", "Preparing for underwater exploration...\n");
+        LOG_INFO("SETUP", "[SUBMARINE STATUS]");
+        LOG_STATUS("PLAYER", "Current ocean depth: {.2} ", playerModel->position.y);
     }
 
     //destructor for the environment class
     ~Environment() {
+        //stop the loader before the models it hands over are removed
+        delete modelStreamer;
+
+        //show what was still resident at the end of the session
+        ResidencyManager::instance().report();
+
         //deallocates the objects from the memory
         delete playerModel;
-        for (int i = 0; i < otherModels.size(); i++) {
-            delete otherModels[i];
-        }
+        delete world;
+        delete placeholderBox;
+        delete transformSystem;
+        delete visibilitySystem;
+        delete animationSystem;
         delete skybox;
         delete spotLight;
         delete directionalLight;
-        delete playerShader;
-        delete modelShader;
+        delete playerShaders;
+        delete modelShaders;
+        delete impostorShaders;
+        delete impostorBaker;
+        glDeleteVertexArrays(1, &impostorVAO);
+        skyboxShader->destroy();
         delete skyboxShader;
+        delete textureArrays;
+        delete uploadRing;
         delete thirdPerspectiveCamera;
         delete firstPerspectiveCamera;
         delete orthoCamera;
+        delete snapshot;
+        delete firstPersonGraph;
+        delete renderGraph;
+
+        //save the gpu timings gathered during the session before the profiler is removed
+        gpuProfiler->exportResults("gpu_profile");
+        delete gpuProfiler;
     }
 
-    //updates the uniform values of the shader files and draws the objects on the screen
-    void updateScreen() {
-        //update the position and target of the camera based on the player position
-        firstPerspectiveCamera->updateFields(playerModel->position, playerModel->direction);
-        thirdPerspectiveCamera->updateFields(playerModel->position);
+    //loads and unloads the cells of the world around the player and swaps in the models that were read, returns true if
+    //a model arrived
+    //
+    //at most UPLOAD_BYTES_PER_FRAME of models are uploaded per call so that the upload cost is spread over the frames.
+    //this must be called on the thread that owns the context while no snapshot is being built, since it changes the
+    //render handles.
+    bool streamModels() {
+        PROFILE_ZONE("Environment::streamModels");
+
+        //free the staging blocks that the gpu finished reading so the loader can reuse them
+        uploadRing->retire();
+
+        world->update(playerModel->position);
+        world->updateResidency(frameNumber, UPLOAD_BYTES_PER_FRAME);
+        return world->receive(UPLOAD_BYTES_PER_FRAME, frameNumber);
+    }
 
-        //update the spot light based on the player position
-        spotLight->updateFields(playerModel->position + playerModel->direction * 1.0f, playerModel->direction);
+    //checks if every model of the cells around the player has replaced its placeholder
+    bool isFullyLoaded() {
+        return world->isSettled();
+    }
 
-        //update the player and model shader
-        updateShader(*playerShader);
-        updateShader(*modelShader);
+    //streams in every remaining model, used by runs that need the whole scene from the first frame like the benchmark
+    void waitForModels() {
+        PROFILE_ZONE("Environment::waitForModels");
 
-        //update the skybox based on the camera perspective
-        skybox->setViewMatrix(*skyboxShader, activeCamera->viewMatrix);
-        skybox->setProjectionMatrix(*skyboxShader, activeCamera->projectionMatrix);
-        skybox->setTransformationMatrix(*skyboxShader);
+        while (!isFullyLoaded()) {
+            if (!streamModels()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    //switches to the orthographic camera placed on top of the player
+    void useOrthoCamera() {
+        // set the position and target of ortho be on top of the player
+        orthoCamera->position.x = playerModel->position.x;
+        orthoCamera->target.x = playerModel->position.x;
+        orthoCamera->position.z = playerModel->position.z + 0.1f; // 0.1f add to avoid looking straight down exactly
+        orthoCamera->target.z = playerModel->position.z;
+
+        // do not blend from wherever the camera was the last time it was used
+        orthoCamera->snap();
+
+        // set the camera to switch to ortho
+        activeCamera = orthoCamera;
+    }
+
+    //applies the input events that arrived since the last simulation, returns the number of events applied
+    int processInput(InputQueue& queue) {
+        PROFILE_ZONE("Environment::processInput");
+
+        int eventCount = 0;
+        InputEvent event;
+        while (queue.pop(event)) {
+            processEvent(event);
+            inputTime = event.time;
+            eventCount++;
+        }
+
+        return eventCount;
+    }
+
+    //changes the lights and cameras based on a key, cursor, or mouse button event
+    void processEvent(InputEvent& event) {
+        if (event.type == InputEvent::KEY && event.action == GLFW_PRESS) {
+            // cycle the light intensity
+            if (event.code == GLFW_KEY_F) {
+                spotLight->processKeyboard(event.code);
+            }
+
+            // change the camera view
+            if (event.code == GLFW_KEY_1) {
+                if (activeCamera == firstPerspectiveCamera) {
+                    activeCamera = thirdPerspectiveCamera;
+                    lastPerspective = 3;
+                }
+                else
+                if (activeCamera == thirdPerspectiveCamera) {
+                    activeCamera = firstPerspectiveCamera;
+                    lastPerspective = 1;
+                }
+            }
+
+            if (event.code == GLFW_KEY_2) {
+                // toggle off - the current camera is in ortho already
+                if (activeCamera == orthoCamera) {
+                    switch (lastPerspective) {
+                        case 1:
+                            activeCamera = firstPerspectiveCamera;
+                            break;
+                        case 3:
+                            activeCamera = thirdPerspectiveCamera;
+                            break;
+                    }
+                }
+                // toggle on - save the last used perspective and switch the camera to ortho
+                else {
+                    useOrthoCamera();
+                }
+            }
+        }
+
+        if (event.type == InputEvent::CURSOR) {
+            //move the camera view for the third person perspective camera
+            if (activeCamera == thirdPerspectiveCamera) {
+                thirdPerspectiveCamera->processMouse(event.x, event.y, isMouseClicked);
+            }
+
+            //pan the camera view for the orthographic camera
+            if (activeCamera == orthoCamera) {
+                orthoCamera->processMouse(event.x, event.y, isMouseClicked);
+            }
+        }
+
+        //implement dragging using mouse, the window captures the cursor while isMouseClicked is set
+        if (event.type == InputEvent::MOUSE_BUTTON && event.code == GLFW_MOUSE_BUTTON_LEFT) {
+            if (activeCamera == thirdPerspectiveCamera || activeCamera == orthoCamera) {
+                if (event.action == GLFW_PRESS) {
+                    isMouseClicked = true;
+                }
+                if (event.action == GLFW_RELEASE) {
+                    isMouseClicked = false;
+                }
+            }
+        }
+    }
+
+    //advances the moving objects by a simulation tick of deltaTime seconds
+    void simulate(InputState& input, float deltaTime) {
+        PROFILE_ZONE("Environment::simulate");
+
+        //keep the state of the previous tick so that frames can be drawn between ticks
+        playerModel->storePreviousState();
+        transformSystem->storePreviousState(entities);
+        orthoCamera->storePreviousState();
+
+        //the clips play on even while the player looks at the map
+        animationSystem->advance(deltaTime);
+
+        //the held keys move the submarine in the perspective views and pan the map in the birds-eye view
+        if (activeCamera == orthoCamera) {
+            orthoCamera->update(input, deltaTime);
+        }
+        else {
+            playerModel->update(input, deltaTime);
+        }
+    }
+
+    //computes the state that is drawn by blending the last two simulation ticks
+    void interpolate(float alpha) {
+        PROFILE_ZONE("Environment::interpolate");
+
+        //blend the models
+        playerModel->interpolate(alpha);
+        transformSystem->interpolate(entities, alpha);
+
+        //move the nodes of the player, the cameras and the spot light attached to them follow
+        sceneGraph.setLocalTransform(playerNode, glm::translate(glm::mat4(1.0f), playerModel->renderPosition));
+        sceneGraph.setLocalTransform(headingNode, playerModel->getRenderHeading());
+        sceneGraph.setLocalTransform(thirdPersonNode, thirdPerspectiveCamera->getOrbitTransform());
+        sceneGraph.update();
+
+        //blend the cameras
+        firstPerspectiveCamera->interpolate(alpha);
+        thirdPerspectiveCamera->interpolate(alpha);
+        orthoCamera->interpolate(alpha);
+    }
+
+    //creates an empty snapshot that can be filled by buildSnapshot
+    RenderSnapshot* createSnapshot() {
+        return new RenderSnapshot(*spotLight, *directionalLight);
+    }
+
+    //records the camera, lights, and visible models of the current state into a snapshot without calling opengl
+    void buildSnapshot(RenderSnapshot& snapshot) {
+        PROFILE_ZONE("Environment::buildSnapshot");
+
+        //compute the matrices of the active camera
+        activeCamera->computeViewMatrix();
+        activeCamera->computeProjectionMatrix();
+        snapshot.viewMatrix = activeCamera->viewMatrix;
+        snapshot.projectionMatrix = activeCamera->projectionMatrix;
+        snapshot.cameraPosition = activeCamera->renderPosition;
+        snapshot.inputTime = inputTime;
+
+        //remember what the view was built from so that a drag can be redone with the latest cursor position
+        snapshot.latch.mode = LatchState::NONE;
+        snapshot.latch.position = activeCamera->renderPosition;
+        snapshot.latch.target = activeCamera->renderTarget;
+        snapshot.latch.up = activeCamera->up;
+        if (isMouseClicked && activeCamera == thirdPerspectiveCamera && thirdPerspectiveCamera->isInitialized) {
+            snapshot.latch.mode = LatchState::ORBIT;
+            snapshot.latch.yaw = thirdPerspectiveCamera->yaw;
+            snapshot.latch.pitch = thirdPerspectiveCamera->pitch;
+            snapshot.latch.cursorX = thirdPerspectiveCamera->xLast;
+            snapshot.latch.cursorY = thirdPerspectiveCamera->yLast;
+        }
+        if (isMouseClicked && activeCamera == orthoCamera && orthoCamera->isInitialized) {
+            snapshot.latch.mode = LatchState::PAN;
+            snapshot.latch.cursorX = orthoCamera->xLast;
+            snapshot.latch.cursorY = orthoCamera->yLast;
+        }
+
+        //copy the lights so that they can change while the snapshot is drawn
+        snapshot.spotLight = *spotLight;
+        snapshot.directionalLight = *directionalLight;
 
-        //draws the objects on the screens
-        if (activeCamera == firstPerspectiveCamera) {
+        //the player is hidden in the first person view since the camera is inside it
+        snapshot.isFirstPerson = activeCamera == firstPerspectiveCamera;
+        snapshot.isPlayerVisible = !snapshot.isFirstPerson;
+        snapshot.playerPacket.model = playerModel;
+        snapshot.playerPacket.transform = playerModel->getTransformationMatrix();
+        snapshot.playerPacket.normalMatrix = Model3D::getNormalMatrix(snapshot.playerPacket.transform);
+        snapshot.playerPacket.vertexCount = playerModel->getVertexCount();
+
+        //keep the models whose bounding sphere is inside the view of the camera
+        Frustum frustum;
+        frustum.extract(snapshot.projectionMatrix * snapshot.viewMatrix);
+
+        transformSystem->update(entities);
+        animationSystem->update(entities, snapshot.cameraPosition);
+
+        snapshot.resetFrame();
+        snapshot.culledCount = visibilitySystem->collect(entities, frustum, snapshot);
+    }
+
+    //builds the passes that draw a snapshot and orders them, the first person view tints everything it draws with a
+    //constant blend color and draws the models without their color maps
+    void buildRenderGraph(RenderGraph* graph, bool isFirstPerson) {
+        RenderPassState state;
+        if (isFirstPerson) {
             //set the objects to a shade of color
-            modelShader->useProgram();
-            glUniform1i(glGetUniformLocation(modelShader->shaderProgram, "useTexture"), false);
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_CONSTANT_COLOR, GL_ZERO);
-            glBlendEquation(GL_FUNC_ADD);
-            glBlendColor(0.0f, 1.0f, 0.25f, 1.0f);
+            state.isBlending = true;
+            state.blendSource = GL_CONSTANT_COLOR;
+            state.blendDestination = GL_ZERO;
+            state.blendColor = glm::vec4(0.0f, 1.0f, 0.25f, 1.0f);
+        }
+
+        //the skybox is drawn behind everything and leaves the depth as it is
+        RenderPassState skyboxState = state;
+        skyboxState.isDepthWriting = false;
+        skyboxState.depthFunction = GL_LEQUAL;
+
+        bool isTextured = !isFirstPerson;
+        int screen = graph->importFramebuffer("Screen");
+
+        //the player is hidden in the first person view since the camera is inside it
+        if (!isFirstPerson) {
+            graph->write(graph->addPass("Player", state, [this]() { drawPlayer(*drawnSnapshot); }), screen);
+        }
+        graph->write(graph->addPass("Models", state, [this, isTextured]() { drawModels(*drawnSnapshot, isTextured); }), screen);
+        graph->write(graph->addPass("Animated", state, [this, isTextured]() { drawAnimatedModels(*drawnSnapshot, isTextured); }), screen);
+        graph->write(graph->addPass("Impostors", state, [this, isTextured]() { drawImpostors(*drawnSnapshot, isTextured); }), screen);
+        graph->write(graph->addPass("Placeholders", state, [this]() { drawPlaceholders(*drawnSnapshot); }), screen);
+        graph->write(graph->addPass("Skybox", skyboxState, [this]() { drawSkybox(*drawnSnapshot); }), screen);
+
+        graph->compile();
+    }
+
+    //draws the objects of a snapshot on the screen with the render graph of its view
+    void submitSnapshot(RenderSnapshot& snapshot) {
+        PROFILE_ZONE("Environment::submitSnapshot");
+
+        //count the draw calls of this frame from zero
+        renderStats.reset();
+        frameNumber++;
+        renderStats.culledModels = snapshot.culledCount;
+
+        drawnSnapshot = &snapshot;
+        if (snapshot.isFirstPerson) {
+            firstPersonGraph->execute();
         }
         else {
-            modelShader->useProgram();
-            glUniform1i(glGetUniformLocation(modelShader->shaderProgram, "useTexture"), true);
-            //disable blending and draw the player model
-            glDisable(GL_BLEND);
-            playerModel->draw(*playerShader);
+            renderGraph->execute();
+        }
+        drawnSnapshot = NULL;
+    }
+
+    //draws the player model
+    void drawPlayer(RenderSnapshot& snapshot) {
+        if (!snapshot.isPlayerVisible) {
+            return;
+        }
+
+        updateShader(*playerShader, snapshot);
+        DrawPacket& packet = snapshot.playerPacket;
+        packet.model->draw(*playerShader, packet.transform, packet.normalMatrix);
+        renderStats.addDraw(packet.vertexCount / 3);
+    }
+
+    //draws all the other models, the color maps are layers of shared arrays so a texture is only bound when the array changes
+    void drawModels(RenderSnapshot& snapshot, bool isTextured) {
+        Shader* modelVariant = isTextured ? modelShader : untexturedModelShader;
+        updateShader(*modelVariant, snapshot);
+        glActiveTexture(GL_TEXTURE0);
+        glUniform1i(glGetUniformLocation(modelVariant->shaderProgram, "textureArray"), 0);
+        unsigned int textureLayerLoc = glGetUniformLocation(modelVariant->shaderProgram, "textureLayer");
+        GLuint boundArray = 0;
+
+        for (int i = 0; i < snapshot.modelPackets.size(); i++) {
+            DrawPacket& packet = snapshot.modelPackets[i];
+            if (isTextured) {
+                if (packet.albedoLayer.texture != boundArray) {
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D_ARRAY, packet.albedoLayer.texture);
+                    boundArray = packet.albedoLayer.texture;
+                }
+                glUniform1i(textureLayerLoc, packet.albedoLayer.layer);
+            }
+
+            packet.model->draw(*modelVariant, packet.transform, packet.normalMatrix);
+            packet.model->lastDrawnFrame = frameNumber;
+            renderStats.addDraw(packet.vertexCount / 3);
+        }
+    }
+
+    //draws the models that are posed by a clip, which read their frames from a texture after the color maps
+    void drawAnimatedModels(RenderSnapshot& snapshot, bool isTextured) {
+        if (snapshot.animatedPackets.empty()) {
+            return;
         }
 
-        //draw all the other models
-        for (int i = 0; i < otherModels.size(); i++) {
-            otherModels[i]->draw(*modelShader);
+        Shader* animatedVariant = isTextured ? animatedModelShader : untexturedAnimatedModelShader;
+        updateShader(*animatedVariant, snapshot);
+        glUniform1i(glGetUniformLocation(animatedVariant->shaderProgram, "textureArray"), 0);
+        unsigned int textureLayerLoc = glGetUniformLocation(animatedVariant->shaderProgram, "textureLayer");
+        GLuint boundArray = 0;
+
+        for (int i = 0; i < snapshot.animatedPackets.size(); i++) {
+            DrawPacket& packet = snapshot.animatedPackets[i];
+            if (isTextured) {
+                if (packet.albedoLayer.texture != boundArray) {
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D_ARRAY, packet.albedoLayer.texture);
+                    boundArray = packet.albedoLayer.texture;
+                }
+                glUniform1i(textureLayerLoc, packet.albedoLayer.layer);
+            }
+
+            packet.model->animation->bind(*animatedVariant, 1, packet.animationFrame);
+            packet.model->draw(*animatedVariant, packet.transform, packet.normalMatrix);
+            packet.model->lastDrawnFrame = frameNumber;
+            renderStats.addDraw(packet.vertexCount / 3);
+        }
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    //draws the models that are small on the screen as a quad with their views, the corners of the quads come from
+    //the vertex ids so only an empty vertex array is bound
+    void drawImpostors(RenderSnapshot& snapshot, bool isTextured) {
+        if (snapshot.impostorPackets.empty()) {
+            return;
         }
 
-        //draw the skybox
+        Shader* impostorVariant = isTextured ? impostorShader : untexturedImpostorShader;
+        updateShader(*impostorVariant, snapshot);
+        unsigned int transformLoc = glGetUniformLocation(impostorVariant->shaderProgram, "transform");
+        unsigned int normalMatrixLoc = glGetUniformLocation(impostorVariant->shaderProgram, "normalMatrix");
+        glBindVertexArray(impostorVAO);
+
+        for (int i = 0; i < snapshot.impostorPackets.size(); i++) {
+            DrawPacket& packet = snapshot.impostorPackets[i];
+            glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(packet.transform));
+            glUniformMatrix3fv(normalMatrixLoc, 1, GL_FALSE, glm::value_ptr(packet.normalMatrix));
+            packet.model->impostor->bind(*impostorVariant, packet.transform, snapshot.cameraPosition);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            packet.model->lastDrawnFrame = frameNumber;
+            renderStats.addDraw(2);
+        }
+
+        glBindVertexArray(0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    //draws a box for every model that is still loading
+    void drawPlaceholders(RenderSnapshot& snapshot) {
+        if (snapshot.placeholderPackets.empty()) {
+            return;
+        }
+
+        updateShader(*untexturedModelShader, snapshot);
+        for (int i = 0; i < snapshot.placeholderPackets.size(); i++) {
+            DrawPacket& packet = snapshot.placeholderPackets[i];
+            placeholderBox->draw(*untexturedModelShader, packet.transform, packet.normalMatrix);
+            renderStats.addDraw(0);
+
+            //a model whose mesh was evicted is drawn as its placeholder, which marks it to be restored
+            if (packet.model) {
+                packet.model->lastDrawnFrame = frameNumber;
+            }
+        }
+    }
+
+    //draws the skybox based on the camera perspective
+    void drawSkybox(RenderSnapshot& snapshot) {
+        skybox->setViewMatrix(*skyboxShader, snapshot.viewMatrix);
+        skybox->setProjectionMatrix(*skyboxShader, snapshot.projectionMatrix);
+        skybox->setTransformationMatrix(*skyboxShader);
         skybox->draw(*skyboxShader);
+        renderStats.addDraw(12);
     }
 
     //updates the uniform values in the shader file
-    void updateShader(Shader shader) {
+    void updateShader(Shader shader, RenderSnapshot& snapshot) {
+        PROFILE_ZONE("Environment::updateShader");
+
+        shader.useProgram();
+
         //updates the uniform values of the active camera
-        activeCamera->setViewMatrix(shader);
-        activeCamera->setProjectionMatrix(shader);
-        activeCamera->setCameraPosition(shader);
+        glUniformMatrix4fv(glGetUniformLocation(shader.shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(snapshot.viewMatrix));
+        glUniformMatrix4fv(glGetUniformLocation(shader.shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(snapshot.projectionMatrix));
+        glUniform3fv(glGetUniformLocation(shader.shaderProgram, "cameraPos"), 1, glm::value_ptr(snapshot.cameraPosition));
 
         //updates the uniform values of the spot light
-        spotLight->setAmbientStr(shader);
-        spotLight->setSpecStr(shader);
-        spotLight->setSpecPhong(shader);
-        spotLight->setLightColor(shader);
-        spotLight->setLightIntensity(shader);
-        spotLight->setLightPosition(shader);
-        spotLight->setLightDirection(shader);
-        spotLight->setAttenuationConstants(shader);
-        spotLight->setCutoff(shader);
-        spotLight->setOuterCutoff(shader);
+        SpotLight& spotLight = snapshot.spotLight;
+        spotLight.setAmbientStr(shader);
+        spotLight.setSpecStr(shader);
+        spotLight.setSpecPhong(shader);
+        spotLight.setLightColor(shader);
+        spotLight.setLightIntensity(shader);
+        spotLight.setLightPosition(shader);
+        spotLight.setLightDirection(shader);
+        spotLight.setAttenuationConstants(shader);
+        spotLight.setCutoff(shader);
+        spotLight.setOuterCutoff(shader);
 
         //updates the uniform values of the directional light
-        directionalLight->setAmbientStr(shader);
-        directionalLight->setSpecStr(shader);
-        directionalLight->setSpecPhong(shader);
-        directionalLight->setLightColor(shader);
-        directionalLight->setLightIntensity(shader);
-        directionalLight->setLightDirection(shader);
+        DirectionalLight& directionalLight = snapshot.directionalLight;
+        directionalLight.setAmbientStr(shader);
+        directionalLight.setSpecStr(shader);
+        directionalLight.setSpecPhong(shader);
+        directionalLight.setLightColor(shader);
+        directionalLight.setLightIntensity(shader);
+        directionalLight.setLightDirection(shader);
     }
 };
@@ -0,0 +1,9 @@
+#pragma once
+
+class JobCounter;
+
+//stores a task that is run by the job system
+struct Job {
+    std::function<void()> task; //work of the job
+    JobCounter* counter; //counter that is decremented once the task is done, NULL if nothing waits for the job
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+//JobBenchmark class measures how the job system scales by transforming and culling a large batch of objects with 1 to N threads
+class JobBenchmark {
+public:
+    static const int ELEMENT_COUNT = 1 << 20; //number of objects processed in every run
+    static const int GRAIN_SIZE = 4096; //number of objects in every job
+    static const int REPETITIONS = 9; //number of timed runs for every thread count, the median is reported
+
+    std::vector<glm::vec3> positions; //position of every object
+    std::vector<glm::vec3> rotations; //rotation of every object in degrees
+    std::vector<glm::mat4> transforms; //transformation matrix computed for every object
+    std::vector<unsigned char> visibility; //result of the visibility test of every object
+    Frustum frustum; //view that the objects are tested against
+
+    //constructor for the job benchmark class which fills the objects with the same values in every run
+    JobBenchmark() {
+        positions.resize(ELEMENT_COUNT);
+        rotations.resize(ELEMENT_COUNT);
+        transforms.resize(ELEMENT_COUNT);
+        visibility.resize(ELEMENT_COUNT);
+
+        unsigned int seed = 12345;
+        for (int i = 0; i < ELEMENT_COUNT; i++) {
+            for (int j = 0; j < 3; j++) {
+                seed = seed * 1664525u + 1013904223u;
+                positions[i][j] = (seed >> 8) / (float)(1 << 24) * 200.0f - 100.0f;
+                seed = seed * 1664525u + 1013904223u;
+                rotations[i][j] = (seed >> 8) / (float)(1 << 24) * 360.0f;
+            }
+        }
+
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+        frustum.extract(projection * view);
+    }
+
+    //computes the transformation matrix and the visibility of the objects in [begin, end)
+    void process(int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), positions[i]);
+            transform = glm::rotate(transform, glm::radians(rotations[i].x), glm::vec3(1.0f, 0.0f, 0.0f));
+            transform = glm::rotate(transform, glm::radians(rotations[i].y), glm::vec3(0.0f, 1.0f, 0.0f));
+            transform = glm::rotate(transform, glm::radians(rotations[i].z), glm::vec3(0.0f, 0.0f, 1.0f));
+
+            transforms[i] = transform;
+            visibility[i] = frustum.isSphereVisible(glm::vec3(transform[3]), 1.0f);
+        }
+    }
+
+    //returns the median time in milliseconds of processing every object with the given number of threads
+    double measure(int threadCount) {
+        JobSystem jobSystem(threadCount - 1);
+        std::vector<double> times;
+
+        //the first run warms up the caches and the threads
+        for (int i = 0; i <= REPETITIONS; i++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            jobSystem.parallelFor(0, ELEMENT_COUNT, GRAIN_SIZE, [this](int begin, int end) { process(begin, end); });
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            if (i > 0) {
+                times.push_back(milliseconds);
+            }
+        }
+
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    //prints the time, speedup, and efficiency of every thread count from 1 to maxThreads
+    void run(int maxThreads) {
+        std::cout << "[JOBS] " << ELEMENT_COUNT << " transforms and visibility tests, " << GRAIN_SIZE << " per job\n";
+        std::cout << "threads        ms   speedup  efficiency\n";
+
+        double baseline = 0.0;
+        for (int threads = 1; threads <= maxThreads; threads++) {
+            double milliseconds = measure(threads);
+            if (threads == 1) {
+                baseline = milliseconds;
+            }
+
+            double speedup = baseline / milliseconds;
+            std::cout << std::setw(7) << threads
+                << std::setw(10) << std::fixed << std::setprecision(2) << milliseconds
+                << std::setw(10) << speedup
+                << std::setw(11) << std::setprecision(0) << speedup / threads * 100.0 << "%\n";
+        }
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+//JobCounter class counts the jobs of a group that have not finished yet
+//
+//waiting on a counter blocks until it reaches zero, and jobs that depend on the group are held by the counter until then
+class JobCounter {
+public:
+    std::atomic<int> count; //number of jobs that have not finished yet
+    std::mutex mutex; //guards the list of dependent jobs
+    std::vector<Job*> dependents; //jobs that are started once the count reaches zero
+
+    //constructor for the job counter class
+    JobCounter() {
+        count = 0;
+    }
+
+    //checks if every job of the group has finished
+    bool isDone() {
+        return count.load(std::memory_order_acquire) == 0;
+    }
+};
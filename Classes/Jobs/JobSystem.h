@@ -0,0 +1,240 @@
+#pragma once
+
+//JobSystem class runs jobs on a fixed pool of worker threads that steal work from each other
+//
+//every worker owns a work stealing queue and the thread that created the system owns one more. jobs pushed from one of
+//these threads go to its own queue, idle workers steal from the others, and a thread that waits on a counter runs
+//queued jobs until the counter reaches zero instead of blocking. threads outside the system run their jobs inline.
+class JobSystem {
+public:
+    int workerCount; //number of worker threads, the owner thread is not counted
+    std::thread::id ownerThread; //thread that created the system and owns the first queue
+    std::vector<WorkStealingQueue*> queues; //queue of the owner thread followed by the queues of the workers
+    std::vector<std::thread> workers; //worker threads
+
+    std::atomic<bool> isStopping; //checks if the workers should exit
+    std::atomic<int> queuedJobs; //number of jobs that are in a queue and have not been taken yet
+    std::mutex sleepMutex; //guards the sleep of the idle workers
+    std::condition_variable sleepCondition; //wakes the idle workers when a job is queued
+    PoolAllocator<Job> jobPool; //jobs are created from a pool since every frame queues new ones
+
+    //returns the number of workers that keeps every core busy together with the owner thread
+    static int defaultWorkerCount() {
+        int cores = (int)std::thread::hardware_concurrency();
+        return glm::max(cores - 1, 1);
+    }
+
+    //returns the system that the calling worker thread belongs to, NULL for threads that are not workers
+    static JobSystem*& currentSystem() {
+        thread_local JobSystem* system = NULL;
+        return system;
+    }
+
+    //returns the index of the queue of the calling worker thread
+    static int& currentIndex() {
+        thread_local int index = -1;
+        return index;
+    }
+
+    //constructor for the job system class
+    JobSystem(int workerCount) {
+        this->workerCount = glm::max(workerCount, 0);
+        ownerThread = std::this_thread::get_id();
+        isStopping = false;
+        queuedJobs = 0;
+
+        for (int i = 0; i <= this->workerCount; i++) {
+            queues.push_back(new WorkStealingQueue());
+        }
+
+        for (int i = 1; i <= this->workerCount; i++) {
+            workers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+        }
+    }
+
+    //destructor for the job system class
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            isStopping = true;
+        }
+        sleepCondition.notify_all();
+
+        for (int i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+
+        for (int i = 0; i < queues.size(); i++) {
+            delete queues[i];
+        }
+    }
+
+    //returns the queue index of the calling thread, -1 if the thread does not belong to the system
+    int getThreadIndex() {
+        if (currentSystem() == this) {
+            return currentIndex();
+        }
+        if (std::this_thread::get_id() == ownerThread) {
+            return 0;
+        }
+        return -1;
+    }
+
+    //queues a task, the counter (if any) reaches zero once the task and the other tasks of its group are done
+    void run(std::function<void()> task, JobCounter* counter) {
+        if (counter) {
+            counter->count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Job* job = jobPool.create();
+        job->task = task;
+        job->counter = counter;
+        push(job);
+    }
+
+    //queues a task that only starts once every job counted by the dependency has finished
+    void runAfter(JobCounter* dependency, std::function<void()> task, JobCounter* counter) {
+        if (counter) {
+            counter->count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Job* job = jobPool.create();
+        job->task = task;
+        job->counter = counter;
+
+        //hold the job in the dependency if it is still running, the last job of the group will queue it
+        {
+            std::lock_guard<std::mutex> lock(dependency->mutex);
+            if (!dependency->isDone()) {
+                dependency->dependents.push_back(job);
+                return;
+            }
+        }
+
+        push(job);
+    }
+
+    //runs the body over [begin, end) split into ranges of at most grainSize elements, returns once every range is done
+    //
+    //the body is taken as is instead of as a std::function and the jobs only point to it, so that a range that fits in
+    //one job does not allocate
+    template <typename Body>
+    void parallelFor(int begin, int end, int grainSize, const Body& body) {
+        grainSize = glm::max(grainSize, 1);
+
+        //small ranges are not worth the cost of a job
+        if (end - begin <= grainSize) {
+            if (end > begin) {
+                body(begin, end);
+            }
+            return;
+        }
+
+        JobCounter counter;
+        for (int start = begin + grainSize; start < end; start += grainSize) {
+            int stop = glm::min(start + grainSize, end);
+            run([&body, start, stop]() { body(start, stop); }, &counter);
+        }
+
+        //work on the first range while the others are picked up
+        body(begin, glm::min(begin + grainSize, end));
+
+        wait(&counter);
+    }
+
+    //runs queued jobs on the calling thread until every job counted by the counter has finished
+    void wait(JobCounter* counter) {
+        int index = getThreadIndex();
+
+        while (!counter->isDone()) {
+            Job* job = index >= 0 ? findJob(index) : NULL;
+            if (job) {
+                execute(job);
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+
+        //the last job releases the lock of the counter after the count reaches zero, so wait for it before the caller can destroy the counter
+        std::lock_guard<std::mutex> lock(counter->mutex);
+    }
+
+    //adds a job to the queue of the calling thread and wakes a worker
+    void push(Job* job) {
+        int index = getThreadIndex();
+
+        //threads outside the system and full queues run the job right away
+        if (index < 0 || !queues[index]->push(job)) {
+            execute(job);
+            return;
+        }
+
+        queuedJobs.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        sleepCondition.notify_one();
+    }
+
+    //takes a job from the queue of the thread or steals one from another queue
+    Job* findJob(int index) {
+        Job* job = queues[index]->pop();
+
+        //look at the other queues starting after our own so that the thieves spread out
+        for (int i = 1; !job && i < queues.size(); i++) {
+            job = queues[(index + i) % queues.size()]->steal();
+        }
+
+        if (job) {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    //runs a job and queues the jobs that were waiting for its group
+    void execute(Job* job) {
+        job->task();
+
+        JobCounter* counter = job->counter;
+        jobPool.destroy(job);
+
+        if (!counter) {
+            return;
+        }
+
+        //take the dependents in the same lock that runAfter checks the count in, so that none of them is missed
+        std::vector<Job*> dependents;
+        {
+            std::lock_guard<std::mutex> lock(counter->mutex);
+            if (counter->count.load(std::memory_order_relaxed) == 1) {
+                dependents.swap(counter->dependents);
+            }
+            counter->count.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        for (int i = 0; i < dependents.size(); i++) {
+            push(dependents[i]);
+        }
+    }
+
+    //loop of a worker thread
+    void workerLoop(int index) {
+        currentSystem() = this;
+        currentIndex() = index;
+        CPUProfiler::instance().setThreadName("Job Worker " + std::to_string(index));
+
+        while (!isStopping) {
+            Job* job = findJob(index);
+            if (job) {
+                execute(job);
+                continue;
+            }
+
+            //sleep until a job is queued, the timeout covers jobs that are queued while a worker is going to sleep
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCondition.wait_for(lock, std::chrono::milliseconds(1), [this]() { return queuedJobs.load(std::memory_order_acquire) > 0 || isStopping; });
+        }
+    }
+};
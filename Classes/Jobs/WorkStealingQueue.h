@@ -0,0 +1,82 @@
+#pragma once
+
+//WorkStealingQueue class is a fixed size Chase-Lev deque of jobs
+//
+//only the owning thread pushes and pops at the bottom, other threads steal from the top. the queue does not grow,
+//so push fails when it is full and the caller runs the job itself.
+class WorkStealingQueue {
+public:
+    static const int CAPACITY = 4096; //maximum number of queued jobs, must be a power of two
+    static const int MASK = CAPACITY - 1; //turns an index into a slot of the ring
+
+    std::atomic<long long> top; //index of the oldest job, advanced by the thieves
+    std::atomic<long long> bottom; //index after the newest job, only changed by the owner
+    std::vector<std::atomic<Job*>> slots; //ring of queued jobs
+
+    //constructor for the work stealing queue class
+    WorkStealingQueue() : slots(CAPACITY) {
+        top = 0;
+        bottom = 0;
+    }
+
+    //adds a job at the bottom, only called by the owning thread
+    bool push(Job* job) {
+        long long b = bottom.load(std::memory_order_relaxed);
+        long long t = top.load(std::memory_order_acquire);
+        if (b - t >= CAPACITY) {
+            return false;
+        }
+
+        slots[b & MASK].store(job, std::memory_order_relaxed);
+
+        //the job has to be visible before the thieves can see the new bottom
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    //removes the newest job, only called by the owning thread
+    Job* pop() {
+        long long b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = top.load(std::memory_order_relaxed);
+
+        //the queue was empty
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return NULL;
+        }
+
+        Job* job = slots[b & MASK].load(std::memory_order_relaxed);
+
+        //the last job can also be taken by a thief, so both race for it on the top index
+        if (t == b) {
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = NULL;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    //removes the oldest job, called by any thread other than the owner
+    Job* steal() {
+        long long t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return NULL;
+        }
+
+        Job* job = slots[t & MASK].load(std::memory_order_relaxed);
+
+        //another thief or the owner took the job first
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return NULL;
+        }
+
+        return job;
+    }
+};
@@ -1,7 +1,7 @@
 #include "Light.h"
 #pragma once
 
-class SpotLight : public Light {
+class SpotLight : public Light, public SceneAttachment {
 
 public:
     glm::vec3 position;
@@ -37,6 +37,11 @@ public:
         this->direction = direction;
     }
 
+    //places the light at the origin of a node shining along the z axis of the node
+    void followTransform(glm::mat4 worldTransform) override {
+        updateFields(glm::vec3(worldTransform[3]), glm::normalize(glm::vec3(worldTransform[2])));
+    }
+
     //set the value of the ambient strength in the shader
     void setAmbientStr(Shader shader) override {
         shader.useProgram();
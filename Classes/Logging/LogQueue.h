@@ -0,0 +1,77 @@
+#pragma once
+
+//LogQueue class is a fixed size multiple producer single consumer ring of log records
+//
+//every slot has a sequence number that tells whose turn it is: a producer claims a slot by moving the tail forward
+//with a compare and swap and publishes it by advancing the sequence, then the consumer copies the record out and
+//hands the slot back to the producers of the next lap. no thread ever waits on a lock, and a full ring drops the
+//record instead of blocking the thread that logged it.
+class LogQueue {
+public:
+    static const int CAPACITY = 4096; //maximum number of queued records, must be a power of two
+    static const int MASK = CAPACITY - 1; //turns an index into a slot of the ring
+
+    //stores a record together with the lap it belongs to
+    struct Slot {
+        std::atomic<unsigned int> sequence; //index the slot is ready for, index + 1 once the record is written
+        LogRecord record; //record of the slot
+    };
+
+    std::vector<Slot> slots; //ring of records
+    std::atomic<unsigned int> tail; //index of the next slot that a producer claims
+    unsigned int head; //index of the next record that the consumer reads, only used by the consumer
+    std::atomic<unsigned int> droppedCount; //number of records lost because the ring was full
+
+    //constructor for the log queue class
+    LogQueue() : slots(CAPACITY) {
+        for (int i = 0; i < CAPACITY; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        tail = 0;
+        head = 0;
+        droppedCount = 0;
+    }
+
+    //adds a record at the end, can be called from any thread
+    bool push(LogRecord& record) {
+        unsigned int index = tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            Slot& slot = slots[index & MASK];
+            int difference = (int)(slot.sequence.load(std::memory_order_acquire) - index);
+
+            if (difference == 0) {
+                //the slot is free for this lap, claim it before another producer does
+                if (tail.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+                    slot.record = record;
+                    slot.sequence.store(index + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                //the consumer has not read the record of the previous lap yet
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else {
+                //another producer took the slot, try the next one
+                index = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //removes the oldest record, only called by the consumer
+    bool pop(LogRecord& record) {
+        Slot& slot = slots[head & MASK];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+
+        record = slot.record;
+
+        //give the slot to the producers of the next lap
+        slot.sequence.store(head + CAPACITY, std::memory_order_release);
+        head++;
+        return true;
+    }
+};
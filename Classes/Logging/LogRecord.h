@@ -0,0 +1,180 @@
+#pragma once
+
+//stores a single argument of a log record without formatting it
+struct LogArgument {
+    static const int INTEGER = 0; //the argument is stored in integer
+    static const int REAL = 1; //the argument is stored in real
+    static const int TEXT = 2; //the argument is copied into the text buffer of the record
+
+    int type; //kind of argument
+    long long integer; //value of an integer argument
+    double real; //value of a floating point argument
+    int textOffset, textLength; //characters of a text argument in the text buffer of the record
+};
+
+//LogRecord class stores a message in binary form, the text is only put together by the thread that writes the log
+//
+//the format and category must be string literals since only their pointers are kept. placeholders in the format are
+//written as {} and replaced by the arguments in order, {.N} writes a floating point argument with N decimals.
+class LogRecord {
+public:
+    static const int LEVEL_INFO = 0; //regular message written to the standard output
+    static const int LEVEL_WARNING = 1; //message about something unexpected that the program recovered from
+    static const int LEVEL_ERROR = 2; //message about something that failed
+    static const int LEVEL_STATUS = 3; //status line that overwrites the previous status line on the console
+
+    static const int MAX_ARGUMENTS = 6; //number of arguments a record can hold
+    static const int TEXT_CAPACITY = 192; //number of characters of text arguments a record can hold
+
+    uint64_t time; //nanoseconds since the logger was created
+    int level; //severity of the message
+    int thread; //index of the thread that logged the message
+    const char* category; //part of the program the message comes from
+    const char* format; //message with placeholders for the arguments
+    int argumentCount; //number of arguments that were stored
+    LogArgument arguments[MAX_ARGUMENTS]; //arguments that replace the placeholders
+    int textLength; //number of characters used in the text buffer
+    char text[TEXT_CAPACITY]; //characters of the text arguments
+
+    //stores an integer argument
+    void add(long long value) {
+        if (argumentCount >= MAX_ARGUMENTS) {
+            return;
+        }
+
+        LogArgument& argument = arguments[argumentCount++];
+        argument.type = LogArgument::INTEGER;
+        argument.integer = value;
+    }
+
+    void add(int value) {
+        add((long long)value);
+    }
+
+    void add(unsigned int value) {
+        add((long long)value);
+    }
+
+    void add(long value) {
+        add((long long)value);
+    }
+
+    void add(unsigned long value) {
+        add((long long)value);
+    }
+
+    void add(unsigned long long value) {
+        add((long long)value);
+    }
+
+    //stores a floating point argument
+    void add(double value) {
+        if (argumentCount >= MAX_ARGUMENTS) {
+            return;
+        }
+
+        LogArgument& argument = arguments[argumentCount++];
+        argument.type = LogArgument::REAL;
+        argument.real = value;
+    }
+
+    void add(float value) {
+        add((double)value);
+    }
+
+    //copies a text argument into the record, long text is cut off at the end of the buffer
+    void add(const char* value) {
+        if (argumentCount >= MAX_ARGUMENTS) {
+            return;
+        }
+
+        if (value == NULL) {
+            value = "(null)";
+        }
+
+        LogArgument& argument = arguments[argumentCount++];
+        argument.type = LogArgument::TEXT;
+        argument.textOffset = textLength;
+        argument.textLength = 0;
+        while (value[argument.textLength] != '\0' && textLength < TEXT_CAPACITY) {
+            text[textLength++] = value[argument.textLength++];
+        }
+    }
+
+    void add(const unsigned char* value) {
+        add((const char*)value);
+    }
+
+    void add(const std::string& value) {
+        add(value.c_str());
+    }
+
+    //stores the arguments one after the other
+    void addAll() {
+    }
+
+    template <typename First, typename... Rest>
+    void addAll(First first, Rest... rest) {
+        add(first);
+        addAll(rest...);
+    }
+
+    //puts the message together by replacing the placeholders of the format with the arguments
+    std::string formatMessage() {
+        std::string message;
+        int next = 0;
+
+        for (const char* c = format; *c != '\0'; c++) {
+            if (*c != '{') {
+                message += *c;
+                continue;
+            }
+
+            //find the end of the placeholder, a lone brace is written as is
+            const char* end = c + 1;
+            while (*end != '\0' && *end != '}') {
+                end++;
+            }
+            if (*end == '\0') {
+                message += *c;
+                continue;
+            }
+
+            int precision = -1;
+            if (c[1] == '.') {
+                precision = atoi(c + 2);
+            }
+
+            if (next < argumentCount) {
+                appendArgument(message, arguments[next++], precision);
+            }
+            c = end;
+        }
+
+        return message;
+    }
+
+    //writes a single argument at the end of a message
+    void appendArgument(std::string& message, LogArgument& argument, int precision) {
+        char buffer[64];
+
+        switch (argument.type) {
+            case LogArgument::INTEGER:
+                snprintf(buffer, sizeof(buffer), "%lld", argument.integer);
+                message += buffer;
+                break;
+            case LogArgument::REAL:
+                if (precision >= 0) {
+                    snprintf(buffer, sizeof(buffer), "%.*f", precision, argument.real);
+                }
+                else {
+                    snprintf(buffer, sizeof(buffer), "%g", argument.real);
+                }
+                message += buffer;
+                break;
+            case LogArgument::TEXT:
+                message.append(text + argument.textOffset, argument.textLength);
+                break;
+        }
+    }
+};
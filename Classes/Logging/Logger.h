@@ -0,0 +1,282 @@
+#pragma once
+
+//Logger class queues log records from any thread and writes them to the console and the log file on its own thread
+//
+//logging a message only copies its arguments into a record and pushes it into a lock free queue, so a thread that
+//logs never waits for the terminal or the disk. the writer thread puts the text together, prints it, and appends it
+//as a json line to the log file when one is open.
+class Logger {
+public:
+    LogQueue queue; //records waiting to be written
+    std::thread writer; //thread that formats and writes the records
+    std::mutex writerMutex; //guards the file and the counters shared with the writer
+    std::condition_variable writerCondition; //wakes the writer and the threads waiting for a flush
+    bool isStopping; //checks if the writer should exit once the queue is empty
+    unsigned int writtenCount; //number of records the writer has written, wraps around with the tail of the queue
+    unsigned int reportedDrops; //number of dropped records that were already reported
+    bool isStatusOpen; //checks if the console line is a status line without a line break
+    std::ofstream file; //json lines file that receives every record, closed if no file was requested
+    std::chrono::steady_clock::time_point startTime; //time when the logger was created
+    std::atomic<int> threadCount; //number of threads that have logged a record
+
+    static const int WRITE_INTERVAL_MS = 5; //time the writer sleeps when the queue is empty
+
+    //returns the logger shared by every thread
+    static Logger& instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    //returns the index of the calling thread in the records
+    static int threadIndex() {
+        thread_local int index = instance().threadCount.fetch_add(1);
+        return index;
+    }
+
+    //constructor for the logger class which starts the writer thread
+    Logger() {
+        isStopping = false;
+        writtenCount = 0;
+        reportedDrops = 0;
+        isStatusOpen = false;
+        threadCount = 0;
+        startTime = std::chrono::steady_clock::now();
+
+        writer = std::thread(&Logger::writerLoop, this);
+    }
+
+    //destructor for the logger class which writes the queued records before the writer exits
+    ~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            isStopping = true;
+        }
+        writerCondition.notify_all();
+        writer.join();
+    }
+
+    //writes every record to a json lines file as well as the console
+    bool openFile(std::string path) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        file.open(path);
+        return file.is_open();
+    }
+
+    //queues a message at the given level
+    template <typename... Arguments>
+    void log(int level, const char* category, const char* format, Arguments... arguments) {
+        LogRecord record;
+        record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+        record.level = level;
+        record.thread = threadIndex();
+        record.category = category;
+        record.format = format;
+        record.argumentCount = 0;
+        record.textLength = 0;
+        record.addAll(arguments...);
+
+        queue.push(record);
+    }
+
+    template <typename... Arguments>
+    void info(const char* category, const char* format, Arguments... arguments) {
+        log(LogRecord::LEVEL_INFO, category, format, arguments...);
+    }
+
+    template <typename... Arguments>
+    void warning(const char* category, const char* format, Arguments... arguments) {
+        log(LogRecord::LEVEL_WARNING, category, format, arguments...);
+    }
+
+    template <typename... Arguments>
+    void error(const char* category, const char* format, Arguments... arguments) {
+        log(LogRecord::LEVEL_ERROR, category, format, arguments...);
+    }
+
+    template <typename... Arguments>
+    void status(const char* category, const char* format, Arguments... arguments) {
+        log(LogRecord::LEVEL_STATUS, category, format, arguments...);
+    }
+
+    //blocks until every record that was queued before the call has been written
+    void flush() {
+        unsigned int target = queue.tail.load(std::memory_order_acquire);
+
+        //the counts wrap around, so they are compared by their difference like the indices of the queue
+        std::unique_lock<std::mutex> lock(writerMutex);
+        writerCondition.notify_all();
+        writerCondition.wait(lock, [this, target]() { return (int)(writtenCount - target) >= 0 || isStopping; });
+    }
+
+    //formats and writes the queued records until the logger is removed
+    void writerLoop() {
+        CPUProfiler::instance().setThreadName("Log Writer");
+
+        std::unique_lock<std::mutex> lock(writerMutex);
+        while (true) {
+            bool isExiting = isStopping;
+
+            //write without holding the lock so that flush and openFile never wait for the terminal
+            lock.unlock();
+            int count = writeQueued();
+            lock.lock();
+
+            if (count > 0) {
+                writtenCount += count;
+                writerCondition.notify_all();
+            }
+
+            if (isExiting && count == 0) {
+                break;
+            }
+            if (count == 0) {
+                writerCondition.wait_for(lock, std::chrono::milliseconds(WRITE_INTERVAL_MS));
+            }
+        }
+
+        //leave the console on a new line
+        if (isStatusOpen) {
+            fputs("\n", stdout);
+        }
+        fflush(stdout);
+        fflush(stderr);
+        if (file.is_open()) {
+            file.flush();
+        }
+    }
+
+    //writes every record that is in the queue, returns the number of records written
+    int writeQueued() {
+        LogRecord record;
+        int count = 0;
+
+        while (queue.pop(record)) {
+            write(record);
+            count++;
+        }
+
+        //say how many records were lost since the queue was last full
+        unsigned int dropped = queue.droppedCount.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops) {
+            writeLine(stderr, "[LOG] " + std::to_string(dropped - reportedDrops) + " records were dropped because the queue was full");
+            reportedDrops = dropped;
+        }
+
+        if (count > 0) {
+            fflush(stdout);
+            if (file.is_open()) {
+                file.flush();
+            }
+        }
+
+        return count;
+    }
+
+    //writes a single record to the console and the file
+    void write(LogRecord& record) {
+        std::string message = record.formatMessage();
+
+        if (record.level == LogRecord::LEVEL_STATUS) {
+            //go back to the start of the line so that the new status replaces the old one
+            fputs("\r", stdout);
+            fputs(message.c_str(), stdout);
+            isStatusOpen = true;
+        }
+        else {
+            writeLine(record.level == LogRecord::LEVEL_INFO ? stdout : stderr, message);
+        }
+
+        if (file.is_open()) {
+            writeJSON(record, message);
+        }
+    }
+
+    //writes a message followed by a line break, moving off an open status line first
+    void writeLine(FILE* stream, std::string message) {
+        if (isStatusOpen) {
+            fputs("\n", stdout);
+            isStatusOpen = false;
+        }
+        if (stream != stdout) {
+            fflush(stdout);
+        }
+
+        fputs(message.c_str(), stream);
+        fputs("\n", stream);
+    }
+
+    //appends a record as a line of json to the log file
+    void writeJSON(LogRecord& record, std::string& message) {
+        static const char* levelNames[] = { "info", "warning", "error", "status" };
+
+        file << "{\"timeMs\": " << record.time / 1000000.0
+            << ", \"level\": \"" << levelNames[record.level]
+            << "\", \"thread\": " << record.thread
+            << ", \"category\": \"" << record.category
+            << "\", \"message\": \"";
+
+        //escape the characters that would end the string
+        for (int i = 0; i < message.size(); i++) {
+            char c = message[i];
+            if (c == '"' || c == '\\') {
+                file << '\\' << c;
+            }
+            else if (c == '\n') {
+                file << "\\n";
+            }
+            else if ((unsigned char)c >= 0x20) {
+                file << c;
+            }
+        }
+
+        file << "\"}\n";
+    }
+};
+
+//LogRateLimiter class lets a message that is logged on every tick through at most once per interval
+//
+//the last suppressed message is not lost: once the caller stops logging it checks hasSuppressed and logs the final
+//value so that the console ends on the right number.
+class LogRateLimiter {
+public:
+    double interval; //minimum number of seconds between two messages
+    std::chrono::steady_clock::time_point lastTime; //time when the last message was let through
+    bool isSuppressed; //checks if a message was held back since the last one that went through
+
+    //constructor for the log rate limiter class
+    LogRateLimiter(double interval) {
+        this->interval = interval;
+        lastTime = std::chrono::steady_clock::now() - std::chrono::hours(1);
+        isSuppressed = false;
+    }
+
+    //checks if a message can be logged now
+    bool allow() {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - lastTime).count() < interval) {
+            isSuppressed = true;
+            return false;
+        }
+
+        lastTime = now;
+        isSuppressed = false;
+        return true;
+    }
+
+    //checks if the last message was held back, and lets the caller log it now
+    bool hasSuppressed() {
+        if (!isSuppressed) {
+            return false;
+        }
+
+        lastTime = std::chrono::steady_clock::now();
+        isSuppressed = false;
+        return true;
+    }
+};
+
+//shorthands for the logger shared by every thread
+#define LOG_INFO(...) Logger::instance().info(__VA_ARGS__)
+#define LOG_WARNING(...) Logger::instance().warning(__VA_ARGS__)
+#define LOG_ERROR(...) Logger::instance().error(__VA_ARGS__)
+#define LOG_STATUS(...) Logger::instance().status(__VA_ARGS__)
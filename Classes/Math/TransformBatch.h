@@ -0,0 +1,319 @@
+#pragma once
+
+//the simd kernels are only compiled for x86 targets, other targets use the scalar kernel
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRANSFORM_BATCH_X86
+#endif
+
+//gcc and clang only emit the newer instructions inside functions that ask for them, msvc always allows the intrinsics
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+//TransformBatch class composes the model and normal matrices of many objects at once
+//
+//every object is placed by a position, a unit quaternion, and a scale, and its model matrix is translate * scale * rotate,
+//the same order Model3D uses with euler angles. the normal matrix is the inverse transpose of the upper 3x3 of the model
+//matrix, which for scale * rotate is simply inverse(scale) * rotate. the sse4.1 and avx2 kernels compute 4 and 8
+//objects per iteration with the components of the objects spread across the lanes, and the best kernel the cpu
+//supports is picked at runtime.
+class TransformBatch {
+public:
+    //signature shared by every kernel
+    typedef void (*ComposeFunction)(const glm::vec3* positions, const glm::quat* orientations, const glm::vec3* scales, glm::mat4* models, glm::mat4* normals, int count);
+
+    //instruction sets that a kernel can use
+    enum Level {
+        SCALAR = 0,
+        SSE41 = 1,
+        AVX2 = 2
+    };
+
+    //returns the name of an instruction set level
+    static const char* levelName(int level) {
+        switch (level) {
+            case SSE41: return "SSE4.1";
+            case AVX2: return "AVX2";
+            default: return "Scalar";
+        }
+    }
+
+    //returns the highest level that both the cpu and the operating system support
+    static int detectLevel() {
+#ifdef TRANSFORM_BATCH_X86
+        unsigned int info[4];
+        cpuid(0, 0, info);
+        unsigned int maxLeaf = info[0];
+
+        cpuid(1, 0, info);
+        bool hasSSE41 = (info[2] >> 19) & 1;
+        bool hasOSXSAVE = (info[2] >> 27) & 1;
+        bool hasAVX = (info[2] >> 28) & 1;
+
+        bool hasAVX2 = false;
+        if (maxLeaf >= 7) {
+            cpuid(7, 0, info);
+            hasAVX2 = (info[1] >> 5) & 1;
+        }
+
+        //the operating system has to save the ymm registers on a context switch for avx to be usable
+        bool hasYMMState = hasOSXSAVE && hasAVX && (readXCR0() & 6) == 6;
+
+        if (hasAVX2 && hasYMMState) {
+            return AVX2;
+        }
+        if (hasSSE41) {
+            return SSE41;
+        }
+#endif
+        return SCALAR;
+    }
+
+    //returns the kernel of an instruction set level, falling back to the scalar kernel when it is not compiled in
+    static ComposeFunction kernel(int level) {
+#ifdef TRANSFORM_BATCH_X86
+        if (level == AVX2) {
+            return composeAVX2;
+        }
+        if (level == SSE41) {
+            return composeSSE41;
+        }
+#endif
+        return composeScalar;
+    }
+
+    //returns the level that compose runs with, detected the first time it is needed
+    static int activeLevel() {
+        static int level = detectLevel();
+        return level;
+    }
+
+    //composes the matrices of count objects with the fastest kernel the cpu supports
+    static void compose(const glm::vec3* positions, const glm::quat* orientations, const glm::vec3* scales, glm::mat4* models, glm::mat4* normals, int count) {
+        static ComposeFunction function = kernel(activeLevel());
+        function(positions, orientations, scales, models, normals, count);
+    }
+
+    //returns the quaternion of a rotation along the x, then y, then z axis in degrees (Model3D::theta)
+    static glm::quat fromEuler(glm::vec3 theta) {
+        return glm::angleAxis(glm::radians(theta.x), glm::vec3(1.0f, 0.0f, 0.0f))
+            * glm::angleAxis(glm::radians(theta.y), glm::vec3(0.0f, 1.0f, 0.0f))
+            * glm::angleAxis(glm::radians(theta.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+
+    //composes the matrices one object at a time
+    static void composeScalar(const glm::vec3* positions, const glm::quat* orientations, const glm::vec3* scales, glm::mat4* models, glm::mat4* normals, int count) {
+        for (int i = 0; i < count; i++) {
+            const glm::quat& q = orientations[i];
+            const glm::vec3& s = scales[i];
+
+            float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+            float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+            float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+            //rotation matrix by rows
+            float r[3][3] = {
+                { 1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy) },
+                { 2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx) },
+                { 2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy) }
+            };
+            float inverseScale[3] = { 1.0f / s.x, 1.0f / s.y, 1.0f / s.z };
+
+            //glm matrices are indexed by column first
+            glm::mat4& model = models[i];
+            glm::mat4& normal = normals[i];
+            for (int column = 0; column < 3; column++) {
+                for (int row = 0; row < 3; row++) {
+                    model[column][row] = s[row] * r[row][column];
+                    normal[column][row] = r[row][column] * inverseScale[row];
+                }
+                model[column][3] = 0.0f;
+                normal[column][3] = 0.0f;
+            }
+            model[3] = glm::vec4(positions[i], 1.0f);
+            normal[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+
+#ifdef TRANSFORM_BATCH_X86
+    //runs the cpuid instruction
+    static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int info[4]) {
+#if defined(_MSC_VER)
+        int registers[4];
+        __cpuidex(registers, leaf, subleaf);
+        for (int i = 0; i < 4; i++) {
+            info[i] = registers[i];
+        }
+#else
+        __cpuid_count(leaf, subleaf, info[0], info[1], info[2], info[3]);
+#endif
+    }
+
+    //reads the register that tells which register states the operating system saves
+    static unsigned long long readXCR0() {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((unsigned long long)edx << 32) | eax;
+#endif
+    }
+
+    //composes the matrices four objects at a time
+    TARGET_SSE41 static void composeSSE41(const glm::vec3* positions, const glm::quat* orientations, const glm::vec3* scales, glm::mat4* models, glm::mat4* normals, int count) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const glm::quat* q = orientations + i;
+            const glm::vec3* p = positions + i;
+            const glm::vec3* s = scales + i;
+
+            //spread the components of the four objects across the lanes
+            __m128 x = _mm_setr_ps(q[0].x, q[1].x, q[2].x, q[3].x);
+            __m128 y = _mm_setr_ps(q[0].y, q[1].y, q[2].y, q[3].y);
+            __m128 z = _mm_setr_ps(q[0].z, q[1].z, q[2].z, q[3].z);
+            __m128 w = _mm_setr_ps(q[0].w, q[1].w, q[2].w, q[3].w);
+            __m128 sx = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+            __m128 sy = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+            __m128 sz = _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z);
+
+            __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+            __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+            __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+            //rotation matrix by rows
+            __m128 r00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+            __m128 r01 = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+            __m128 r02 = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+            __m128 r10 = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+            __m128 r11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+            __m128 r12 = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+            __m128 r20 = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+            __m128 r21 = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+            __m128 r22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+
+            __m128 ix = _mm_div_ps(one, sx), iy = _mm_div_ps(one, sy), iz = _mm_div_ps(one, sz);
+
+            //columns of the model and normal matrices, one object per lane
+            __m128 model[4][4] = {
+                { _mm_mul_ps(sx, r00), _mm_mul_ps(sy, r10), _mm_mul_ps(sz, r20), zero },
+                { _mm_mul_ps(sx, r01), _mm_mul_ps(sy, r11), _mm_mul_ps(sz, r21), zero },
+                { _mm_mul_ps(sx, r02), _mm_mul_ps(sy, r12), _mm_mul_ps(sz, r22), zero },
+                { _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x), _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y), _mm_setr_ps(p[0].z, p[1].z, p[2].z, p[3].z), one }
+            };
+            __m128 normal[4][4] = {
+                { _mm_mul_ps(r00, ix), _mm_mul_ps(r10, iy), _mm_mul_ps(r20, iz), zero },
+                { _mm_mul_ps(r01, ix), _mm_mul_ps(r11, iy), _mm_mul_ps(r21, iz), zero },
+                { _mm_mul_ps(r02, ix), _mm_mul_ps(r12, iy), _mm_mul_ps(r22, iz), zero },
+                { zero, zero, zero, one }
+            };
+
+            //turn the lanes back into one column per object
+            for (int column = 0; column < 4; column++) {
+                _MM_TRANSPOSE4_PS(model[column][0], model[column][1], model[column][2], model[column][3]);
+                _MM_TRANSPOSE4_PS(normal[column][0], normal[column][1], normal[column][2], normal[column][3]);
+                for (int k = 0; k < 4; k++) {
+                    _mm_storeu_ps(&models[i + k][column][0], model[column][k]);
+                    _mm_storeu_ps(&normals[i + k][column][0], normal[column][k]);
+                }
+            }
+        }
+
+        //the objects that do not fill a whole iteration
+        composeScalar(positions + i, orientations + i, scales + i, models + i, normals + i, count - i);
+    }
+
+    //transposes the 4x4 blocks in the low and high halves of four avx registers
+    TARGET_AVX2 static void transpose4x4x2(__m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+        __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+        r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+        r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    //composes the matrices eight objects at a time
+    TARGET_AVX2 static void composeAVX2(const glm::vec3* positions, const glm::quat* orientations, const glm::vec3* scales, glm::mat4* models, glm::mat4* normals, int count) {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 two = _mm256_set1_ps(2.0f);
+        const __m256 zero = _mm256_setzero_ps();
+
+        //offsets of the same component in eight consecutive vec3 and quat elements
+        const __m256i vec3Index = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+        const __m256i quatIndex = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const float* q = (const float*)(orientations + i);
+            const float* p = (const float*)(positions + i);
+            const float* s = (const float*)(scales + i);
+
+            //gather the components of the eight objects across the lanes
+            __m256 x = _mm256_i32gather_ps(q + 0, quatIndex, 4);
+            __m256 y = _mm256_i32gather_ps(q + 1, quatIndex, 4);
+            __m256 z = _mm256_i32gather_ps(q + 2, quatIndex, 4);
+            __m256 w = _mm256_i32gather_ps(q + 3, quatIndex, 4);
+            __m256 sx = _mm256_i32gather_ps(s + 0, vec3Index, 4);
+            __m256 sy = _mm256_i32gather_ps(s + 1, vec3Index, 4);
+            __m256 sz = _mm256_i32gather_ps(s + 2, vec3Index, 4);
+
+            __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+            __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+            __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+            //rotation matrix by rows
+            __m256 r00 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)));
+            __m256 r01 = _mm256_mul_ps(two, _mm256_sub_ps(xy, wz));
+            __m256 r02 = _mm256_mul_ps(two, _mm256_add_ps(xz, wy));
+            __m256 r10 = _mm256_mul_ps(two, _mm256_add_ps(xy, wz));
+            __m256 r11 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)));
+            __m256 r12 = _mm256_mul_ps(two, _mm256_sub_ps(yz, wx));
+            __m256 r20 = _mm256_mul_ps(two, _mm256_sub_ps(xz, wy));
+            __m256 r21 = _mm256_mul_ps(two, _mm256_add_ps(yz, wx));
+            __m256 r22 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)));
+
+            __m256 ix = _mm256_div_ps(one, sx), iy = _mm256_div_ps(one, sy), iz = _mm256_div_ps(one, sz);
+
+            //columns of the model and normal matrices, one object per lane
+            __m256 model[4][4] = {
+                { _mm256_mul_ps(sx, r00), _mm256_mul_ps(sy, r10), _mm256_mul_ps(sz, r20), zero },
+                { _mm256_mul_ps(sx, r01), _mm256_mul_ps(sy, r11), _mm256_mul_ps(sz, r21), zero },
+                { _mm256_mul_ps(sx, r02), _mm256_mul_ps(sy, r12), _mm256_mul_ps(sz, r22), zero },
+                { _mm256_i32gather_ps(p + 0, vec3Index, 4), _mm256_i32gather_ps(p + 1, vec3Index, 4), _mm256_i32gather_ps(p + 2, vec3Index, 4), one }
+            };
+            __m256 normal[4][4] = {
+                { _mm256_mul_ps(r00, ix), _mm256_mul_ps(r10, iy), _mm256_mul_ps(r20, iz), zero },
+                { _mm256_mul_ps(r01, ix), _mm256_mul_ps(r11, iy), _mm256_mul_ps(r21, iz), zero },
+                { _mm256_mul_ps(r02, ix), _mm256_mul_ps(r12, iy), _mm256_mul_ps(r22, iz), zero },
+                { zero, zero, zero, one }
+            };
+
+            //turn the lanes back into one column per object, the low half holds objects 0-3 and the high half objects 4-7
+            for (int column = 0; column < 4; column++) {
+                transpose4x4x2(model[column][0], model[column][1], model[column][2], model[column][3]);
+                transpose4x4x2(normal[column][0], normal[column][1], normal[column][2], normal[column][3]);
+                for (int k = 0; k < 4; k++) {
+                    _mm_storeu_ps(&models[i + k][column][0], _mm256_castps256_ps128(model[column][k]));
+                    _mm_storeu_ps(&models[i + k + 4][column][0], _mm256_extractf128_ps(model[column][k], 1));
+                    _mm_storeu_ps(&normals[i + k][column][0], _mm256_castps256_ps128(normal[column][k]));
+                    _mm_storeu_ps(&normals[i + k + 4][column][0], _mm256_extractf128_ps(normal[column][k], 1));
+                }
+            }
+        }
+
+        //the objects that do not fill a whole iteration
+        composeScalar(positions + i, orientations + i, scales + i, models + i, normals + i, count - i);
+    }
+#endif
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+//TransformBenchmark class checks every transform kernel against glm and measures how many objects each one composes per second on one core
+class TransformBenchmark {
+public:
+    static const int OBJECT_COUNT = 1 << 14; //number of objects composed in every pass
+    static const int MIN_PASSES = 50; //minimum number of timed passes of every kernel
+
+    std::vector<glm::vec3> positions; //position of every object
+    std::vector<glm::vec3> angles; //euler rotation of every object in degrees
+    std::vector<glm::quat> orientations; //the same rotations as quaternions
+    std::vector<glm::vec3> scales; //non uniform scale of every object
+    std::vector<glm::mat4> models; //model matrices written by the kernels
+    std::vector<glm::mat4> normals; //normal matrices written by the kernels
+    std::vector<glm::mat4> referenceModels; //model matrices built with glm the way Model3D does
+    std::vector<glm::mat3> referenceNormals; //normal matrices built with glm by inverting the model matrices
+
+    //constructor for the transform benchmark class which fills the objects with the same values in every run
+    TransformBenchmark() {
+        positions.resize(OBJECT_COUNT);
+        angles.resize(OBJECT_COUNT);
+        orientations.resize(OBJECT_COUNT);
+        scales.resize(OBJECT_COUNT);
+        models.resize(OBJECT_COUNT);
+        normals.resize(OBJECT_COUNT);
+        referenceModels.resize(OBJECT_COUNT);
+        referenceNormals.resize(OBJECT_COUNT);
+
+        unsigned int seed = 54321;
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            for (int j = 0; j < 3; j++) {
+                positions[i][j] = random(seed) * 200.0f - 100.0f;
+                angles[i][j] = random(seed) * 360.0f;
+                scales[i][j] = 0.05f + random(seed) * 2.0f;
+            }
+            orientations[i] = TransformBatch::fromEuler(angles[i]);
+
+            //compose the reference the same way as Model3D::getTransformationMatrix
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), positions[i]);
+            model = glm::scale(model, scales[i]);
+            model = glm::rotate(model, glm::radians(angles[i].x), glm::vec3(1.0f, 0.0f, 0.0f));
+            model = glm::rotate(model, glm::radians(angles[i].y), glm::vec3(0.0f, 1.0f, 0.0f));
+            model = glm::rotate(model, glm::radians(angles[i].z), glm::vec3(0.0f, 0.0f, 1.0f));
+            referenceModels[i] = model;
+            referenceNormals[i] = glm::transpose(glm::inverse(glm::mat3(model)));
+        }
+    }
+
+    //returns a number between 0 and 1 from a linear congruential generator
+    static float random(unsigned int& seed) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / (float)(1 << 24);
+    }
+
+    //returns the largest difference between the matrices of the last pass and the glm reference, relative to the size of the values
+    float maxError() {
+        float error = 0.0f;
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            for (int column = 0; column < 4; column++) {
+                for (int row = 0; row < 4; row++) {
+                    float expected = referenceModels[i][column][row];
+                    error = glm::max(error, glm::abs(models[i][column][row] - expected) / glm::max(1.0f, glm::abs(expected)));
+                }
+            }
+            for (int column = 0; column < 3; column++) {
+                for (int row = 0; row < 3; row++) {
+                    float expected = referenceNormals[i][column][row];
+                    error = glm::max(error, glm::abs(normals[i][column][row] - expected) / glm::max(1.0f, glm::abs(expected)));
+                }
+            }
+        }
+        return error;
+    }
+
+    //returns the median number of objects composed per second by a kernel
+    double measure(TransformBatch::ComposeFunction function) {
+        std::vector<double> rates;
+        for (int pass = 0; pass <= MIN_PASSES; pass++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            function(positions.data(), orientations.data(), scales.data(), models.data(), normals.data(), OBJECT_COUNT);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            //the first pass warms up the caches
+            if (pass > 0) {
+                rates.push_back(OBJECT_COUNT / glm::max(seconds, 1e-9));
+            }
+        }
+
+        std::sort(rates.begin(), rates.end());
+        return rates[rates.size() / 2];
+    }
+
+    //times the glm path that Model3D used before, including the inverse that the shaders did per vertex
+    static void composeGLM(const glm::vec3* positions, const glm::quat* orientations, const glm::vec3* scales, glm::mat4* models, glm::mat4* normals, int count) {
+        for (int i = 0; i < count; i++) {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), positions[i]);
+            model = glm::scale(model, scales[i]);
+            model *= glm::mat4_cast(orientations[i]);
+            models[i] = model;
+            normals[i] = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+        }
+    }
+
+    //prints the throughput and the error of the glm path and of every kernel the cpu supports
+    void run() {
+        int supported = TransformBatch::detectLevel();
+        std::cout << "[TRANSFORMS] " << OBJECT_COUNT << " objects per pass, single thread, cpu supports up to " << TransformBatch::levelName(supported) << "\n";
+        std::cout << "kernel      Mobjects/s   speedup   max error\n";
+
+        double baseline = measure(composeGLM);
+        std::cout << std::left << std::setw(10) << "glm" << std::right
+            << std::setw(12) << std::fixed << std::setprecision(2) << baseline / 1e6
+            << std::setw(10) << 1.0
+            << std::setw(12) << std::scientific << std::setprecision(2) << maxError() << "\n";
+
+        for (int level = TransformBatch::SCALAR; level <= supported; level++) {
+            double rate = measure(TransformBatch::kernel(level));
+            std::cout << std::left << std::setw(10) << TransformBatch::levelName(level) << std::right
+                << std::setw(12) << std::fixed << std::setprecision(2) << rate / 1e6
+                << std::setw(10) << rate / baseline
+                << std::setw(12) << std::scientific << std::setprecision(2) << maxError() << "\n";
+        }
+
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+//LinearAllocator class hands out memory by moving an offset forward through a block and frees all of it at once
+//
+//allocating is a pointer bump and nothing is freed one by one, so it suits data that lives until a known point: the
+//scratch data of a loader until its asset is finished, or the draw packets of a snapshot until the snapshot is built
+//again. when the block is full another one is chained after it, and reset() replaces the chain with a single block of
+//the size that was needed, so after the first few uses the allocator does not call the heap at all. an allocator is
+//only used by one thread at a time.
+class LinearAllocator {
+public:
+    static const int SCRATCH_BLOCK_SIZE = 1024 * 1024; //starting size of the scratch allocator of a thread
+
+    //stores a block of memory that allocations are placed in
+    struct Block {
+        unsigned char* memory; //start of the block
+        size_t size; //number of bytes in the block
+    };
+
+    std::vector<Block> blocks; //blocks in the order they were added, allocations are placed in the last one
+    size_t offset; //number of bytes used in the last block
+    size_t usedBytes; //number of bytes handed out since the last reset, including the blocks before the last one
+    int scopeDepth; //number of scratch scopes that are open on the allocator
+
+    //returns the scratch allocator of the calling thread, which is kept until the thread exits
+    static LinearAllocator& scratch() {
+        thread_local LinearAllocator allocator(SCRATCH_BLOCK_SIZE);
+        return allocator;
+    }
+
+    //constructor for the linear allocator class
+    LinearAllocator(size_t blockSize) {
+        offset = 0;
+        usedBytes = 0;
+        scopeDepth = 0;
+        addBlock(blockSize);
+    }
+
+    //destructor for the linear allocator class, everything that was allocated becomes invalid
+    ~LinearAllocator() {
+        for (int i = 0; i < blocks.size(); i++) {
+            free(blocks[i].memory);
+        }
+    }
+
+    //appends an empty block of at least the given size
+    void addBlock(size_t size) {
+        Block block;
+        block.size = glm::max(size, (size_t)64);
+        block.memory = (unsigned char*)malloc(block.size);
+        blocks.push_back(block);
+        offset = 0;
+    }
+
+    //returns uninitialized memory of the given size, the alignment must be a power of two
+    void* allocate(size_t bytes, size_t alignment) {
+        Block& block = blocks.back();
+        size_t start = (offset + alignment - 1) & ~(alignment - 1);
+
+        //start a new block that is at least twice as large as the last one
+        if (start + bytes > block.size) {
+            addBlock(glm::max(block.size * 2, bytes + alignment));
+            return allocate(bytes, alignment);
+        }
+
+        usedBytes += start + bytes - offset;
+        offset = start + bytes;
+        return blocks.back().memory + start;
+    }
+
+    //returns uninitialized memory for an array of objects
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return (T*)allocate(sizeof(T) * count, alignof(T));
+    }
+
+    //gives memory back if it was the newest allocation, which lets a growing vector reuse its old space
+    void deallocate(void* memory, size_t bytes) {
+        unsigned char* end = (unsigned char*)memory + bytes;
+        if (end == blocks.back().memory + offset) {
+            offset -= bytes;
+            usedBytes -= bytes;
+        }
+    }
+
+    //frees every allocation at once, merging the blocks into one so that the same amount fits without a new block
+    void reset() {
+        if (blocks.size() > 1) {
+            size_t size = 0;
+            for (int i = 0; i < blocks.size(); i++) {
+                size += blocks[i].size;
+                free(blocks[i].memory);
+            }
+            blocks.clear();
+            addBlock(size);
+        }
+
+        offset = 0;
+        usedBytes = 0;
+    }
+};
+
+//ArenaAllocator class lets standard containers place their elements in a linear allocator
+//
+//freeing does nothing unless it was the newest allocation, so a container should reserve its size up front where it is
+//known. the container must not be used after the linear allocator is reset.
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    LinearAllocator* arena; //allocator the elements are placed in
+
+    //constructor for the arena allocator class
+    ArenaAllocator(LinearAllocator* arena) {
+        this->arena = arena;
+    }
+
+    //converts an allocator of another element type, containers use this to allocate their internal nodes
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) {
+        arena = other.arena;
+    }
+
+    //returns memory for the given number of elements
+    T* allocate(size_t count) {
+        return arena->allocateArray<T>(count);
+    }
+
+    //gives the memory of the elements back if it was the newest allocation
+    void deallocate(T* memory, size_t count) {
+        arena->deallocate(memory, sizeof(T) * count);
+    }
+};
+
+//checks if two arena allocators place their elements in the same linear allocator
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena != b.arena;
+}
+
+//vector whose elements are placed in a linear allocator
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+//ScratchScope class resets the scratch allocator of the calling thread when the outermost scope ends
+//
+//a loader opens a scope around the work of one asset, so the temporary arrays it places in the scratch allocator are
+//freed together once the asset is finished. nothing allocated in the scope may be used after it ends.
+class ScratchScope {
+public:
+    LinearAllocator& allocator; //scratch allocator of the thread that opened the scope
+
+    //constructor for the scratch scope class
+    ScratchScope() : allocator(LinearAllocator::scratch()) {
+        allocator.scopeDepth++;
+    }
+
+    //returns an empty vector whose elements are placed in the scratch allocator
+    template <typename T>
+    ArenaVector<T> makeVector() {
+        return ArenaVector<T>(ArenaAllocator<T>(&allocator));
+    }
+
+    //destructor for the scratch scope class
+    ~ScratchScope() {
+        allocator.scopeDepth--;
+        if (allocator.scopeDepth == 0) {
+            allocator.reset();
+        }
+    }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+//PoolAllocator class keeps objects of one type in chunks and reuses the slots of destroyed objects
+//
+//objects that are created and destroyed at a high rate, like the jobs of every frame, would otherwise call the heap
+//each time. a destroyed object puts its slot on a free list and the next object is built in it, so once the pool has
+//grown to the largest number of objects alive at once it does not allocate anymore. chunks are only freed when the
+//pool is destroyed. objects can be created and destroyed from any thread.
+template <typename T>
+class PoolAllocator {
+public:
+    static const int OBJECTS_PER_CHUNK = 256; //number of objects a chunk has room for
+
+    //slot of a chunk, which holds an object while it is alive and the next free slot otherwise
+    union Slot {
+        Slot* next; //next slot of the free list
+        alignas(T) unsigned char object[sizeof(T)]; //storage of the object
+    };
+
+    std::vector<Slot*> chunks; //chunks that were allocated
+    Slot* freeSlots; //first slot of the free list, NULL if every slot is used
+    std::mutex mutex; //guards the free list
+
+    //constructor for the pool allocator class
+    PoolAllocator() {
+        freeSlots = NULL;
+    }
+
+    //destructor for the pool allocator class, every object must have been destroyed
+    ~PoolAllocator() {
+        for (int i = 0; i < chunks.size(); i++) {
+            delete[] chunks[i];
+        }
+    }
+
+    //builds an object in a free slot
+    T* create() {
+        Slot* slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!freeSlots) {
+                addChunk();
+            }
+
+            slot = freeSlots;
+            freeSlots = slot->next;
+        }
+        return new (slot->object) T();
+    }
+
+    //destroys an object and puts its slot back on the free list
+    void destroy(T* object) {
+        object->~T();
+
+        Slot* slot = (Slot*)object;
+        std::lock_guard<std::mutex> lock(mutex);
+        slot->next = freeSlots;
+        freeSlots = slot;
+    }
+
+    //allocates a chunk and puts its slots on the free list, called with the mutex locked
+    void addChunk() {
+        Slot* chunk = new Slot[OBJECTS_PER_CHUNK];
+        chunks.push_back(chunk);
+
+        for (int i = OBJECTS_PER_CHUNK - 1; i >= 0; i--) {
+            chunk[i].next = freeSlots;
+            freeSlots = &chunk[i];
+        }
+    }
+};
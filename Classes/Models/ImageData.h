@@ -0,0 +1,78 @@
+#pragma once
+
+//ImageData class stores the pixels of an image file that was decoded on the cpu and still has to be uploaded to the gpu
+class ImageData {
+public:
+    std::string path; //file the image was decoded from
+    std::string name; //name of the sampler that the texture is bound to
+    unsigned char* bytes; //decoded pixels, NULL if the file could not be read
+    int width, height, channels; //size and number of color channels of the image
+    StagingBlock staging; //copy of the pixels in an upload ring, its size is 0 if the pixels are read from bytes
+
+    //constructor for the image data class
+    ImageData() {
+        bytes = NULL;
+        width = height = channels = 0;
+    }
+
+    //decodes an image file, this does not call opengl so it can run on any thread
+    void decode(std::string path, bool isFlipped) {
+        this->path = path;
+
+        //the flip setting of the calling thread is used so that threads do not change it for each other
+        stbi_set_flip_vertically_on_load_thread(isFlipped);
+        bytes = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        if (bytes == NULL) {
+            LOG_WARNING("TEXTURE", "[TEXTURE] Unable to read {}", path);
+        }
+    }
+
+    //moves the decoded pixels into a block of an upload ring so that the upload does not copy them on the thread that
+    //owns the context, they stay in bytes if the ring has no room. this can run on any thread
+    void stage(UploadRing* ring) {
+        if (bytes == NULL || ring == NULL) {
+            return;
+        }
+
+        long long size = (long long)width * height * channels;
+        if (!ring->allocate(size, staging, std::chrono::milliseconds(0))) {
+            return;
+        }
+
+        std::copy(bytes, bytes + size, staging.getData());
+        stbi_image_free(bytes);
+        bytes = NULL;
+    }
+
+    //checks if the image was decoded
+    bool hasPixels() {
+        return bytes != NULL || staging.size > 0;
+    }
+
+    //binds the source of the pixels and returns the pointer that is passed to the upload call
+    const void* bindPixels() {
+        if (staging.size > 0) {
+            return staging.bind();
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return bytes;
+    }
+
+    //frees the decoded pixels once they have been uploaded, a staged block is freed by the ring after the gpu read it
+    void release(UploadRing* ring) {
+        if (staging.size > 0 && ring) {
+            ring->submit(staging);
+        }
+        staging = StagingBlock();
+        release();
+    }
+
+    //frees the decoded pixels
+    void release() {
+        if (bytes) {
+            stbi_image_free(bytes);
+            bytes = NULL;
+        }
+    }
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+//Impostor class stores views of a mesh rendered from around it, which are drawn on a single quad once the mesh is small on the screen
+//
+//the views are taken from the points of a GRID_SIZE x GRID_SIZE grid that is folded onto the sphere around the mesh
+//with the octahedral mapping, so neighbouring cells of the grid are neighbouring directions. every view is an
+//orthographic image of the bounding sphere placed in its cell of two atlases: the color with the coverage in alpha,
+//and the object space normal with the depth from the front of the sphere in alpha. the whole sphere is covered
+//instead of the upper half since the camera looks at the fish from below as often as from above.
+//
+//a quad facing the camera is drawn in place of the mesh and blends the three views closest to the direction of the
+//camera. each view is shifted along the ray of the pixel by the depth it stored (parallax correction), so the views
+//line up and the blend does not look like three images on top of each other.
+class Impostor {
+public:
+    static const int GRID_SIZE = 8; //number of views along each side of the grid
+    static const int FRAME_SIZE = 128; //width and height of a view in the atlases
+    static const int ATLAS_SIZE = GRID_SIZE * FRAME_SIZE; //width and height of the atlases
+    static const int MIP_LEVELS = 3; //mipmaps below the full size, a view of FRAME_SIZE >> MIP_LEVELS pixels still has its own texels
+
+    GLuint albedoTexture; //color (rgb) and coverage (a) of every view
+    GLuint normalDepthTexture; //object space normal (rgb) and depth (a) of every view
+    glm::vec3 boundsCenter; //center of the sphere the views were taken of, in object space
+    float boundsRadius; //radius of the sphere the views were taken of
+    int allocation; //id of the atlases in the residency manager
+
+    //constructor for the impostor class
+    Impostor(glm::vec3 boundsCenter, float boundsRadius) {
+        this->boundsCenter = boundsCenter;
+        this->boundsRadius = boundsRadius;
+        albedoTexture = 0;
+        normalDepthTexture = 0;
+        allocation = ResidencyManager::NO_ALLOCATION;
+    }
+
+    //destructor for the impostor class
+    ~Impostor() {
+        glDeleteTextures(1, &albedoTexture);
+        glDeleteTextures(1, &normalDepthTexture);
+        ResidencyManager::instance().release(allocation);
+    }
+
+    //maps a direction to a point of the [-1, 1] square, the upper half of the sphere is the diamond in the middle
+    //and the lower half is folded over the corners
+    static glm::vec2 encodeOctahedral(glm::vec3 direction) {
+        direction /= glm::abs(direction.x) + glm::abs(direction.y) + glm::abs(direction.z);
+        glm::vec2 point(direction.x, direction.z);
+        if (direction.y < 0.0f) {
+            glm::vec2 sign(point.x >= 0.0f ? 1.0f : -1.0f, point.y >= 0.0f ? 1.0f : -1.0f);
+            point = (1.0f - glm::abs(glm::vec2(point.y, point.x))) * sign;
+        }
+        return point;
+    }
+
+    //maps a point of the [-1, 1] square back to its direction
+    static glm::vec3 decodeOctahedral(glm::vec2 point) {
+        glm::vec3 direction(point.x, 1.0f - glm::abs(point.x) - glm::abs(point.y), point.y);
+        if (direction.y < 0.0f) {
+            glm::vec2 sign(direction.x >= 0.0f ? 1.0f : -1.0f, direction.z >= 0.0f ? 1.0f : -1.0f);
+            glm::vec2 folded = (1.0f - glm::abs(glm::vec2(direction.z, direction.x))) * sign;
+            direction.x = folded.x;
+            direction.z = folded.y;
+        }
+        return glm::normalize(direction);
+    }
+
+    //returns the direction a view of the grid was taken from
+    static glm::vec3 frameDirection(int x, int y) {
+        glm::vec2 point = glm::vec2(x, y) / (float)(GRID_SIZE - 1) * 2.0f - 1.0f;
+        return decodeOctahedral(point);
+    }
+
+    //returns the up vector of a view, which the baker and the shader must agree on
+    static glm::vec3 frameUp(glm::vec3 direction) {
+        return glm::abs(direction.y) > 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+
+    //finds the three views around a direction and their blend weights, which add up to 1
+    //
+    //the direction is placed in a cell of the grid and the cell is split along its diagonal, so the views are the
+    //corners of the triangle it falls in and the weights are its barycentric coordinates
+    static void selectFrames(glm::vec3 direction, glm::ivec2 frames[3], glm::vec3& weights) {
+        glm::vec2 grid = (encodeOctahedral(direction) * 0.5f + 0.5f) * (float)(GRID_SIZE - 1);
+        glm::ivec2 cell = glm::clamp(glm::ivec2(glm::floor(grid)), glm::ivec2(0), glm::ivec2(GRID_SIZE - 2));
+        glm::vec2 fraction = glm::clamp(grid - glm::vec2(cell), 0.0f, 1.0f);
+
+        if (fraction.x + fraction.y < 1.0f) {
+            frames[0] = cell;
+            frames[1] = cell + glm::ivec2(1, 0);
+            frames[2] = cell + glm::ivec2(0, 1);
+            weights = glm::vec3(1.0f - fraction.x - fraction.y, fraction.x, fraction.y);
+        }
+        else {
+            frames[0] = cell + glm::ivec2(1, 1);
+            frames[1] = cell + glm::ivec2(0, 1);
+            frames[2] = cell + glm::ivec2(1, 0);
+            weights = glm::vec3(fraction.x + fraction.y - 1.0f, 1.0f - fraction.x, 1.0f - fraction.y);
+        }
+    }
+
+    //binds the atlases and sets the uniforms that place the quad and pick the views for a camera position in world space
+    void bind(Shader& shader, glm::mat4 transform, glm::vec3 cameraPosition) {
+        //the views are picked from the direction of the camera as seen by the mesh
+        glm::vec3 camera = glm::vec3(glm::inverse(transform) * glm::vec4(cameraPosition, 1.0f));
+        glm::vec3 localCamera = (camera - boundsCenter) / boundsRadius;
+
+        glm::ivec2 frames[3];
+        glm::vec3 weights;
+        selectFrames(glm::normalize(localCamera), frames, weights);
+
+        glm::vec3 directions[3];
+        glm::vec2 cells[3];
+        for (int i = 0; i < 3; i++) {
+            directions[i] = frameDirection(frames[i].x, frames[i].y);
+            cells[i] = glm::vec2(frames[i]);
+        }
+
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, albedoTexture);
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, normalDepthTexture);
+        glUniform1i(glGetUniformLocation(shader.shaderProgram, "albedoAtlas"), 1);
+        glUniform1i(glGetUniformLocation(shader.shaderProgram, "normalDepthAtlas"), 2);
+
+        glUniform3fv(glGetUniformLocation(shader.shaderProgram, "boundsCenter"), 1, glm::value_ptr(boundsCenter));
+        glUniform1f(glGetUniformLocation(shader.shaderProgram, "boundsRadius"), boundsRadius);
+        glUniform3fv(glGetUniformLocation(shader.shaderProgram, "localCamera"), 1, glm::value_ptr(localCamera));
+        glUniform3fv(glGetUniformLocation(shader.shaderProgram, "frameDirections"), 3, glm::value_ptr(directions[0]));
+        glUniform2fv(glGetUniformLocation(shader.shaderProgram, "frameCells"), 3, glm::value_ptr(cells[0]));
+        glUniform3fv(glGetUniformLocation(shader.shaderProgram, "frameWeights"), 1, glm::value_ptr(weights));
+        glUniform1f(glGetUniformLocation(shader.shaderProgram, "gridSize"), (float)GRID_SIZE);
+        glUniform1f(glGetUniformLocation(shader.shaderProgram, "frameSize"), (float)FRAME_SIZE);
+    }
+};
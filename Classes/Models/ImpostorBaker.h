@@ -0,0 +1,139 @@
+#pragma once
+
+//ImpostorBaker class renders the views of an impostor into its atlases
+//
+//every view draws the mesh once with an orthographic camera that fits the bounding sphere, into the cell of the
+//atlases that belongs to its direction. the mesh is baked when it arrives, on the thread that owns the context, so
+//only meshes with at least MIN_VERTEX_COUNT vertices get an impostor: for a smaller mesh the quad saves little and
+//the atlases would cost more memory than the mesh.
+class ImpostorBaker {
+public:
+    static const int MIN_VERTEX_COUNT = 4000; //smallest mesh that gets an impostor
+
+    Shader* shader; //draws the color, normal, and depth of a view
+    GLuint FBO, depthRBO; //framebuffer the views are drawn in and its depth attachment
+
+    //constructor for the impostor baker class, must be called on the thread that owns the context
+    ImpostorBaker(ProgramCache* cache) {
+        shader = new Shader("Shaders/impostor_bake.vert", "Shaders/impostor_bake.frag", cache);
+
+        glGenFramebuffers(1, &FBO);
+        glGenRenderbuffers(1, &depthRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, Impostor::ATLAS_SIZE, Impostor::ATLAS_SIZE);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    }
+
+    //destructor for the impostor baker class
+    ~ImpostorBaker() {
+        shader->destroy();
+        delete shader;
+        glDeleteRenderbuffers(1, &depthRBO);
+        glDeleteFramebuffers(1, &FBO);
+    }
+
+    //checks if a model is large enough to get an impostor
+    bool isWorthBaking(Model3D& model) {
+        return model.VAO != 0 && model.attribCount > 0 && model.getVertexCount() >= MIN_VERTEX_COUNT && model.boundsRadius > 0.0f;
+    }
+
+    //creates an atlas texture with its mipmap levels
+    static GLuint createAtlas() {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, Impostor::ATLAS_SIZE, Impostor::ATLAS_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        //deeper levels would mix the neighbouring views
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, Impostor::MIP_LEVELS);
+        return texture;
+    }
+
+    //renders the views of a model whose buffers exist and returns its impostor, must be called on the thread that owns the context
+    Impostor* bake(Model3D& model) {
+        PROFILE_ZONE("ImpostorBaker::bake");
+
+        Impostor* impostor = new Impostor(model.boundsCenter, model.boundsRadius);
+        impostor->albedoTexture = createAtlas();
+        impostor->normalDepthTexture = createAtlas();
+
+        //the frame that is being drawn renders to another framebuffer, which is bound again afterwards
+        GLint previousFramebuffer = 0;
+        GLint previousViewport[4];
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, previousViewport);
+        GLboolean isBlending = glIsEnabled(GL_BLEND);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, impostor->albedoTexture, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, impostor->normalDepthTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+        GLenum attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, attachments);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            LOG_ERROR("IMPOSTOR", "[IMPOSTOR] The framebuffer of {} is incomplete", model.name);
+        }
+
+        //uncovered texels are transparent and as deep as the back of the sphere
+        GLfloat clearAlbedo[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        GLfloat clearNormalDepth[4] = { 0.5f, 0.5f, 0.5f, 1.0f };
+        GLfloat clearDepth = 1.0f;
+        glViewport(0, 0, Impostor::ATLAS_SIZE, Impostor::ATLAS_SIZE);
+        glClearBufferfv(GL_COLOR, 0, clearAlbedo);
+        glClearBufferfv(GL_COLOR, 1, clearNormalDepth);
+        glClearBufferfv(GL_DEPTH, 0, &clearDepth);
+        glDisable(GL_BLEND);
+
+        shader->useProgram();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, model.albedoLayer.texture);
+        glUniform1i(glGetUniformLocation(shader->shaderProgram, "textureArray"), 0);
+        glUniform1i(glGetUniformLocation(shader->shaderProgram, "textureLayer"), model.albedoLayer.layer);
+
+        //the mesh is drawn inside the unit sphere, so the cameras sit at a distance of 2 and see from 1 to 3
+        glm::mat4 toUnitSphere = glm::translate(glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / model.boundsRadius)), -model.boundsCenter);
+        glm::mat4 projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 3.0f);
+        glUniformMatrix4fv(glGetUniformLocation(shader->shaderProgram, "transform"), 1, GL_FALSE, glm::value_ptr(toUnitSphere));
+        glUniformMatrix4fv(glGetUniformLocation(shader->shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+        unsigned int viewLoc = glGetUniformLocation(shader->shaderProgram, "view");
+
+        glBindVertexArray(model.VAO);
+        for (int y = 0; y < Impostor::GRID_SIZE; y++) {
+            for (int x = 0; x < Impostor::GRID_SIZE; x++) {
+                glm::vec3 direction = Impostor::frameDirection(x, y);
+                glm::mat4 view = glm::lookAt(direction * 2.0f, glm::vec3(0.0f), Impostor::frameUp(direction));
+                glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+
+                glViewport(x * Impostor::FRAME_SIZE, y * Impostor::FRAME_SIZE, Impostor::FRAME_SIZE, Impostor::FRAME_SIZE);
+                glDrawArrays(GL_TRIANGLES, 0, model.getVertexCount());
+            }
+        }
+        glBindVertexArray(0);
+
+        glBindTexture(GL_TEXTURE_2D, impostor->albedoTexture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, impostor->normalDepthTexture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+        glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+        if (isBlending) {
+            glEnable(GL_BLEND);
+        }
+
+        long long bytes = 0;
+        for (int level = 0; level <= Impostor::MIP_LEVELS; level++) {
+            int size = Impostor::ATLAS_SIZE >> level;
+            bytes += (long long)size * size * 4 * 2;
+        }
+        impostor->allocation = ResidencyManager::instance().track(ResidencyManager::TEXTURE, model.name + " impostor", bytes);
+
+        return impostor;
+    }
+};
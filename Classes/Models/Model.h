@@ -10,32 +10,27 @@ public:
 
     //load the vertex attributes from the obj file
     void loadObject(std::string path) override {
-        std::vector<tinyobj::shape_t> shapes; //stores the shapes of the mesh
-        std::vector<tinyobj::material_t> materials; //stores shapes of the mesh
-        std::string warning, error; //stores warning or error messages
-        tinyobj::attrib_t attributes; //stores mesh attributes
+        PROFILE_ZONE("Model::loadObject");
+
+        //the parsed file is only needed until the vertex data is built, so it is kept in scratch memory
+        ScratchScope scope;
+        ObjMesh mesh(scope);
 
         //loads the mesh
-        bool success = tinyobj::LoadObj(
-            &attributes,
-            &shapes,
-            &materials,
-            &warning,
-            &error,
-            path.c_str()
-        );
+        bool success = mesh.read(path);
 
         //determine if the obj file contains vertices, normals, and texture coordinates
-        bool hasVertices = attributes.vertices.size() != 0;
-        bool hasNormals = attributes.normals.size() != 0;
-        bool hasTexCoords = attributes.texcoords.size() != 0;
+        bool hasVertices = mesh.vertices.size() != 0;
+        bool hasNormals = mesh.normals.size() != 0;
+        bool hasTexCoords = mesh.texcoords.size() != 0;
 
         //calculate for the total number of attributes for a single vertex
         attribCount = hasVertices * 3 + hasNormals * 3 + hasTexCoords * 2;
+        fullVertexData.reserve(mesh.indices.size() * attribCount);
 
         //process the vertex attributes
-        for (int i = 0; i < shapes[0].mesh.indices.size(); i++) {
-            tinyobj::index_t vData = shapes[0].mesh.indices[i];
+        for (int i = 0; i < mesh.indices.size(); i++) {
+            tinyobj::index_t vData = mesh.indices[i];
 
             //process the vertices if it exists
             if (hasVertices) {
@@ -43,17 +38,17 @@ public:
 
                 //vertex x
                 fullVertexData.push_back(
-                    attributes.vertices[vertexIndex]
+                    mesh.vertices[vertexIndex]
                 );
 
                 //vertex y
                 fullVertexData.push_back(
-                    attributes.vertices[vertexIndex + 1]
+                    mesh.vertices[vertexIndex + 1]
                 );
 
                 //vertex z
                 fullVertexData.push_back(
-                    attributes.vertices[vertexIndex + 2]
+                    mesh.vertices[vertexIndex + 2]
                 );
             }
 
@@ -63,17 +58,17 @@ public:
 
                 //normal x
                 fullVertexData.push_back(
-                    attributes.normals[normalIndex]
+                    mesh.normals[normalIndex]
                 );
 
                 //normal y
                 fullVertexData.push_back(
-                    attributes.normals[normalIndex + 1]
+                    mesh.normals[normalIndex + 1]
                 );
 
                 //normal z
                 fullVertexData.push_back(
-                    attributes.normals[normalIndex + 2]
+                    mesh.normals[normalIndex + 2]
                 );
             }
 
@@ -82,85 +77,20 @@ public:
                 int uvIndex = vData.texcoord_index * 2; //2 - uv
                 //texture u
                 fullVertexData.push_back(
-                    attributes.texcoords[uvIndex]
+                    mesh.texcoords[uvIndex]
                 );
 
                 //texture v
                 fullVertexData.push_back(
-                    attributes.texcoords[uvIndex + 1]
+                    mesh.texcoords[uvIndex + 1]
                 );
             }
         }
 
-        //generate id for the vao and vbo;
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-
-        //binds the vao of the current model
-        glBindVertexArray(VAO);
-
-        //binds the vbo of the current model
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-        //assign data to the vbo
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            sizeof(GL_FLOAT) * fullVertexData.size(),
-            fullVertexData.data(),
-            GL_STATIC_DRAW
-        );
-
-        int attribOffset = 0; //determines the offset of the vertex attribute
-
-        if (hasVertices) {
-            GLintptr vertPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the vertex
-            //assign vertex data to the vao
-            glVertexAttribPointer(
-                0,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)vertPtr
-            );
-            glEnableVertexAttribArray(0); //enable vertex attribute 0
-
-            attribOffset += 3;//update the offset by 3 (xyz)
-        }
-
-        if (hasNormals) {
-            GLintptr normPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the normal
-            //assign normal data to the vao
-            glVertexAttribPointer(
-                1,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)normPtr
-            );
-            glEnableVertexAttribArray(1); //enable vertex attribute 1
-
-            attribOffset += 3; //update the offset by 3 (xyz)
-        }
-
-        if (hasTexCoords) {
-            GLintptr uvPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the texture
-            //assign texture data to the vao
-            glVertexAttribPointer(
-                2,
-                2, //uv
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)uvPtr
-            );
-            glEnableVertexAttribArray(2); //enable vertex attribute 2
-
-            attribOffset += 2; //update the offset by 2 (uv)
-        }
+        //store the layout of the vertex attributes so that the buffers can be created on the opengl thread
+        attributeSizes = { hasVertices * 3, hasNormals * 3, hasTexCoords * 2 };
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0); //finish modifying the buffer
-        glBindVertexArray(0); //finish modifying the vao
+        //compute the bounding sphere used for visibility tests
+        computeBounds();
     }
 }; 
\ No newline at end of file
@@ -1,4 +1,13 @@
+#include "ResidencyManager.h"
+#include "ProgramCache.h"
+#include "ShaderPreprocessor.h"
 #include "Shader.h"
+#include "ShaderVariants.h"
+#include "UploadRing.h"
+#include "ImageData.h"
+#include "TextureArrayManager.h"
+#include "VertexAnimation.h"
+#include "Impostor.h"
 #pragma once
 
 //Model3D class stores the transformation properties of a model
@@ -6,41 +15,247 @@ class Model3D {
 public:
     std::vector<GLfloat> fullVertexData; //contains the vertex data (vertex, normal, and texture coordinates)
     int attribCount; //the number of attributes in a set of vertex in fullVertexData
+    std::vector<int> attributeSizes; //number of floats of the vertex attribute at each location, 0 if the mesh does not have it
     GLuint VAO, VBO; //vao and vbo id of the model
     std::vector<GLuint> textures; //stores the list of textures used by the model
     std::vector<GLuint > textureAddresses; //stores the list of texture addresses in the shader
+    std::vector<ImageData> pendingTextures; //textures that were decoded but not uploaded yet
+    std::vector<StagingBlock> stagedLayers; //color maps that were converted to texture array layers but not uploaded yet
+    TextureLayer albedoLayer; //layer of a shared texture array that holds the color map, texture is 0 if the model binds its own textures
     glm::vec3 position, scale, theta; //stores the information to be used for transformation
+    glm::vec3 previousPosition, previousTheta; //position and rotation at the previous simulation tick
+    glm::vec3 renderPosition, renderTheta; //position and rotation blended between the last two simulation ticks, used when drawing
+    glm::vec3 boundsCenter; //center of the bounding sphere of the mesh before transformation
+    float boundsRadius; //radius of the bounding sphere of the mesh before transformation
+    std::string name; //obj file of the model, used in the residency report
+    int meshAllocation; //id of the vertex buffer in the residency manager
+    std::vector<int> textureAllocations; //id of every texture in the residency manager
+    int albedoAllocation; //id of the color map layer in the residency manager
+    int lastDrawnFrame; //frame in which the model or its placeholder was last drawn
+    VertexAnimation* animation; //clip the vertex shader poses the mesh with, NULL if the model is rigid
+    Impostor* impostor; //views of the mesh drawn on a quad when it is small on the screen, NULL if it has none
 
     //constructor for the model class
     Model3D(std::string modelPath, glm::vec3 position, glm::vec3 scale, glm::vec3 theta) {
         //sets the value of the class attributes
+        VAO = VBO = 0;
+        albedoLayer.texture = 0;
+        albedoLayer.layer = 0;
+        attribCount = 0;
+        name = modelPath;
+        meshAllocation = ResidencyManager::NO_ALLOCATION;
+        albedoAllocation = ResidencyManager::NO_ALLOCATION;
+        lastDrawnFrame = 0;
+        animation = NULL;
+        impostor = NULL;
         this->position = position;
         this->scale = scale;
         this->theta = theta;
+
+        //start with the same state in every tick
+        previousPosition = renderPosition = position;
+        previousTheta = renderTheta = theta;
+
+        boundsCenter = glm::vec3(0.0f);
+        boundsRadius = 0.0f;
     }
 
     //destructor for the model class
     ~Model3D() {
         //delete vertex arrays and buffers
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteVertexArrays(1, &VBO);
+        destroyBuffers();
+        delete animation;
+        delete impostor;
+
+        //delete the textures that the model binds itself, a layer of a shared array is removed by its owner
+        glDeleteTextures(textures.size(), textures.data());
+        for (int i = 0; i < textureAllocations.size(); i++) {
+            ResidencyManager::instance().release(textureAllocations[i]);
+        }
+        ResidencyManager::instance().release(albedoAllocation);
     }
 
+    //loads the vertex attributes from the obj file, this does not call opengl so it can run on any thread
     virtual void loadObject(std::string path) = 0;
 
-    void loadTexture(std::string path, Shader shader, std::string textureName) {
-        stbi_set_flip_vertically_on_load(true); //flip the texture
-
-        int img_width, img_height, color_channels;
-        //load the texture and fill out the variables
-        unsigned char* tex_bytes = stbi_load(
-            path.c_str(),
-            &img_width,
-            &img_height,
-            &color_channels,
-            0
+    //creates the vao and vbo of the mesh from fullVertexData and attributeSizes
+    void createBuffers() {
+        //generate id for the vao and vbo;
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+
+        //binds the vao of the current model
+        glBindVertexArray(VAO);
+
+        //binds the vbo of the current model
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+        //assign data to the vbo
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            sizeof(GL_FLOAT) * fullVertexData.size(),
+            fullVertexData.data(),
+            GL_STATIC_DRAW
         );
 
+        int attribOffset = 0; //determines the offset of the vertex attribute
+
+        //assign every attribute that the mesh has to its location in the vao
+        for (int location = 0; location < attributeSizes.size(); location++) {
+            if (attributeSizes[location] == 0) {
+                continue;
+            }
+
+            GLintptr attribPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the attribute
+            glVertexAttribPointer(
+                location,
+                attributeSizes[location],
+                GL_FLOAT,
+                GL_FALSE,
+                attribCount * sizeof(GL_FLOAT),
+                (void*)attribPtr
+            );
+            glEnableVertexAttribArray(location); //enable the vertex attribute
+
+            attribOffset += attributeSizes[location]; //update the offset by the size of the attribute
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0); //finish modifying the buffer
+        glBindVertexArray(0); //finish modifying the vao
+
+        meshAllocation = ResidencyManager::instance().track(ResidencyManager::MESH, name, sizeof(GLfloat) * fullVertexData.size());
+
+        //the clip is drawn with the mesh, so it is created and evicted together with it
+        if (animation && !animation->upload(name)) {
+            delete animation;
+            animation = NULL;
+        }
+    }
+
+    //deletes the vao and vbo of the mesh and the texture of its clip, fullVertexData and the baked clip are kept so
+    //that createBuffers can make them again
+    void destroyBuffers() {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        VAO = VBO = 0;
+        ResidencyManager::instance().release(meshAllocation);
+
+        if (animation) {
+            animation->destroy();
+        }
+    }
+
+    //decodes a texture file so that it can be uploaded later and copies it into the upload ring if one is given, this
+    //does not call opengl so it can run on any thread
+    void decodeTexture(std::string path, std::string textureName, UploadRing* uploadRing = NULL) {
+        PROFILE_ZONE("Model3D::decodeTexture");
+
+        ImageData image;
+        image.name = textureName;
+        image.decode(path, true); //flip the texture
+        image.stage(uploadRing);
+
+        pendingTextures.push_back(image);
+    }
+
+    //creates the buffers of the mesh and the textures that were decoded, must be called on the thread that owns the context
+    void upload(Shader shader, UploadRing* uploadRing = NULL) {
+        PROFILE_ZONE("Model3D::upload");
+
+        if (VAO == 0) {
+            createBuffers();
+        }
+
+        for (int i = 0; i < pendingTextures.size(); i++) {
+            uploadTexture(pendingTextures[i], shader);
+            pendingTextures[i].release(uploadRing);
+        }
+        pendingTextures.clear();
+    }
+
+    //converts the decoded color maps to layers with their mipmaps in blocks of the upload ring, this does not call
+    //opengl so it can run on any thread
+    //
+    //the thread waits up to the timeout for room in the ring, a layer that does not get room is kept in client memory
+    void stageLayers(TextureArrayManager& textureArrays, UploadRing& uploadRing, std::chrono::milliseconds timeout) {
+        PROFILE_ZONE("Model3D::stageLayers");
+
+        for (int i = 0; i < pendingTextures.size(); i++) {
+            std::vector<unsigned char> pixels;
+            textureArrays.prepare(pendingTextures[i], pixels);
+            pendingTextures[i].release();
+
+            //the layer is built in client memory and copied into the ring in one pass, since reading back from
+            //the mapped memory while building the mipmaps can be slow
+            StagingBlock block;
+            if (uploadRing.allocate(pixels.size(), block, timeout)) {
+                std::copy(pixels.begin(), pixels.end(), block.getData());
+            }
+            else {
+                block.assignClient(pixels);
+            }
+            stagedLayers.push_back(block);
+        }
+        pendingTextures.clear();
+    }
+
+    //hands the staged layers back to the ring without uploading them, used when the model is no longer needed
+    void releaseStaged(UploadRing& uploadRing) {
+        for (int i = 0; i < stagedLayers.size(); i++) {
+            uploadRing.submit(stagedLayers[i]);
+        }
+        stagedLayers.clear();
+    }
+
+    //returns the number of bytes that upload(TextureArrayManager&, UploadRing&) sends to the gpu
+    long long getUploadBytes() {
+        long long bytes = VAO == 0 ? (long long)fullVertexData.size() * sizeof(GLfloat) : 0;
+        if (VAO == 0 && animation) {
+            bytes += animation->getBytes();
+        }
+        for (int i = 0; i < stagedLayers.size(); i++) {
+            bytes += stagedLayers[i].size;
+        }
+        return bytes;
+    }
+
+    //creates the buffers of the mesh and places the color map that was staged in a shared texture array
+    void upload(TextureArrayManager& textureArrays, UploadRing& uploadRing) {
+        PROFILE_ZONE("Model3D::upload");
+
+        if (VAO == 0) {
+            createBuffers();
+        }
+
+        for (int i = 0; i < stagedLayers.size(); i++) {
+            albedoLayer = textureArrays.add(stagedLayers[i], uploadRing);
+        }
+        stagedLayers.clear();
+
+        if (albedoLayer.texture != 0 && albedoAllocation == ResidencyManager::NO_ALLOCATION) {
+            albedoAllocation = ResidencyManager::instance().track(ResidencyManager::TEXTURE_ARRAY, name + " color map", textureArrays.layerBytes, true);
+        }
+    }
+
+    //loads a texture and uploads it right away
+    void loadTexture(std::string path, Shader shader, std::string textureName) {
+        PROFILE_ZONE("Model3D::loadTexture");
+
+        ImageData image;
+        image.name = textureName;
+        image.decode(path, true); //flip the texture
+
+        uploadTexture(image, shader);
+        image.release();
+    }
+
+    //creates a texture from a decoded image
+    void uploadTexture(ImageData& image, Shader shader) {
+        int img_width = image.width, img_height = image.height, color_channels = image.channels;
+
+        //the pixels are read from the upload ring if they were staged there
+        const void* tex_bytes = image.bindPixels();
+
         //initialize textures
         GLuint texture;
         glGenTextures(1, &texture);
@@ -70,21 +285,85 @@ public:
         //generate mipmap
         glGenerateMipmap(GL_TEXTURE_2D);
 
-        //free up the loaded bytes
-        stbi_image_free(tex_bytes);
-
         //enable depth testing
         glEnable(GL_DEPTH_TEST);
 
-        //insert to the list of textures
+        //insert to the list of textures, rgb textures are counted with 4 bytes per texel since drivers pad them
         textures.push_back(texture);
+        textureAllocations.push_back(ResidencyManager::instance().track(ResidencyManager::TEXTURE, image.path, ResidencyManager::textureBytes(img_width, img_height, 4, true)));
+
+
+        textureAddresses.push_back(glGetUniformLocation(shader.shaderProgram, image.name.c_str())); //get the address of the texture name
+    }
+
+    //saves the state of the model before a simulation tick changes it
+    void storePreviousState() {
+        previousPosition = position;
+        previousTheta = theta;
+    }
+
+    //blends the state of the last two simulation ticks to get the state that is drawn
+    void interpolate(float alpha) {
+        renderPosition = glm::mix(previousPosition, position, alpha);
+        renderTheta = glm::mix(previousTheta, theta, alpha);
+    }
+
+    //computes the bounding sphere of the mesh from the positions in fullVertexData
+    void computeBounds() {
+        if (fullVertexData.empty() || attribCount < 3) {
+            return;
+        }
+
+        //find the box that encloses every vertex
+        glm::vec3 minimum = glm::vec3(fullVertexData[0], fullVertexData[1], fullVertexData[2]);
+        glm::vec3 maximum = minimum;
+        for (int i = 0; i + 2 < fullVertexData.size(); i += attribCount) {
+            glm::vec3 vertex = glm::vec3(fullVertexData[i], fullVertexData[i + 1], fullVertexData[i + 2]);
+            minimum = glm::min(minimum, vertex);
+            maximum = glm::max(maximum, vertex);
+        }
+
+        //the sphere around the box encloses the mesh
+        boundsCenter = (minimum + maximum) * 0.5f;
+        boundsRadius = glm::length(maximum - boundsCenter);
+    }
+
+    //returns the number of vertices drawn by the model
+    int getVertexCount() {
+        return fullVertexData.size() / attribCount;
+    }
 
+    //computes the transformation matrix of the model from the state that is drawn
+    glm::mat4 getTransformationMatrix() {
+        //compute for the transformation matrix of the model
+        glm::mat4 transformation_matrix = glm::mat4(1.0f);
+        //translate the model
+        transformation_matrix = glm::translate(transformation_matrix, renderPosition);
+        //scale the model
+        transformation_matrix = glm::scale(transformation_matrix, scale);
+        //rotate the model along the x-axis
+        transformation_matrix = glm::rotate(transformation_matrix, glm::radians(renderTheta.x), glm::normalize(glm::vec3(1.0f, 0.0f, 0.0f)));
+        //rotate the model along the y-axis
+        transformation_matrix = glm::rotate(transformation_matrix, glm::radians(renderTheta.y), glm::normalize(glm::vec3(0.0f, 1.0f, 0.0f)));
+        //rotate the model along the z-axis
+        transformation_matrix = glm::rotate(transformation_matrix, glm::radians(renderTheta.z), glm::normalize(glm::vec3(0.0f, 0.0f, 1.0f)));
+
+        return transformation_matrix;
+    }
 
-        textureAddresses.push_back(glGetUniformLocation(shader.shaderProgram, textureName.c_str())); //get the address of the texture name
+    //computes the matrix that transforms the normals, which is the inverse transpose of the transformation matrix
+    static glm::mat3 getNormalMatrix(glm::mat4 transformation_matrix) {
+        return glm::transpose(glm::inverse(glm::mat3(transformation_matrix)));
     }
 
     //draws the model on the screen after applying the appropiate transformation
     void draw(Shader shader) {
+        glm::mat4 transformation_matrix = getTransformationMatrix();
+        draw(shader, transformation_matrix, getNormalMatrix(transformation_matrix));
+    }
+
+    //draws the model on the screen with a transformation and normal matrix that were computed ahead of time
+    void draw(Shader shader, glm::mat4 transformation_matrix, glm::mat3 normal_matrix) {
 
         shader.useProgram();
 
@@ -99,25 +378,16 @@ public:
             glUniform1i(textureAddresses[i], i); //texture at i
         }
 
-        //compute for the transformation matrix of the model
-        glm::mat4 transformation_matrix = glm::mat4(1.0f);
-        //translate the model
-        transformation_matrix = glm::translate(transformation_matrix, position);
-        //scale the model
-        transformation_matrix = glm::scale(transformation_matrix, scale);
-        //rotate the model along the x-axis
-        transformation_matrix = glm::rotate(transformation_matrix, glm::radians(theta.x), glm::normalize(glm::vec3(1.0f, 0.0f, 0.0f)));
-        //rotate the model along the y-axis
-        transformation_matrix = glm::rotate(transformation_matrix, glm::radians(theta.y), glm::normalize(glm::vec3(0.0f, 1.0f, 0.0f)));
-        //rotate the model along the z-axis
-        transformation_matrix = glm::rotate(transformation_matrix, glm::radians(theta.z), glm::normalize(glm::vec3(0.0f, 0.0f, 1.0f)));
-
         //retrieve the location of the transform variable in the  shader
         unsigned int transformationLoc = glGetUniformLocation(shader.shaderProgram, "transform");
         //set the value of transform in the vertex shader
         glUniformMatrix4fv(transformationLoc, 1, GL_FALSE, glm::value_ptr(transformation_matrix));
 
+        //set the value of the normal matrix so that the shader does not invert the transformation for every vertex
+        unsigned int normalMatrixLoc = glGetUniformLocation(shader.shaderProgram, "normalMatrix");
+        glUniformMatrix3fv(normalMatrixLoc, 1, GL_FALSE, glm::value_ptr(normal_matrix));
+
         //draw the model
-        glDrawArrays(GL_TRIANGLES, 0, fullVertexData.size() / attribCount);
+        glDrawArrays(GL_TRIANGLES, 0, getVertexCount());
     }
 };
\ No newline at end of file
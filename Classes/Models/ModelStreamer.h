@@ -0,0 +1,121 @@
+#pragma once
+
+//describes a model that is loaded after the first frame
+struct ModelRequest {
+    int id; //identifies the request when its model is taken
+    std::string meshPath; //obj file of the mesh
+    std::string texturePath; //color map of the model
+    glm::vec3 position, scale, theta; //placement of the model
+    glm::vec4 placeholderBounds; //bounding sphere of the mesh as center (xyz) and radius (w), drawn as a box until the model is loaded
+    std::string animation; //clip the model is animated with, empty if the model is rigid
+};
+
+//ModelStreamer class reads the meshes and decodes the textures of the requested models on its own thread
+//
+//the loader thread is not part of the job system on purpose: a thread that waits for the frame jobs runs any queued
+//job while it waits, so a texture decode queued there could hold up a frame for hundreds of milliseconds. the
+//models are read in the order they were requested and handed to the thread that owns the context, which creates
+//their buffers and textures. the loader also converts the color maps to texture array layers and writes them into
+//the upload ring, so that the thread that owns the context only issues the copies.
+class ModelStreamer {
+public:
+    static const int STAGING_TIMEOUT_MILLISECONDS = 100; //how long the loader waits for room in the upload ring before it keeps a layer in client memory
+
+    TextureArrayManager* textureArrays; //decides the size and format of the layers the color maps are converted to
+    UploadRing* uploadRing; //staging memory the layers are written to
+    std::deque<ModelRequest> queue; //requests that were not started yet, oldest first
+    std::deque<std::pair<int, Model*>> finished; //models that were read but not taken yet, with the id of their request
+    std::mutex mutex; //guards the queue and the finished models
+    std::condition_variable wake; //wakes the loader when a request arrives or the streamer stops
+    bool isStopping; //checks if the loader should exit before reading the next model
+    std::thread loader; //thread that reads the models
+
+    //constructor for the model streamer class which starts the loader right away
+    ModelStreamer(TextureArrayManager* textureArrays, UploadRing* uploadRing) {
+        this->textureArrays = textureArrays;
+        this->uploadRing = uploadRing;
+        isStopping = false;
+
+        loader = std::thread(&ModelStreamer::loaderLoop, this);
+    }
+
+    //destructor for the model streamer class, the model being read is finished before the loader exits
+    ~ModelStreamer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopping = true;
+        }
+        wake.notify_all();
+        loader.join();
+
+        //the models that were never taken still belong to the streamer
+        for (int i = 0; i < finished.size(); i++) {
+            delete finished[i].second;
+        }
+    }
+
+    //queues a model to be read after the requests before it
+    void request(const ModelRequest& request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(request);
+        }
+        wake.notify_one();
+    }
+
+    //removes a request that was not started yet, returns false if the model is already being read or was read
+    bool cancel(int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < queue.size(); i++) {
+            if (queue[i].id == id) {
+                queue.erase(queue.begin() + i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //reads the requested models one after the other until the streamer stops
+    void loaderLoop() {
+        CPUProfiler::instance().setThreadName("Loader");
+
+        while (true) {
+            ModelRequest request;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return isStopping || !queue.empty(); });
+                if (isStopping) {
+                    return;
+                }
+
+                request = queue.front();
+                queue.pop_front();
+            }
+
+            PROFILE_ZONE("ModelStreamer::load");
+
+            Model* model = new Model(request.meshPath, request.position, request.scale, request.theta);
+            if (request.animation == "swim") {
+                model->animation = VertexAnimation::bakeSwim(model->fullVertexData, model->attribCount, model->attributeSizes);
+            }
+            model->decodeTexture(request.texturePath, "tex0");
+            model->stageLayers(*textureArrays, *uploadRing, std::chrono::milliseconds(STAGING_TIMEOUT_MILLISECONDS));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(std::make_pair(request.id, model));
+        }
+    }
+
+    //takes the oldest model that was read if its upload fits in the given number of bytes, returns false if none is ready
+    bool take(int& id, Model*& model, long long byteLimit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (finished.empty() || finished.front().second->getUploadBytes() > byteLimit) {
+            return false;
+        }
+
+        id = finished.front().first;
+        model = finished.front().second;
+        finished.pop_front();
+        return true;
+    }
+};
@@ -0,0 +1,286 @@
+#pragma once
+
+//ObjMesh class reads the positions, normals, texture coordinates, and triangles of an obj file into the scratch
+//allocator of the calling thread
+//
+//tinyobj::LoadObj keeps every face in a vector of its own and copies the shapes it builds, which costs thousands of
+//heap allocations for a single model. the mesh reads the file through the callback interface of tinyobj instead and
+//keeps everything in scratch vectors, so it must be read inside a ScratchScope and is freed when the scope ends. the
+//faces are triangulated the same way LoadObj does it, and like before only the faces of the first group or object
+//are kept.
+class ObjMesh {
+public:
+    ArenaVector<tinyobj::real_t> vertices; //xyz of every position
+    ArenaVector<tinyobj::real_t> normals; //xyz of every normal
+    ArenaVector<tinyobj::real_t> texcoords; //uv of every texture coordinate
+    ArenaVector<tinyobj::index_t> indices; //three corners for every triangle, -1 where a corner has no normal or uv
+    ArenaVector<tinyobj::index_t> corners; //corners of every face before the faces are triangulated
+    ArenaVector<int> faceSizes; //number of corners of every face
+    ArenaVector<tinyobj::index_t> remaining; //corners of the polygon that is being triangulated
+    bool isShapeFinished; //checks if a group or object started after faces were read, which ends the first shape
+
+    //constructor for the obj mesh class, the vectors are placed in the allocator of the scope
+    ObjMesh(ScratchScope& scope) : vertices(scope.makeVector<tinyobj::real_t>()), normals(scope.makeVector<tinyobj::real_t>()),
+        texcoords(scope.makeVector<tinyobj::real_t>()), indices(scope.makeVector<tinyobj::index_t>()),
+        corners(scope.makeVector<tinyobj::index_t>()), faceSizes(scope.makeVector<int>()), remaining(scope.makeVector<tinyobj::index_t>()) {
+        isShapeFinished = false;
+    }
+
+    //reads an obj file and triangulates its faces, returns false if the file could not be read
+    bool read(std::string path) {
+        PROFILE_ZONE("ObjMesh::read");
+
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            LOG_ERROR("MODEL", "[MODEL] Unable to open {}", path);
+            return false;
+        }
+
+        tinyobj::callback_t callback;
+        callback.vertex_cb = addVertex;
+        callback.normal_cb = addNormal;
+        callback.texcoord_cb = addTexcoord;
+        callback.index_cb = addFace;
+        callback.group_cb = startGroup;
+        callback.object_cb = startObject;
+
+        //the materials are not read since the models take their textures from the manifest
+        std::string warning, error;
+        bool success = tinyobj::LoadObjWithCallback(file, callback, this, NULL, &warning, &error);
+        if (!error.empty()) {
+            LOG_ERROR("MODEL", "[MODEL] {}: {}", path, error);
+        }
+
+        triangulate();
+        return success;
+    }
+
+    //stores the position of a v line
+    static void addVertex(void* mesh, tinyobj::real_t x, tinyobj::real_t y, tinyobj::real_t z, tinyobj::real_t /*w*/) {
+        ArenaVector<tinyobj::real_t>& vertices = ((ObjMesh*)mesh)->vertices;
+        vertices.push_back(x);
+        vertices.push_back(y);
+        vertices.push_back(z);
+    }
+
+    //stores the normal of a vn line
+    static void addNormal(void* mesh, tinyobj::real_t x, tinyobj::real_t y, tinyobj::real_t z) {
+        ArenaVector<tinyobj::real_t>& normals = ((ObjMesh*)mesh)->normals;
+        normals.push_back(x);
+        normals.push_back(y);
+        normals.push_back(z);
+    }
+
+    //stores the texture coordinate of a vt line
+    static void addTexcoord(void* mesh, tinyobj::real_t u, tinyobj::real_t v, tinyobj::real_t /*w*/) {
+        ArenaVector<tinyobj::real_t>& texcoords = ((ObjMesh*)mesh)->texcoords;
+        texcoords.push_back(u);
+        texcoords.push_back(v);
+    }
+
+    //stores the corners of an f line with their indices made zero based
+    static void addFace(void* data, tinyobj::index_t* faceCorners, int count) {
+        ObjMesh* mesh = (ObjMesh*)data;
+        if (mesh->isShapeFinished) {
+            return;
+        }
+
+        for (int i = 0; i < count; i++) {
+            tinyobj::index_t corner;
+            corner.vertex_index = fixIndex(faceCorners[i].vertex_index, mesh->vertices.size() / 3);
+            corner.normal_index = fixIndex(faceCorners[i].normal_index, mesh->normals.size() / 3);
+            corner.texcoord_index = fixIndex(faceCorners[i].texcoord_index, mesh->texcoords.size() / 2);
+            mesh->corners.push_back(corner);
+        }
+        mesh->faceSizes.push_back(count);
+    }
+
+    //ends the first shape once a g line follows its faces
+    static void startGroup(void* mesh, const char** /*names*/, int /*count*/) {
+        ((ObjMesh*)mesh)->isShapeFinished |= !((ObjMesh*)mesh)->faceSizes.empty();
+    }
+
+    //ends the first shape once an o line follows its faces
+    static void startObject(void* mesh, const char* /*name*/) {
+        ((ObjMesh*)mesh)->isShapeFinished |= !((ObjMesh*)mesh)->faceSizes.empty();
+    }
+
+    //turns a one based or negative (relative) index into a zero based one, 0 means the corner has no such attribute
+    static int fixIndex(int index, int count) {
+        if (index > 0) {
+            return index - 1;
+        }
+        if (index < 0) {
+            return count + index;
+        }
+        return -1;
+    }
+
+    //checks if a corner refers to a position that was read
+    bool isValid(tinyobj::index_t corner) {
+        return 3 * (size_t)corner.vertex_index + 2 < vertices.size();
+    }
+
+    //returns a coordinate of the position of a corner
+    tinyobj::real_t coordinate(tinyobj::index_t corner, int axis) {
+        return vertices[corner.vertex_index * 3 + axis];
+    }
+
+    //splits every face into triangles: quads along their shorter diagonal and larger polygons by ear clipping
+    void triangulate() {
+        PROFILE_ZONE("ObjMesh::triangulate");
+
+        //most faces are triangles or quads
+        indices.reserve(corners.size() * 3 / 2 + 3);
+
+        int start = 0;
+        for (int i = 0; i < faceSizes.size(); i++) {
+            tinyobj::index_t* face = &corners[start];
+            int size = faceSizes[i];
+            start += size;
+
+            if (size == 3) {
+                addTriangle(face[0], face[1], face[2]);
+            }
+            else if (size == 4) {
+                triangulateQuad(face);
+            }
+            else if (size > 4) {
+                triangulatePolygon(face, size);
+            }
+        }
+    }
+
+    //appends a triangle to the indices
+    void addTriangle(tinyobj::index_t a, tinyobj::index_t b, tinyobj::index_t c) {
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    }
+
+    //splits a quad along the shorter of its two diagonals
+    void triangulateQuad(tinyobj::index_t* face) {
+        if (!isValid(face[0]) || !isValid(face[1]) || !isValid(face[2]) || !isValid(face[3])) {
+            return;
+        }
+
+        tinyobj::real_t sqr02 = 0, sqr13 = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            tinyobj::real_t e02 = coordinate(face[2], axis) - coordinate(face[0], axis);
+            tinyobj::real_t e13 = coordinate(face[3], axis) - coordinate(face[1], axis);
+            sqr02 += e02 * e02;
+            sqr13 += e13 * e13;
+        }
+
+        if (sqr02 < sqr13) {
+            addTriangle(face[0], face[1], face[2]);
+            addTriangle(face[0], face[2], face[3]);
+        }
+        else {
+            addTriangle(face[0], face[1], face[3]);
+            addTriangle(face[1], face[2], face[3]);
+        }
+    }
+
+    //splits a polygon into triangles by clipping the ears of its projection onto the plane it is most aligned with
+    void triangulatePolygon(tinyobj::index_t* face, int size) {
+        //find the two axes to work in from the first corner that is not straight
+        int axes[2] = { 1, 2 };
+        for (int k = 0; k < size; k++) {
+            tinyobj::index_t i0 = face[k % size], i1 = face[(k + 1) % size], i2 = face[(k + 2) % size];
+            if (!isValid(i0) || !isValid(i1) || !isValid(i2)) {
+                continue;
+            }
+
+            tinyobj::real_t e0x = coordinate(i1, 0) - coordinate(i0, 0);
+            tinyobj::real_t e0y = coordinate(i1, 1) - coordinate(i0, 1);
+            tinyobj::real_t e0z = coordinate(i1, 2) - coordinate(i0, 2);
+            tinyobj::real_t e1x = coordinate(i2, 0) - coordinate(i1, 0);
+            tinyobj::real_t e1y = coordinate(i2, 1) - coordinate(i1, 1);
+            tinyobj::real_t e1z = coordinate(i2, 2) - coordinate(i1, 2);
+            tinyobj::real_t cx = std::fabs(e0y * e1z - e0z * e1y);
+            tinyobj::real_t cy = std::fabs(e0z * e1x - e0x * e1z);
+            tinyobj::real_t cz = std::fabs(e0x * e1y - e0y * e1x);
+            tinyobj::real_t epsilon = std::numeric_limits<tinyobj::real_t>::epsilon();
+            if (cx > epsilon || cy > epsilon || cz > epsilon) {
+                if (!(cx > cy && cx > cz)) {
+                    axes[0] = 0;
+                    if (cz > cx && cz > cy) {
+                        axes[1] = 1;
+                    }
+                }
+                break;
+            }
+        }
+
+        remaining.assign(face, face + size);
+        size_t guess = 0;
+        size_t remainingIterations = size; //tries left to find an ear before giving up on the polygon
+        size_t previousCount = size;
+
+        while (remaining.size() > 3 && remainingIterations > 0) {
+            size_t count = remaining.size();
+            if (guess >= count) {
+                guess -= count;
+            }
+
+            if (previousCount != count) {
+                previousCount = count;
+                remainingIterations = count;
+            }
+            else {
+                remainingIterations--;
+            }
+
+            tinyobj::index_t ear[3];
+            tinyobj::real_t x[3], y[3];
+            for (int k = 0; k < 3; k++) {
+                ear[k] = remaining[(guess + k) % count];
+                size_t vertex = (size_t)ear[k].vertex_index;
+                bool isInside = vertex * 3 + axes[0] < vertices.size() && vertex * 3 + axes[1] < vertices.size();
+                x[k] = isInside ? vertices[vertex * 3 + axes[0]] : 0;
+                y[k] = isInside ? vertices[vertex * 3 + axes[1]] : 0;
+            }
+
+            //skip the corner if its inner angle is reflex
+            tinyobj::real_t cross = (x[1] - x[0]) * (y[2] - y[1]) - (y[1] - y[0]) * (x[2] - x[1]);
+            tinyobj::real_t area = (x[0] * y[1] - y[0] * x[1]) * (tinyobj::real_t)0.5;
+            if (cross * area < 0) {
+                guess++;
+                continue;
+            }
+
+            //skip the corner if another corner lies inside the ear
+            bool isOverlapping = false;
+            for (size_t other = 3; other < count && !isOverlapping; other++) {
+                size_t vertex = (size_t)remaining[(guess + other) % count].vertex_index;
+                if (vertex * 3 + axes[0] >= vertices.size() || vertex * 3 + axes[1] >= vertices.size()) {
+                    continue;
+                }
+                isOverlapping = isInsideTriangle(x, y, vertices[vertex * 3 + axes[0]], vertices[vertex * 3 + axes[1]]);
+            }
+            if (isOverlapping) {
+                guess++;
+                continue;
+            }
+
+            addTriangle(ear[0], ear[1], ear[2]);
+            remaining.erase(remaining.begin() + (guess + 1) % count);
+        }
+
+        if (remaining.size() == 3) {
+            addTriangle(remaining[0], remaining[1], remaining[2]);
+        }
+    }
+
+    //checks if a point is inside a triangle with a crossing test
+    static bool isInsideTriangle(tinyobj::real_t* x, tinyobj::real_t* y, tinyobj::real_t pointX, tinyobj::real_t pointY) {
+        bool isInside = false;
+        for (int i = 0, j = 2; i < 3; j = i++) {
+            if (((y[i] > pointY) != (y[j] > pointY)) && (pointX < (x[j] - x[i]) * (pointY - y[i]) / (y[j] - y[i]) + x[i])) {
+                isInside = !isInside;
+            }
+        }
+        return isInside;
+    }
+};
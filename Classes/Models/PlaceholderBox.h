@@ -0,0 +1,79 @@
+#pragma once
+
+//PlaceholderBox class draws the edges of a cube from -1 to 1, which marks where a model will appear while it loads
+//
+//the vertices use the layout of the model shader (position, normal, texture coordinates) so that the box is drawn with
+//the untextured model variant. the normal of a corner points away from the center of the box.
+class PlaceholderBox {
+public:
+    static const int EDGE_INDEX_COUNT = 24; //two indices for each of the 12 edges
+
+    GLuint VAO, VBO, EBO; //vertex array, vertex buffer, and index buffer of the box
+    int allocation; //id of the buffers in the residency manager
+
+    //constructor for the placeholder box class, must be called on the thread that owns the context
+    PlaceholderBox() {
+        std::vector<GLfloat> vertices;
+        for (int i = 0; i < 8; i++) {
+            glm::vec3 corner((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+            glm::vec3 normal = glm::normalize(corner);
+
+            vertices.push_back(corner.x);
+            vertices.push_back(corner.y);
+            vertices.push_back(corner.z);
+            vertices.push_back(normal.x);
+            vertices.push_back(normal.y);
+            vertices.push_back(normal.z);
+            vertices.push_back(0.0f);
+            vertices.push_back(0.0f);
+        }
+
+        //each pair of corners differs in a single axis
+        GLuint edges[EDGE_INDEX_COUNT] = {
+            0, 1, 2, 3, 4, 5, 6, 7, //along x
+            0, 2, 1, 3, 4, 6, 5, 7, //along y
+            0, 4, 1, 5, 2, 6, 3, 7  //along z
+        };
+
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glGenBuffers(1, &EBO);
+
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(edges), edges, GL_STATIC_DRAW);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(2);
+
+        //the index buffer stays bound to the vao
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        allocation = ResidencyManager::instance().track(ResidencyManager::MESH, "Placeholder box", sizeof(GLfloat) * vertices.size() + sizeof(edges));
+    }
+
+    //destructor for the placeholder box class
+    ~PlaceholderBox() {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &EBO);
+        ResidencyManager::instance().release(allocation);
+    }
+
+    //draws the box with a transformation that maps the unit cube onto the bounds of the model
+    void draw(Shader& shader, glm::mat4 transformation_matrix, glm::mat3 normal_matrix) {
+        glUniformMatrix4fv(glGetUniformLocation(shader.shaderProgram, "transform"), 1, GL_FALSE, glm::value_ptr(transformation_matrix));
+        glUniformMatrix3fv(glGetUniformLocation(shader.shaderProgram, "normalMatrix"), 1, GL_FALSE, glm::value_ptr(normal_matrix));
+
+        glBindVertexArray(VAO);
+        glDrawElements(GL_LINES, EDGE_INDEX_COUNT, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+    }
+};
@@ -5,77 +5,79 @@ class Player : public Model3D {
 public:
 
     glm::vec3 direction;
+    LogRateLimiter depthLogLimiter; //limits how often the ocean depth is written while the submarine moves up or down
+
+    //movement speeds of the submarine
+    static constexpr float ROTATION_SPEED = 60.0f; //degrees per second
+    static constexpr float VERTICAL_SPEED = 6.0f; //units per second
+    static constexpr float HORIZONTAL_SPEED = 12.0f; //units per second
 
     //constructor for the main model class
-    Player(std::string modelPath, glm::vec3 position, glm::vec3 scale, glm::vec3 theta) : Model3D(modelPath, position, scale, theta) {
-        direction = glm::normalize(glm::vec3(sin(glm::radians(theta.y)), 0, cos(glm::radians(theta.y))));
+    Player(std::string modelPath, glm::vec3 position, glm::vec3 scale, glm::vec3 theta) : Model3D(modelPath, position, scale, theta), depthLogLimiter(0.1) {
+        updateDirection();
         loadObject(modelPath);
     }
 
     //load the vertex attributes from the obj file
     void loadObject(std::string path) override {
-        std::vector<tinyobj::shape_t> shapes; //stores the shapes of the mesh
-        std::vector<tinyobj::material_t> materials; //stores shapes of the mesh
-        std::string warning, error; //stores warning or error messages
-        tinyobj::attrib_t attributes; //stores mesh attributes
+        PROFILE_ZONE("Player::loadObject");
+
+        //the parsed file is only needed until the vertex data is built, so it is kept in scratch memory
+        ScratchScope scope;
+        ObjMesh mesh(scope);
 
         //loads the mesh
-        bool success = tinyobj::LoadObj(
-            &attributes,
-            &shapes,
-            &materials,
-            &warning,
-            &error,
-            path.c_str()
-        );
-
-        std::vector<glm::vec3> tangents; //collection of tangent
-        std::vector<glm::vec3> bitangents; //collection of tangent
+        bool success = mesh.read(path);
+
+        ArenaVector<glm::vec3> tangents = scope.makeVector<glm::vec3>(); //collection of tangent
+        ArenaVector<glm::vec3> bitangents = scope.makeVector<glm::vec3>(); //collection of tangent
+        tangents.reserve(mesh.indices.size());
+        bitangents.reserve(mesh.indices.size());
 
         //calculate for the tangent and bitangent
-        for (int i = 0; i < shapes[0].mesh.indices.size(); i += 3) {
+        for (int i = 0; i < mesh.indices.size(); i += 3) {
             //vertices of the triangle
-            tinyobj::index_t vData1 = shapes[0].mesh.indices[i]; //v1
-            tinyobj::index_t vData2 = shapes[0].mesh.indices[i + 1]; //v2
-            tinyobj::index_t vData3 = shapes[0].mesh.indices[i + 2]; //v3
+            tinyobj::index_t vData1 = mesh.indices[i]; //v1
+            tinyobj::index_t vData2 = mesh.indices[i + 1]; //v2
+            tinyobj::index_t vData3 = mesh.indices[i + 2]; //v3
 
             //xyz components of vertex 1
             glm::vec3 v1 = glm::vec3(
-                attributes.vertices[vData1.vertex_index * 3],
-                attributes.vertices[vData1.vertex_index * 3 + 1],
-                attributes.vertices[vData1.vertex_index * 3 + 2]
+                mesh.vertices[vData1.vertex_index * 3],
+                mesh.vertices[vData1.vertex_index * 3 + 1],
+                mesh.vertices[vData1.vertex_index * 3 + 2]
             );
 
             //xyz components of vertex 2
             glm::vec3 v2 = glm::vec3(
-                attributes.vertices[vData2.vertex_index * 3],
-                attributes.vertices[vData2.vertex_index * 3 + 1],
-                attributes.vertices[vData2.vertex_index * 3 + 2]
+                mesh.vertices[vData2.vertex_index * 3],
+                mesh.vertices[vData2.vertex_index * 3 + 1],
+                mesh.vertices[vData2.vertex_index * 3 + 2]
             );
 
             //xyz components of vertex 3
             glm::vec3 v3 = glm::vec3(
-                attributes.vertices[vData3.vertex_index * 3],
-                attributes.vertices[vData3.vertex_index * 3 + 1],
-                attributes.vertices[vData3.vertex_index * 3 + 2]
+                mesh.vertices[vData3.vertex_index * 3],
+                mesh.vertices[vData3.vertex_index * 3 + 1],
+                mesh.vertices[vData3.vertex_index * 3 + 2]
             );
 
             //uv components of vertex 1
             glm::vec2 uv1 = glm::vec2(
-                attributes.texcoords[vData1.texcoord_index * 2],
-                attributes.texcoords[vData1.texcoord_index * 2 + 1]
+                mesh.texcoords[vData1.texcoord_index * 2],
+                mesh.texcoords[vData1.texcoord_index * 2 + 1]
             );
 
             //uv components of vertex 2
             glm::vec2 uv2 = glm::vec2(
-                attributes.texcoords[vData2.texcoord_index * 2],
-                attributes.texcoords[vData2.texcoord_index * 2 + 1]
+                mesh.texcoords[vData2.texcoord_index * 2],
+                mesh.texcoords[vData2.texcoord_index * 2 + 1]
             );
 
             //uv components of vertex 3
             glm::vec2 uv3 = glm::vec2(
-                attributes.texcoords[vData3.texcoord_index * 2],
-                attributes.texcoords[vData3.texcoord_index * 2 + 1]
+                mesh.texcoords[vData3.texcoord_index * 2],
+                mesh.texcoords[vData3.texcoord_index * 2 + 1]
             );
 
             //edges of the triangle
@@ -103,18 +105,19 @@ public:
         }
 
         //determine if the obj file contains vertices, normals, and texture coordinates
-        bool hasVertices = attributes.vertices.size() != 0;
-        bool hasNormals = attributes.normals.size() != 0;
-        bool hasTexCoords = attributes.texcoords.size() != 0;
+        bool hasVertices = mesh.vertices.size() != 0;
+        bool hasNormals = mesh.normals.size() != 0;
+        bool hasTexCoords = mesh.texcoords.size() != 0;
         bool hasTangents = tangents.size() != 0;
         bool hasBitangents = bitangents.size() != 0;
 
         //calculate for the total number of attributes for a single vertex
         attribCount = hasVertices * 3 + hasNormals * 3 + hasTexCoords * 2 + hasTangents * 3 + hasBitangents * 3;
+        fullVertexData.reserve(mesh.indices.size() * attribCount);
 
         //process the vertex attributes
-        for (int i = 0; i < shapes[0].mesh.indices.size(); i++) {
-            tinyobj::index_t vData = shapes[0].mesh.indices[i];
+        for (int i = 0; i < mesh.indices.size(); i++) {
+            tinyobj::index_t vData = mesh.indices[i];
 
             //process the vertices if it exists
             if (hasVertices) {
@@ -122,17 +125,17 @@ public:
 
                 //vertex x
                 fullVertexData.push_back(
-                    attributes.vertices[vertexIndex]
+                    mesh.vertices[vertexIndex]
                 );
 
                 //vertex y
                 fullVertexData.push_back(
-                    attributes.vertices[vertexIndex + 1]
+                    mesh.vertices[vertexIndex + 1]
                 );
 
                 //vertex z
                 fullVertexData.push_back(
-                    attributes.vertices[vertexIndex + 2]
+                    mesh.vertices[vertexIndex + 2]
                 );
             }
 
@@ -142,17 +145,17 @@ public:
 
                 //normal x
                 fullVertexData.push_back(
-                    attributes.normals[normalIndex]
+                    mesh.normals[normalIndex]
                 );
 
                 //normal y
                 fullVertexData.push_back(
-                    attributes.normals[normalIndex + 1]
+                    mesh.normals[normalIndex + 1]
                 );
 
                 //normal z
                 fullVertexData.push_back(
-                    attributes.normals[normalIndex + 2]
+                    mesh.normals[normalIndex + 2]
                 );
             }
 
@@ -161,12 +164,12 @@ public:
                 int uvIndex = vData.texcoord_index * 2; //2 - uv
                 //texture u
                 fullVertexData.push_back(
-                    attributes.texcoords[uvIndex]
+                    mesh.texcoords[uvIndex]
                 );
 
                 //texture v
                 fullVertexData.push_back(
-                    attributes.texcoords[uvIndex + 1]
+                    mesh.texcoords[uvIndex + 1]
                 );
             }
 
@@ -205,149 +208,62 @@ public:
             }
         }
 
-        //generate id for the vao and vbo;
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-
-        //binds the vao of the current model
-        glBindVertexArray(VAO);
-
-        //binds the vbo of the current model
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-        //assign data to the vbo
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            sizeof(GL_FLOAT) * fullVertexData.size(),
-            fullVertexData.data(),
-            GL_STATIC_DRAW
-        );
-
-        int attribOffset = 0; //determines the offset of the vertex attribute
-
-        if (hasVertices) {
-            GLintptr vertPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the vertex
-            //assign vertex data to the vao
-            glVertexAttribPointer(
-                0,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)vertPtr
-            );
-            glEnableVertexAttribArray(0); //enable vertex attribute 0
-
-            attribOffset += 3;//update the offset by 3 (xyz)
-        }
-
-        if (hasNormals) {
-            GLintptr normPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the normal
-            //assign normal data to the vao
-            glVertexAttribPointer(
-                1,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)normPtr
-            );
-            glEnableVertexAttribArray(1); //enable vertex attribute 1
-
-            attribOffset += 3; //update the offset by 3 (xyz)
-        }
-
-        if (hasTexCoords) {
-            GLintptr uvPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the texture
-            //assign texture data to the vao
-            glVertexAttribPointer(
-                2,
-                2, //uv
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)uvPtr
-            );
-            glEnableVertexAttribArray(2); //enable vertex attribute 2
-
-            attribOffset += 2; //update the offset by 2 (uv)
-        }
-
-        if (hasTangents) {
-            GLintptr tangentPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the tangent
-            //assign tangent data to the vao
-            glVertexAttribPointer(
-                3,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)tangentPtr
-            );
-
-            glEnableVertexAttribArray(3); //enable vertex attribute 3
-
-            attribOffset += 3; //update the offset by 2 (xyz)
-        }
-
-        if (hasBitangents) {
-            GLintptr bitangentPtr = attribOffset * sizeof(GLfloat); //caculate for the offset of the bitangent
-            //assign bitangent data to the vao
-            glVertexAttribPointer(
-                4,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                attribCount * sizeof(GL_FLOAT),
-                (void*)bitangentPtr
-            );
+        //store the layout of the vertex attributes so that the buffers can be created on the opengl thread
+        attributeSizes = { hasVertices * 3, hasNormals * 3, hasTexCoords * 2, hasTangents * 3, hasBitangents * 3 };
 
-            glEnableVertexAttribArray(4); //enable vertex attribute 4
-
-            attribOffset += 3; //update the offset by 2 (xyz)
-        }
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0); //finish modifying the buffer
-        glBindVertexArray(0); //finish modifying the vao
+        //compute the bounding sphere used for visibility tests
+        computeBounds();
     }
 
-    //process keyboard inputs and update the object attributes
-    void processKeyboard(int key) {
-        float rot_sensitivity = 1.0f;
-        float vert_sensitivity = 0.2f;
-        float horz_sensitivity = 0.4f;
-
-        //update the direction of the model
+    //update the direction of the model based on its rotation around the y axis
+    void updateDirection() {
         direction = glm::normalize(glm::vec3(sin(glm::radians(theta.y)), 0, cos(glm::radians(theta.y))));
+    }
+
+    //returns the rotation of the model around the y axis at the state that is drawn, its z axis is the direction of the model
+    glm::mat4 getRenderHeading() {
+        return glm::rotate(glm::mat4(1.0f), glm::radians(renderTheta.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
 
-        if (key == GLFW_KEY_Q || key == GLFW_KEY_E) {
+    //moves the model based on the held keys over a simulation tick of deltaTime seconds
+    void update(InputState& input, float deltaTime) {
+        if (input.isAscending || input.isDescending) {
             /*Elevate*/
-            if (key == GLFW_KEY_Q && position.y) {
-                position.y = glm::min(position.y + vert_sensitivity, 0.0f);
+            if (input.isAscending) {
+                position.y = glm::min(position.y + VERTICAL_SPEED * deltaTime, 0.0f);
             }
             /*Descend*/
-            if (key == GLFW_KEY_E) {
-                position.y -= vert_sensitivity;
+            if (input.isDescending) {
+                position.y -= VERTICAL_SPEED * deltaTime;
             }
-            /*Update depth info*/
-            printf("\rCurrent ocean depth: %.2f ", position.y);
+            /*Update depth info, the keys are held for many ticks so only a few lines per second are written*/
+            if (depthLogLimiter.allow()) {
+                LOG_STATUS("PLAYER", "Current ocean depth: {.2} ", position.y);
+            }
+        }
+        else if (depthLogLimiter.hasSuppressed()) {
+            //write the depth the submarine stopped at
+            LOG_STATUS("PLAYER", "Current ocean depth: {.2} ", position.y);
         }
 
         /*Traverse Forward*/
-        if (key == GLFW_KEY_W) {
-            position += direction * horz_sensitivity;
+        if (input.isForward) {
+            position += direction * HORIZONTAL_SPEED * deltaTime;
         }
         /*Traverse Backward*/
-        if (key == GLFW_KEY_S) {
-            position -= direction * horz_sensitivity;
+        if (input.isBackward) {
+            position -= direction * HORIZONTAL_SPEED * deltaTime;
         }
         /*Rotate to left*/
-        if (key == GLFW_KEY_A) {
-            theta.y += rot_sensitivity + 1.0;
+        if (input.isLeft) {
+            theta.y += ROTATION_SPEED * deltaTime;
         }
         /*Rotate to right*/
-        if (key == GLFW_KEY_D) {
-            theta.y -= rot_sensitivity + 1.0;
+        if (input.isRight) {
+            theta.y -= ROTATION_SPEED * deltaTime;
         }
+
+        //update the direction of the model
+        updateDirection();
     }
 };
\ No newline at end of file
@@ -0,0 +1,171 @@
+#pragma once
+
+//ProgramCache class saves linked shader programs to disk so that later launches skip compiling the glsl
+//
+//a program is stored with glGetProgramBinary under a key made from its sources and the renderer and version strings
+//of the driver, so a driver update or an edited shader misses the cache instead of loading a stale binary. drivers
+//may still reject a binary they wrote themselves, so a failed load deletes the file and the shader is recompiled.
+class ProgramCache {
+public:
+    static const unsigned int MAGIC = 0x42505847; //marks the start of a cache file ("GXPB")
+
+    //stored at the start of every cache file
+    struct FileHeader {
+        unsigned int magic; //always MAGIC
+        GLenum format; //binary format returned by glGetProgramBinary
+        int length; //number of bytes of the binary after the header
+    };
+
+    std::string directory; //directory where the binaries are written
+    std::string deviceName; //renderer and version of the driver, part of every key
+    bool isSupported; //checks if the driver can save program binaries at all
+    int hitCount; //number of programs loaded from the cache
+    int missCount; //number of programs that were compiled
+
+    //constructor for the program cache class, needs a current context to query the driver
+    ProgramCache(std::string directory) {
+        this->directory = directory;
+        hitCount = 0;
+        missCount = 0;
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        isSupported = formatCount > 0 && glProgramBinary != NULL && glGetProgramBinary != NULL;
+
+        deviceName = std::string((const char*)glGetString(GL_RENDERER)) + "|" + (const char*)glGetString(GL_VERSION);
+
+        if (isSupported) {
+            createDirectory(directory);
+        }
+        else {
+            LOG_WARNING("SHADER", "[SHADER] The driver cannot save program binaries, shaders are compiled every launch");
+        }
+    }
+
+    //creates the cache directory if it does not exist yet
+    static void createDirectory(std::string path) {
+#ifdef _WIN32
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+
+    //hashes the sources of a program together with the driver (64 bit fnv-1a)
+    unsigned long long keyOf(std::string vertSource, std::string fragSource) {
+        unsigned long long hash = 14695981039346656037ULL;
+        hash = addToHash(hash, deviceName);
+        hash = addToHash(hash, vertSource);
+        hash = addToHash(hash, fragSource);
+        return hash;
+    }
+
+    //mixes a string and a separator into the hash so that moving text between the sources changes the key
+    static unsigned long long addToHash(unsigned long long hash, const std::string& text) {
+        for (int i = 0; i < text.size(); i++) {
+            hash = (hash ^ (unsigned char)text[i]) * 1099511628211ULL;
+        }
+        return (hash ^ 0xFF) * 1099511628211ULL;
+    }
+
+    //returns the file that stores the program with the given key
+    std::string pathOf(unsigned long long key) {
+        std::ostringstream path;
+        path << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return path.str();
+    }
+
+    //loads a saved binary into the program, returns false if it was missing or rejected by the driver
+    bool load(GLuint program, unsigned long long key) {
+        PROFILE_ZONE("ProgramCache::load");
+
+        if (!isSupported) {
+            return false;
+        }
+
+        std::string path = pathOf(key);
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            missCount++;
+            return false;
+        }
+
+        FileHeader header;
+        file.read((char*)&header, sizeof(header));
+        if (!file || header.magic != MAGIC || header.length <= 0) {
+            file.close();
+            discard(path, "has an invalid header");
+            return false;
+        }
+
+        std::vector<char> binary(header.length);
+        file.read(binary.data(), header.length);
+        if (!file) {
+            file.close();
+            discard(path, "is truncated");
+            return false;
+        }
+        file.close();
+
+        //the driver reports a failed link when it does not accept the binary anymore
+        glProgramBinary(program, header.format, binary.data(), header.length);
+        GLint isLinked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+        if (!isLinked) {
+            discard(path, "was rejected by the driver");
+            return false;
+        }
+
+        hitCount++;
+        return true;
+    }
+
+    //writes the binary of a linked program, the program has to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    void store(GLuint program, unsigned long long key) {
+        PROFILE_ZONE("ProgramCache::store");
+
+        if (!isSupported) {
+            return;
+        }
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+
+        FileHeader header;
+        header.magic = MAGIC;
+        header.format = 0;
+        header.length = 0;
+        std::vector<char> binary(length);
+        glGetProgramBinary(program, length, &header.length, &header.format, binary.data());
+        if (header.length <= 0) {
+            return;
+        }
+
+        //write to a temporary file first so that a crash never leaves half a binary under the real name
+        std::string path = pathOf(key);
+        std::string temporaryPath = path + ".tmp";
+        std::ofstream file(temporaryPath, std::ios::binary);
+        file.write((const char*)&header, sizeof(header));
+        file.write(binary.data(), header.length);
+        file.close();
+
+        if (!file) {
+            LOG_WARNING("SHADER", "[SHADER] Unable to write {}", temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return;
+        }
+
+        std::remove(path.c_str());
+        std::rename(temporaryPath.c_str(), path.c_str());
+    }
+
+    //deletes a cache file that cannot be used so that the recompiled program replaces it
+    void discard(std::string path, const char* reason) {
+        LOG_WARNING("SHADER", "[SHADER] Cached program {} {}, recompiling", path, reason);
+        std::remove(path.c_str());
+        missCount++;
+    }
+};
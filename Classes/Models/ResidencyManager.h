@@ -0,0 +1,165 @@
+#pragma once
+
+//ResidencyManager class accounts the gpu memory of every buffer and texture the program creates
+//
+//opengl does not report how much memory an object uses, so every allocation is recorded with the size computed from
+//its dimensions and format when it is created and removed when it is deleted. the total is compared against the
+//budget given with --vram-budget, and the world evicts and demotes the models that were drawn least recently while it
+//is over. allocations that live inside another one, like the layers of a texture array, are reported per asset but
+//not added to the totals. the manager is only used by the thread that owns the context.
+class ResidencyManager {
+public:
+    //kind of memory an allocation uses
+    enum Category {
+        MESH, //vertex and index buffers
+        TEXTURE, //standalone textures and cubemaps
+        TEXTURE_ARRAY, //shared texture arrays, the layers of the models are reported inside them
+        RENDER_TARGET, //offscreen framebuffers
+        STAGING, //buffers that are written by the cpu and read by uploads
+        CATEGORY_COUNT
+    };
+
+    //stores the size of an allocation
+    struct Allocation {
+        std::string name; //asset the allocation belongs to
+        Category category; //kind of memory
+        long long bytes; //size of the allocation
+        bool isShared; //checks if the allocation lives inside another one and is not counted in the totals
+    };
+
+    static const int NO_ALLOCATION = -1; //id of an object that is not accounted
+
+    std::map<int, Allocation> allocations; //every allocation that is alive, by id
+    long long categoryBytes[CATEGORY_COUNT]; //total size of each category
+    long long totalBytes; //total size of every allocation that is not shared
+    long long peakBytes; //largest total seen
+    long long budgetBytes; //size the total should stay under, 0 if there is no budget
+    int nextId; //id given to the next allocation
+
+    //returns the manager that is shared by the whole program
+    static ResidencyManager& instance() {
+        static ResidencyManager manager;
+        return manager;
+    }
+
+    //constructor for the residency manager class
+    ResidencyManager() {
+        for (int i = 0; i < CATEGORY_COUNT; i++) {
+            categoryBytes[i] = 0;
+        }
+        totalBytes = 0;
+        peakBytes = 0;
+        budgetBytes = 0;
+        nextId = 0;
+    }
+
+    //returns the size of a texture with the given dimensions, including the mipmaps below it if it has them
+    static long long textureBytes(int width, int height, int bytesPerTexel, bool isMipmapped) {
+        long long bytes = (long long)width * height * bytesPerTexel;
+
+        //every level down to 1x1 of a mipmapped texture
+        while (isMipmapped && (width > 1 || height > 1)) {
+            width = glm::max(width / 2, 1);
+            height = glm::max(height / 2, 1);
+            bytes += (long long)width * height * bytesPerTexel;
+        }
+        return bytes;
+    }
+
+    //records an allocation and returns its id
+    int track(Category category, std::string name, long long bytes, bool isShared = false) {
+        Allocation allocation;
+        allocation.name = name;
+        allocation.category = category;
+        allocation.bytes = 0;
+        allocation.isShared = isShared;
+
+        int id = nextId++;
+        allocations[id] = allocation;
+        resize(id, bytes);
+        return id;
+    }
+
+    //changes the size of an allocation, used when a texture is demoted
+    void resize(int id, long long bytes) {
+        std::map<int, Allocation>::iterator it = allocations.find(id);
+        if (it == allocations.end()) {
+            return;
+        }
+
+        Allocation& allocation = it->second;
+        if (!allocation.isShared) {
+            categoryBytes[allocation.category] += bytes - allocation.bytes;
+            totalBytes += bytes - allocation.bytes;
+            peakBytes = glm::max(peakBytes, totalBytes);
+        }
+        allocation.bytes = bytes;
+    }
+
+    //removes an allocation once its object was deleted and clears the id
+    void release(int& id) {
+        if (id == NO_ALLOCATION) {
+            return;
+        }
+
+        resize(id, 0);
+        allocations.erase(id);
+        id = NO_ALLOCATION;
+    }
+
+    //checks if the allocations use more than the budget
+    bool isOverBudget() {
+        return budgetBytes > 0 && totalBytes > budgetBytes;
+    }
+
+    //checks if an allocation of the given size fits in the budget
+    bool hasRoomFor(long long bytes) {
+        return budgetBytes <= 0 || totalBytes + bytes <= budgetBytes;
+    }
+
+    //returns the name of a category as it appears in the report
+    static const char* categoryName(int category) {
+        switch (category) {
+            case MESH:
+                return "Meshes";
+            case TEXTURE:
+                return "Textures";
+            case TEXTURE_ARRAY:
+                return "Texture arrays";
+            case RENDER_TARGET:
+                return "Render targets";
+            default:
+                return "Staging";
+        }
+    }
+
+    //converts bytes to megabytes for the report
+    static double toMegabytes(long long bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    //writes the resident memory of every category and every asset to the log, largest first
+    void report() {
+        if (budgetBytes > 0) {
+            LOG_INFO("RESIDENCY", "[RESIDENCY] {.1} MB resident of a {.1} MB budget (peak {.1} MB)", toMegabytes(totalBytes), toMegabytes(budgetBytes), toMegabytes(peakBytes));
+        }
+        else {
+            LOG_INFO("RESIDENCY", "[RESIDENCY] {.1} MB resident (peak {.1} MB)", toMegabytes(totalBytes), toMegabytes(peakBytes));
+        }
+
+        for (int i = 0; i < CATEGORY_COUNT; i++) {
+            LOG_INFO("RESIDENCY", "[RESIDENCY]   {}: {.1} MB", categoryName(i), toMegabytes(categoryBytes[i]));
+        }
+
+        std::vector<std::pair<long long, int>> order;
+        for (std::map<int, Allocation>::iterator it = allocations.begin(); it != allocations.end(); ++it) {
+            order.push_back(std::make_pair(it->second.bytes, it->first));
+        }
+        std::sort(order.rbegin(), order.rend());
+
+        for (int i = 0; i < order.size(); i++) {
+            Allocation& allocation = allocations[order[i].second];
+            LOG_INFO("RESIDENCY", "[RESIDENCY]   {.2} MB  {}{}", toMegabytes(allocation.bytes), allocation.name, allocation.isShared ? " (in a texture array)" : "");
+        }
+    }
+};
@@ -3,46 +3,165 @@
 class Shader {
 public:
     GLuint shaderProgram; //id of the shader
+    GLuint vertexShader; //id of the compiled vertex shader, 0 once the program is finished
+    GLuint fragmentShader; //id of the compiled fragment shader, 0 once the program is finished
+    ProgramCache* cache; //cache the linked program is saved to, NULL if programs are not cached
+    unsigned long long cacheKey; //key of the program in the cache
+    bool isPending; //checks if the program was linked but its status was not checked yet
+    bool isLinked; //checks if the program linked without errors
 
     //constructor for the shader class with the path to the vertex and fragment files as parameters
-    Shader(std::string vertPath, std::string fragPath) {
-        //load vertex shader file
-        std::fstream vertSrc(vertPath);
-        std::stringstream vertBuff;
-        vertBuff << vertSrc.rdbuf(); //add the file stream to the string stream
-        std::string vertString = vertBuff.str(); //convert stream to a character array
-        const char* v = vertString.c_str();
+    //
+    //both files are run through the preprocessor with the defines of the variant. the program is loaded from the cache
+    //when possible, otherwise it is compiled and linked without waiting for the result, so that a driver with parallel
+    //shader compilation works on it in the background until finish() is called
+    Shader(std::string vertPath, std::string fragPath, ProgramCache* cache = NULL, const ShaderDefines& defines = ShaderDefines()) {
+        PROFILE_ZONE("Shader::Shader");
+
+        this->cache = cache;
+        cacheKey = 0;
+        vertexShader = 0;
+        fragmentShader = 0;
+        isPending = false;
+        isLinked = false;
 
-        //load fragment shader file
-        std::fstream fragSrc(fragPath);
-        std::stringstream fragBuff;
-        fragBuff << fragSrc.rdbuf(); //add the file stream to the string stream
-        std::string fragString = fragBuff.str(); //convert stream to a character array
+        //load the vertex and fragment shader files with their includes
+        ShaderPreprocessor preprocessor;
+        std::string vertString = preprocessor.process(vertPath, defines);
+        std::string fragString = preprocessor.process(fragPath, defines);
+        const char* v = vertString.c_str();
         const char* f = fragString.c_str();
 
+        //create the shader program
+        shaderProgram = glCreateProgram();
+
+        //reuse the binary saved by an earlier launch
+        if (cache) {
+            cacheKey = cache->keyOf(vertString, fragString);
+            if (cache->load(shaderProgram, cacheKey)) {
+                isLinked = true;
+                return;
+            }
+        }
+
         //create a vertex shader
-        GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+        vertexShader = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertexShader, 1, &v, NULL); //assign the source to the vertex shader
         glCompileShader(vertexShader); //compile the vertex shader
 
         //create a fragment shader
-        GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
         glShaderSource(fragmentShader, 1, &f, NULL);  //assign the source to the fragment shader
         glCompileShader(fragmentShader); //compile the fragment shader
 
-        //create the shader program
-        shaderProgram = glCreateProgram();
         glAttachShader(shaderProgram, vertexShader); //attach the compiled vertex shader
         glAttachShader(shaderProgram, fragmentShader); //attach the compiled fragment shader
 
-        //finalize the compilation
+        //ask the driver to keep the binary so that it can be saved once the program is linked
+        if (cache && cache->isSupported) {
+            glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
+        //start the link, the status is checked in finish() so that the compile does not stall this thread
         glLinkProgram(shaderProgram);
+        isPending = true;
+    }
+
+    //checks if the driver can compile shaders on its own threads
+    static bool isParallelCompileSupported() {
+        return GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+    }
+
+    //lets the driver use as many threads as it wants for the shaders that are compiled after this call
+    static void startCompilerThreads() {
+        if (GLAD_GL_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        }
+        else if (GLAD_GL_ARB_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        }
+    }
+
+    //checks if finish() would return without waiting for the driver
+    bool isReady() {
+        if (!isPending || !isParallelCompileSupported()) {
+            return true;
+        }
+
+        GLint isComplete = GL_FALSE;
+        glGetProgramiv(shaderProgram, GL_COMPLETION_STATUS_KHR, &isComplete);
+        return isComplete == GL_TRUE;
+    }
+
+    //waits for the link, reports compile and link errors and saves the program to the cache
+    bool finish() {
+        if (!isPending) {
+            return isLinked;
+        }
+
+        PROFILE_ZONE("Shader::finish");
+
+        isPending = false;
+        bool isCompiled = checkCompileStatus(vertexShader, "vertex") & checkCompileStatus(fragmentShader, "fragment");
+
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linkStatus);
+        isLinked = linkStatus == GL_TRUE;
+
+        if (!isLinked && isCompiled) {
+            char infoLog[1024];
+            glGetProgramInfoLog(shaderProgram, sizeof(infoLog), NULL, infoLog);
+            LOG_ERROR("SHADER", "[SHADER] The program failed to link:");
+            logErrors(infoLog);
+        }
+
+        glDetachShader(shaderProgram, vertexShader);
+        glDetachShader(shaderProgram, fragmentShader);
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
+        vertexShader = 0;
+        fragmentShader = 0;
+
+        if (isLinked && cache) {
+            cache->store(shaderProgram, cacheKey);
+        }
+
+        return isLinked;
+    }
+
+    //checks if a shader compiled and logs its errors if it did not
+    static bool checkCompileStatus(GLuint shader, const char* stage) {
+        GLint isCompiled = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+        if (isCompiled == GL_TRUE) {
+            return true;
+        }
+
+        char infoLog[1024];
+        glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+        LOG_ERROR("SHADER", "[SHADER] The {} shader failed to compile:", stage);
+        logErrors(infoLog);
+        return false;
+    }
+
+    //logs an info log one line per record since a record only holds a short text
+    static void logErrors(const char* infoLog) {
+        std::istringstream lines(infoLog);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (!line.empty()) {
+                LOG_ERROR("SHADER", "    {}", line);
+            }
+        }
+    }
+
+    //deletes the program
+    void destroy() {
+        glDeleteProgram(shaderProgram);
     }
 
     //loads the current program as the shader
     void useProgram() {
         glUseProgram(shaderProgram);
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+//ShaderDefines class stores the feature defines that select a variant of a shader
+class ShaderDefines {
+public:
+    std::map<std::string, std::string> values; //value of every define, sorted by name so that the key is stable
+
+    //turns on a feature that the shader checks with #ifdef
+    ShaderDefines& enable(std::string name) {
+        values[name] = "1";
+        return *this;
+    }
+
+    //sets a define that the shader reads as a number, like a light count
+    ShaderDefines& set(std::string name, int value) {
+        values[name] = std::to_string(value);
+        return *this;
+    }
+
+    //returns a text that is the same for the same set of defines
+    std::string toKey() const {
+        std::string key;
+        for (std::map<std::string, std::string>::const_iterator it = values.begin(); it != values.end(); ++it) {
+            key += it->first + "=" + it->second + ";";
+        }
+        return key;
+    }
+
+    //returns the #define lines placed after the #version line
+    std::string toSource() const {
+        std::string source;
+        for (std::map<std::string, std::string>::const_iterator it = values.begin(); it != values.end(); ++it) {
+            source += "#define " + it->first + " " + it->second + "\n";
+        }
+        return source;
+    }
+};
+
+//ShaderPreprocessor class turns a shader file into the source given to the driver
+//
+//glsl has no #include, so the included files are pasted in place, each at most once. the defines of the variant are
+//placed right after the #version line since nothing else may come before it. every pasted file gets its own source
+//string number in the #line directives, so "1:12(3): error" in a compile log points to line 12 of files[1].
+class ShaderPreprocessor {
+public:
+    std::vector<std::string> files; //files that were read, the index is the source string number of the file
+
+    //reads a shader file and its includes, returns an empty string if a file is missing
+    std::string process(std::string path, const ShaderDefines& defines) {
+        PROFILE_ZONE("ShaderPreprocessor::process");
+
+        files.clear();
+        std::string source;
+        if (!append(path, defines, true, source)) {
+            return "";
+        }
+        return source;
+    }
+
+    //pastes a file into the source, the root file also receives the defines
+    bool append(std::string path, const ShaderDefines& defines, bool isRoot, std::string& source) {
+        std::ifstream file(path);
+        if (!file) {
+            LOG_ERROR("SHADER", "[SHADER] Unable to read {}", path);
+            return false;
+        }
+
+        int sourceNumber = files.size();
+        files.push_back(path);
+        std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+
+        if (!isRoot) {
+            source += lineDirective(1, sourceNumber);
+        }
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+
+            //skip the indentation before a directive
+            size_t start = line.find_first_not_of(" \t");
+            bool isDirective = start != std::string::npos && line[start] == '#';
+
+            if (isDirective && isRoot && line.compare(start, 8, "#version") == 0) {
+                source += line + "\n";
+                source += defines.toSource();
+                source += lineDirective(lineNumber + 1, sourceNumber);
+                continue;
+            }
+
+            if (isDirective && line.compare(start, 8, "#include") == 0) {
+                size_t open = line.find('"', start);
+                size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+                if (close == std::string::npos) {
+                    LOG_ERROR("SHADER", "[SHADER] {}:{} expects #include \"file\"", path, lineNumber);
+                    return false;
+                }
+
+                //every file is pasted once, like a header with #pragma once
+                std::string includePath = directory + line.substr(open + 1, close - open - 1);
+                if (std::find(files.begin(), files.end(), includePath) == files.end()) {
+                    if (!append(includePath, defines, false, source)) {
+                        return false;
+                    }
+                }
+                source += lineDirective(lineNumber + 1, sourceNumber);
+                continue;
+            }
+
+            source += line + "\n";
+        }
+
+        return true;
+    }
+
+    //makes the compiler report the lines after this one as the given line of the given file
+    static std::string lineDirective(int lineNumber, int sourceNumber) {
+        return "#line " + std::to_string(lineNumber) + " " + std::to_string(sourceNumber) + "\n";
+    }
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+//ShaderVariants class compiles a pair of shader files once for every set of feature defines that is requested
+//
+//features that do not change during a draw are chosen with #ifdef instead of a uniform, so the fragment shader of a
+//variant has no branch for them. the variants are kept by the key of their defines and created on first use, and
+//callers that draw every frame keep the returned pointer instead of looking it up again.
+class ShaderVariants {
+public:
+    std::string vertPath; //vertex shader file shared by the variants
+    std::string fragPath; //fragment shader file shared by the variants
+    ProgramCache* cache; //cache the variants are loaded from, NULL if programs are not cached
+    std::map<std::string, Shader*> variants; //compiled variants by the key of their defines
+
+    //constructor for the shader variants class
+    ShaderVariants(std::string vertPath, std::string fragPath, ProgramCache* cache) {
+        this->vertPath = vertPath;
+        this->fragPath = fragPath;
+        this->cache = cache;
+    }
+
+    //destructor for the shader variants class
+    ~ShaderVariants() {
+        for (std::map<std::string, Shader*>::iterator it = variants.begin(); it != variants.end(); ++it) {
+            it->second->destroy();
+            delete it->second;
+        }
+    }
+
+    //returns the variant with the given defines, it is compiled the first time it is requested
+    Shader* get(const ShaderDefines& defines) {
+        std::string key = defines.toKey();
+        std::map<std::string, Shader*>::iterator it = variants.find(key);
+        if (it != variants.end()) {
+            return it->second;
+        }
+
+        Shader* shader = new Shader(vertPath, fragPath, cache, defines);
+        variants[key] = shader;
+        return shader;
+    }
+
+    //waits for the variants that are still linking and reports their errors
+    bool finish() {
+        bool isLinked = true;
+        for (std::map<std::string, Shader*>::iterator it = variants.begin(); it != variants.end(); ++it) {
+            if (!it->second->finish()) {
+                LOG_ERROR("SHADER", "[SHADER] Variant \"{}\" of {} is unusable", it->first, fragPath);
+                isLinked = false;
+            }
+        }
+        return isLinked;
+    }
+};
@@ -1,4 +1,5 @@
 #include "Shader.h"
+#include "ImageData.h"
 #pragma once
 
 //Model3D class stores the transformation properties of a model
@@ -6,25 +7,52 @@ class Skybox {
 public:
     std::vector<std::string> faces; //contains the vertex data (vertex, normal, and texture coordinates)
     GLuint VAO, VBO, EBO, texture; //vao, vbo, ebo, and texture id of the model
+    std::vector<ImageData> faceImages; //decoded faces that are uploaded to the cubemap
+    int meshAllocation; //id of the cube buffers in the residency manager
+    int textureAllocation; //id of the cubemap in the residency manager
 
     //constructor for the model class
     Skybox(std::string skyboxRt, std::string skyboxLf, std::string skyboxUp, std::string skyboxDn, std::string skyboxFt, std::string skyboxBk) {
         //sets the value of the class attributes
         faces = { skyboxRt, skyboxLf, skyboxUp, skyboxDn, skyboxFt, skyboxBk };
-
-        loadObject();
+        faceImages.resize(faces.size());
+        VAO = VBO = EBO = texture = 0;
+        meshAllocation = ResidencyManager::NO_ALLOCATION;
+        textureAllocation = ResidencyManager::NO_ALLOCATION;
     }
 
     //destructor for the model class
     ~Skybox() {
-        //delete vertex arrays and buffers
+        //delete vertex arrays, buffers, and the cubemap
         glDeleteVertexArrays(1, &VAO);
-        glDeleteVertexArrays(1, &VBO);
-        glDeleteVertexArrays(1, &EBO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &EBO);
+        glDeleteTextures(1, &texture);
+        ResidencyManager::instance().release(meshAllocation);
+        ResidencyManager::instance().release(textureAllocation);
+    }
+
+    //decodes the image of a face and copies it into the upload ring if one is given, this does not call opengl so the
+    //faces can be decoded on different threads
+    void decodeFace(int index, UploadRing* uploadRing = NULL) {
+        PROFILE_ZONE("Skybox::decodeFace");
+
+        //cubemaps are not flipped
+        faceImages[index].decode(faces[index], false);
+        faceImages[index].stage(uploadRing);
     }
 
-    //load the vertex attributes from the obj file
-    void loadObject() {
+    //decodes the images of every face on the calling thread
+    void decodeFaces(UploadRing* uploadRing = NULL) {
+        for (int i = 0; i < faces.size(); i++) {
+            decodeFace(i, uploadRing);
+        }
+    }
+
+    //creates the cube and the cubemap from the decoded faces, must be called on the thread that owns the context
+    void upload(UploadRing* uploadRing = NULL) {
+        PROFILE_ZONE("Skybox::upload");
+
         //vertices for the skybox cube
         float skyboxVertices[]{
             -1.f, -1.f, 1.f, //0
@@ -85,6 +113,8 @@ public:
         glBindBuffer(GL_ARRAY_BUFFER, 0); //finish modifying the vbo
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //finish modifying the ebo
 
+        meshAllocation = ResidencyManager::instance().track(ResidencyManager::MESH, "Skybox cube", sizeof(skyboxVertices) + sizeof(skyboxIndices));
+
         //initialize textures
         glGenTextures(1, &texture);
         //initialize the texture as a cubemap
@@ -99,23 +129,16 @@ public:
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
+        long long cubemapBytes = 0;
         for (unsigned int i = 0; i < 6; i++) {
 
-            //temporarily disable image flipping
-            stbi_set_flip_vertically_on_load(false);
-
-            int img_width, img_height, color_channels;
-            //load the texture and fill out the variables
-            unsigned char* tex_bytes = stbi_load(
-                faces[i].c_str(),
-                &img_width,
-                &img_height,
-                &color_channels,
-                0
-            );
+            int img_width = faceImages[i].width, img_height = faceImages[i].height;
 
             //if texture is loaded properly
-            if (tex_bytes) {
+            if (faceImages[i].hasPixels()) {
+                //the pixels are read from the upload ring if they were staged there
+                const void* tex_bytes = faceImages[i].bindPixels();
+
                 //assign the loaded texture
                 glTexImage2D(
                     GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
@@ -129,13 +152,16 @@ public:
                     tex_bytes
                 );
 
+                //rgb faces are counted with 4 bytes per texel since drivers pad them
+                cubemapBytes += ResidencyManager::textureBytes(img_width, img_height, 4, false);
+
                 //free up the loaded bytes
-                stbi_image_free(tex_bytes);
+                faceImages[i].release(uploadRing);
             }
         }
+        faceImages.clear();
 
-        //reenable image flipping
-        stbi_set_flip_vertically_on_load(true);
+        textureAllocation = ResidencyManager::instance().track(ResidencyManager::TEXTURE, "Skybox cubemap", cubemapBytes);
     }
 
     //set the value of the projection matrix in the shader
@@ -172,12 +198,8 @@ public:
     void draw(Shader shader) {
 
         shader.useProgram();
-        
-        //disable depth mask
-        glDepthMask(GL_FALSE);
 
-        //change the depth function to <=
-        glDepthFunc(GL_LEQUAL);
+        //the pass that draws the skybox turns off the depth writes and tests with <=, so it stays behind the models
 
         //use the vao of the skybox
         glBindVertexArray(VAO);
@@ -189,11 +211,5 @@ public:
 
         //draw the skybox
         glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-
-        //reset depth testing to true
-        glDepthMask(GL_TRUE);
-
-        //reset depth function to normal
-        glDepthFunc(GL_LESS);
     }
 };
\ No newline at end of file
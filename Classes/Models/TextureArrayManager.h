@@ -0,0 +1,314 @@
+#pragma once
+
+//identifies the layer of a texture array that a texture was placed in
+struct TextureLayer {
+    GLuint texture; //id of the GL_TEXTURE_2D_ARRAY, 0 if the texture was not placed
+    int layer; //index of the layer in the array
+};
+
+//TextureArrayManager class places textures as layers of GL_TEXTURE_2D_ARRAY objects so that models share one binding
+//
+//every layer has the same size and format (RGBA8), so images of a different size or channel count are converted and
+//resampled on the cpu before they are uploaded. an array holds a fixed number of layers since opengl 3.3 cannot grow
+//a texture in place; another array is created when it is full. layers of removed textures are reused before a new
+//array is created, and an array is deleted once none of its layers is used. images that could not be read get a
+//black layer, which is what sampling the incomplete texture used to give.
+//
+//the mipmaps of a layer are also built on the cpu by the thread that prepares it, so adding a layer only copies the
+//prepared levels instead of regenerating the mipmaps of the whole array.
+//
+//a layer can be demoted to an array with half the size by copying its mipmaps one level up on the gpu, which frees
+//the memory of the full size level once its old array is empty. this needs ARB_copy_image (opengl 4.3).
+class TextureArrayManager {
+public:
+    static const int MIN_LAYER_SIZE = 128; //layers are not demoted below this size
+
+    //stores a texture array and how many of its layers are used
+    struct ArrayTexture {
+        GLuint texture; //id of the texture array
+        int size; //width and height of the layers of the array
+        int layerCount; //number of layers that were handed out, including the ones that were freed again
+        int usedCount; //number of layers that hold a texture
+        int allocation; //id of the array in the residency manager
+    };
+
+    int layerSize; //width and height of the layers that textures are added with
+    int layersPerArray; //number of layers allocated for each array
+    int levelCount; //number of mipmap levels of a layer, down to 1x1
+    long long layerBytes; //size of a prepared layer with all of its levels
+    std::vector<ArrayTexture> arrays; //arrays that were created, a new layer is placed in the last one of its size
+    std::vector<TextureLayer> freeLayers; //layers of removed textures that can be overwritten
+
+    //constructor for the texture array manager class
+    TextureArrayManager(int layerSize, int layersPerArray) {
+        this->layerSize = layerSize;
+        this->layersPerArray = layersPerArray;
+
+        levelCount = 0;
+        layerBytes = 0;
+        for (int size = layerSize; size > 0; size /= 2) {
+            layerBytes += (long long)size * size * 4;
+            levelCount++;
+        }
+    }
+
+    //destructor for the texture array manager class
+    ~TextureArrayManager() {
+        for (int i = 0; i < arrays.size(); i++) {
+            glDeleteTextures(1, &arrays[i].texture);
+            ResidencyManager::instance().release(arrays[i].allocation);
+        }
+    }
+
+    //returns the number of mipmap levels of a layer with the given size
+    static int levelCountOf(int size) {
+        int count = 0;
+        for (; size > 0; size /= 2) {
+            count++;
+        }
+        return count;
+    }
+
+    //creates an empty texture array with room for layersPerArray layers of the given size and all of their levels
+    ArrayTexture createArray(int size) {
+        ArrayTexture array;
+        array.size = size;
+        array.layerCount = 0;
+        array.usedCount = 0;
+
+        int levels = levelCountOf(size);
+        glGenTextures(1, &array.texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array.texture);
+        for (int level = 0; level < levels; level++) {
+            int mipSize = glm::max(size >> level, 1);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, mipSize, mipSize, layersPerArray, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        std::string name = "Texture array " + std::to_string(size) + "x" + std::to_string(size) + "x" + std::to_string(layersPerArray);
+        array.allocation = ResidencyManager::instance().track(ResidencyManager::TEXTURE_ARRAY, name, ResidencyManager::textureBytes(size, size, 4, true) * layersPerArray);
+        return array;
+    }
+
+    //returns the width and height of a mipmap level of the layers that textures are added with
+    int levelSize(int level) {
+        return glm::max(layerSize >> level, 1);
+    }
+
+    //returns the index of the array that holds a layer, -1 if the layer is not in any array
+    int findArray(GLuint texture) {
+        for (int i = 0; i < arrays.size(); i++) {
+            if (arrays[i].texture == texture) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    //returns the width and height of a layer, 0 if the layer is not in any array
+    int sizeOf(TextureLayer layer) {
+        int index = findArray(layer.texture);
+        return index < 0 ? 0 : arrays[index].size;
+    }
+
+    //hands out an unused layer of the given size, reusing a freed one if there is one
+    TextureLayer allocateLayer(int size) {
+        TextureLayer layer;
+        for (int i = freeLayers.size() - 1; i >= 0; i--) {
+            if (sizeOf(freeLayers[i]) == size) {
+                layer = freeLayers[i];
+                freeLayers.erase(freeLayers.begin() + i);
+                arrays[findArray(layer.texture)].usedCount++;
+                return layer;
+            }
+        }
+
+        int index = -1;
+        for (int i = arrays.size() - 1; i >= 0; i--) {
+            if (arrays[i].size == size && arrays[i].layerCount < layersPerArray) {
+                index = i;
+                break;
+            }
+        }
+        if (index < 0) {
+            arrays.push_back(createArray(size));
+            index = arrays.size() - 1;
+        }
+
+        ArrayTexture& array = arrays[index];
+        layer.texture = array.texture;
+        layer.layer = array.layerCount;
+        array.layerCount++;
+        array.usedCount++;
+        return layer;
+    }
+
+    //uploads a layer that was prepared in a staging block into the next free layer, the block is handed back to the ring
+    //once the upload was issued
+    TextureLayer add(StagingBlock& block, UploadRing& uploadRing) {
+        PROFILE_ZONE("TextureArrayManager::add");
+
+        TextureLayer layer = allocateLayer(layerSize);
+        const char* pixels = (const char*)block.bind();
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, layer.texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        long long offset = 0;
+        for (int level = 0; level < levelCount; level++) {
+            int size = levelSize(level);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer.layer, size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels + offset);
+            offset += (long long)size * size * 4;
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        uploadRing.submit(block);
+        return layer;
+    }
+
+    //checks if a layer can be demoted to half its size
+    bool canDemote(TextureLayer layer) {
+        return (GLAD_GL_ARB_copy_image || GLAD_GL_VERSION_4_3) && sizeOf(layer) / 2 >= MIN_LAYER_SIZE;
+    }
+
+    //copies a layer without its largest level into a layer of half the size and returns the new layer, the old layer
+    //is still valid and has to be removed once nothing samples it anymore
+    TextureLayer demote(TextureLayer layer) {
+        PROFILE_ZONE("TextureArrayManager::demote");
+
+        int size = sizeOf(layer) / 2;
+        TextureLayer demoted = allocateLayer(size);
+
+        int levels = levelCountOf(size);
+        for (int level = 0; level < levels; level++) {
+            int mipSize = glm::max(size >> level, 1);
+            glCopyImageSubData(layer.texture, GL_TEXTURE_2D_ARRAY, level + 1, 0, 0, layer.layer,
+                demoted.texture, GL_TEXTURE_2D_ARRAY, level, 0, 0, demoted.layer, mipSize, mipSize, 1);
+        }
+        return demoted;
+    }
+
+    //frees a layer so that the next texture that is added overwrites it, nothing may sample the layer afterwards
+    void remove(TextureLayer layer) {
+        int index = findArray(layer.texture);
+        if (index < 0) {
+            return;
+        }
+
+        ArrayTexture& array = arrays[index];
+        array.usedCount--;
+        if (array.usedCount > 0) {
+            freeLayers.push_back(layer);
+            return;
+        }
+
+        //delete the array once it is empty, together with the layers of it that were waiting to be reused
+        for (int i = freeLayers.size() - 1; i >= 0; i--) {
+            if (freeLayers[i].texture == array.texture) {
+                freeLayers.erase(freeLayers.begin() + i);
+            }
+        }
+        glDeleteTextures(1, &array.texture);
+        ResidencyManager::instance().release(array.allocation);
+        arrays.erase(arrays.begin() + index);
+    }
+
+    //writes an image as a layer followed by its mipmaps, this does not call opengl so it can run on any thread
+    void prepare(ImageData& image, std::vector<unsigned char>& pixels) {
+        PROFILE_ZONE("TextureArrayManager::prepare");
+
+        pixels.resize(layerBytes);
+        convert(image, pixels.data());
+
+        //each level averages 2x2 texels of the level before it
+        unsigned char* source = pixels.data();
+        for (int level = 1; level < levelCount; level++) {
+            int sourceSize = levelSize(level - 1);
+            int size = levelSize(level);
+            unsigned char* target = source + (long long)sourceSize * sourceSize * 4;
+
+            for (int y = 0; y < size; y++) {
+                int y0 = glm::min(y * 2, sourceSize - 1);
+                int y1 = glm::min(y * 2 + 1, sourceSize - 1);
+
+                for (int x = 0; x < size; x++) {
+                    int x0 = glm::min(x * 2, sourceSize - 1);
+                    int x1 = glm::min(x * 2 + 1, sourceSize - 1);
+
+                    for (int c = 0; c < 4; c++) {
+                        int sum = source[(y0 * sourceSize + x0) * 4 + c] + source[(y0 * sourceSize + x1) * 4 + c] +
+                            source[(y1 * sourceSize + x0) * 4 + c] + source[(y1 * sourceSize + x1) * 4 + c];
+                        target[(y * size + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+                    }
+                }
+            }
+
+            source = target;
+        }
+    }
+
+    //writes the pixels of an image as RGBA at the size of a layer, resampling it bilinearly if the size differs
+    void convert(ImageData& image, unsigned char* pixels) {
+        long long pixelBytes = (long long)layerSize * layerSize * 4;
+
+        //images that already match the layers are copied as is
+        if (image.bytes != NULL && image.width == layerSize && image.height == layerSize && image.channels == 4) {
+            std::copy(image.bytes, image.bytes + pixelBytes, pixels);
+            return;
+        }
+
+        //leave the layer black if the image could not be read
+        if (image.bytes == NULL || image.width <= 0 || image.height <= 0) {
+            for (long long i = 0; i < pixelBytes; i++) {
+                pixels[i] = i % 4 == 3 ? 255 : 0;
+            }
+            return;
+        }
+
+        float xScale = (float)image.width / layerSize;
+        float yScale = (float)image.height / layerSize;
+
+        for (int y = 0; y < layerSize; y++) {
+            //sample at the center of the destination texel
+            float sourceY = glm::clamp((y + 0.5f) * yScale - 0.5f, 0.0f, (float)(image.height - 1));
+            int y0 = (int)sourceY;
+            int y1 = glm::min(y0 + 1, image.height - 1);
+            float yFactor = sourceY - y0;
+
+            for (int x = 0; x < layerSize; x++) {
+                float sourceX = glm::clamp((x + 0.5f) * xScale - 0.5f, 0.0f, (float)(image.width - 1));
+                int x0 = (int)sourceX;
+                int x1 = glm::min(x0 + 1, image.width - 1);
+                float xFactor = sourceX - x0;
+
+                glm::vec4 top = glm::mix(readTexel(image, x0, y0), readTexel(image, x1, y0), xFactor);
+                glm::vec4 bottom = glm::mix(readTexel(image, x0, y1), readTexel(image, x1, y1), xFactor);
+                glm::vec4 color = glm::mix(top, bottom, yFactor);
+
+                unsigned char* texel = &pixels[(y * layerSize + x) * 4];
+                for (int c = 0; c < 4; c++) {
+                    texel[c] = (unsigned char)glm::clamp(color[c] + 0.5f, 0.0f, 255.0f);
+                }
+            }
+        }
+    }
+
+    //reads a texel of an image with 1 to 4 channels as RGBA
+    static glm::vec4 readTexel(ImageData& image, int x, int y) {
+        unsigned char* texel = image.bytes + (y * image.width + x) * image.channels;
+
+        switch (image.channels) {
+            case 1:
+                return glm::vec4(texel[0], texel[0], texel[0], 255.0f);
+            case 2:
+                return glm::vec4(texel[0], texel[0], texel[0], texel[1]);
+            case 3:
+                return glm::vec4(texel[0], texel[1], texel[2], 255.0f);
+            default:
+                return glm::vec4(texel[0], texel[1], texel[2], texel[3]);
+        }
+    }
+};
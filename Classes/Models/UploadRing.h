@@ -0,0 +1,233 @@
+#pragma once
+
+//a range of staging memory that pixels are written to before they are uploaded
+struct StagingBlock {
+    GLuint buffer; //pixel unpack buffer that holds the block, 0 if the block is in client memory
+    unsigned char* mapped; //start of the block in the mapped buffer, NULL if the block is in client memory
+    long long offset; //offset of the block in the buffer
+    long long size; //number of bytes in the block
+    std::vector<unsigned char> memory; //bytes of a block that is not in a buffer
+
+    //constructor for the staging block struct
+    StagingBlock() {
+        buffer = 0;
+        mapped = NULL;
+        offset = 0;
+        size = 0;
+    }
+
+    //keeps the bytes in client memory, used when no buffer has room for them
+    void assignClient(std::vector<unsigned char>& bytes) {
+        buffer = 0;
+        mapped = NULL;
+        offset = 0;
+        size = bytes.size();
+        memory.swap(bytes);
+    }
+
+    //returns where the bytes of the block are written
+    unsigned char* getData() {
+        return mapped ? mapped : memory.data();
+    }
+
+    //binds the buffer of the block and returns the pointer that the upload calls read the block from
+    const void* bind() {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        if (buffer == 0) {
+            return memory.data();
+        }
+        return (const void*)(intptr_t)offset;
+    }
+};
+
+//UploadRing class is a pixel unpack buffer that stays mapped so that loading threads can write pixels into it
+//
+//a texture upload from client memory makes the driver copy the pixels on the thread that owns the context before the
+//call returns. the ring is mapped once with GL_MAP_PERSISTENT_BIT, so the threads that decode the images copy the
+//pixels into it themselves and the upload only passes an offset into the buffer. blocks are handed out in order and
+//a fence placed after the upload of a block tells when the gpu has read it and the block can be reused. without
+//ARB_buffer_storage the ring is not created and every block is placed in client memory.
+class UploadRing {
+public:
+    static const int ALIGNMENT = 256; //blocks start at a multiple of this many bytes
+
+    //a block that was handed out and is not free yet
+    struct Region {
+        long long start; //first byte of the region
+        long long end; //one past the last byte, this includes the unused bytes before a wrap
+        GLsync fence; //signals when the gpu has read the block, NULL until the block was submitted
+        bool isSubmitted; //checks if the upload of the block was issued
+    };
+
+    GLuint buffer; //id of the pixel unpack buffer, 0 if the ring is not supported
+    unsigned char* mapped; //pointer to the mapped buffer
+    long long capacity; //size of the buffer in bytes
+    long long head; //offset where the next block is placed
+    std::deque<Region> regions; //blocks that are in use, oldest first
+    std::mutex mutex; //guards the regions since blocks are requested from several threads
+    std::condition_variable freed; //wakes the threads that wait for room
+    int allocation; //id of the buffer in the residency manager
+
+    //constructor for the upload ring class, must be called on the thread that owns the context
+    UploadRing(long long capacity) {
+        this->capacity = capacity;
+        buffer = 0;
+        mapped = NULL;
+        head = 0;
+        allocation = ResidencyManager::NO_ALLOCATION;
+
+        if (!GLAD_GL_ARB_buffer_storage && !GLAD_GL_VERSION_4_4) {
+            LOG_WARNING("UPLOAD", "[UPLOAD] Persistent buffers are not supported, textures are uploaded from client memory");
+            return;
+        }
+
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, capacity, NULL, flags);
+        mapped = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, capacity, flags);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (mapped == NULL) {
+            LOG_WARNING("UPLOAD", "[UPLOAD] Unable to map the upload ring, textures are uploaded from client memory");
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+            return;
+        }
+
+        allocation = ResidencyManager::instance().track(ResidencyManager::STAGING, "Upload ring", capacity);
+    }
+
+    //destructor for the upload ring class, the uploads that read from the ring must have been issued
+    ~UploadRing() {
+        for (int i = 0; i < regions.size(); i++) {
+            if (regions[i].fence) {
+                glDeleteSync(regions[i].fence);
+            }
+        }
+
+        if (buffer) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &buffer);
+            ResidencyManager::instance().release(allocation);
+        }
+    }
+
+    //checks if blocks can be placed in the ring
+    bool isSupported() {
+        return buffer != 0;
+    }
+
+    //hands out a block of the ring, waiting up to the timeout for the gpu to free enough of it
+    //
+    //returns false if the block does not fit in time, the caller then places it in client memory. this can be called
+    //on any thread, but the thread that owns the context must not wait since it is the one that frees the blocks.
+    bool allocate(long long size, StagingBlock& block, std::chrono::milliseconds timeout) {
+        if (!isSupported() || size <= 0 || size > capacity) {
+            return false;
+        }
+
+        long long alignedSize = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        long long offset;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!freed.wait_for(lock, timeout, [&]() { return reserve(alignedSize, offset); })) {
+            return false;
+        }
+
+        Region region;
+        region.start = offset;
+        region.end = offset + alignedSize;
+        region.fence = NULL;
+        region.isSubmitted = false;
+        regions.push_back(region);
+        head = region.end;
+
+        block.buffer = buffer;
+        block.mapped = mapped + offset;
+        block.offset = offset;
+        block.size = size;
+        block.memory.clear();
+        return true;
+    }
+
+    //finds room for a block after the newest one, wrapping to the start of the ring if the end is too short
+    bool reserve(long long size, long long& offset) {
+        if (regions.empty()) {
+            head = 0;
+            offset = 0;
+            return true;
+        }
+
+        long long tail = regions.front().start;
+        if (head >= tail) {
+            if (head + size <= capacity) {
+                offset = head;
+                return true;
+            }
+
+            //the block must end before the oldest region, otherwise a full ring would look empty
+            if (size < tail) {
+                regions.back().end = capacity;
+                offset = 0;
+                return true;
+            }
+            return false;
+        }
+
+        if (head + size < tail) {
+            offset = head;
+            return true;
+        }
+        return false;
+    }
+
+    //places a fence after the uploads that read the block so that it is freed once the gpu is done with it
+    void submit(StagingBlock& block) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (block.buffer != buffer || block.mapped == NULL) {
+            return;
+        }
+
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < regions.size(); i++) {
+            if (regions[i].start == block.offset && !regions[i].isSubmitted) {
+                regions[i].fence = fence;
+                regions[i].isSubmitted = true;
+                break;
+            }
+        }
+        block.mapped = NULL;
+    }
+
+    //frees the oldest blocks that the gpu has finished reading, called once per frame on the thread that owns the context
+    void retire() {
+        if (!isSupported()) {
+            return;
+        }
+
+        bool isFreed = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (!regions.empty() && regions.front().isSubmitted) {
+                //the flush makes sure that the fence reaches the gpu even if nothing else is submitted
+                GLenum status = glClientWaitSync(regions.front().fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+                if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                    break;
+                }
+
+                glDeleteSync(regions.front().fence);
+                regions.pop_front();
+                isFreed = true;
+            }
+        }
+
+        if (isFreed) {
+            freed.notify_all();
+        }
+    }
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+//VertexAnimation class stores an animation clip baked into a texture that the vertex shader reads (vertex animation texture)
+//
+//every frame of the clip holds two texels per vertex of the mesh: the offset of the position from the rest pose and
+//the normal of the posed vertex. the texels of a frame follow each other in the order the vertices are drawn, so the
+//shader finds them from gl_VertexID and the frame, and wraps the long row into a texture that is TEXTURE_WIDTH wide.
+//posing a vertex is two texel fetches and a blend on the gpu, so an animated model costs the cpu nothing more than
+//setting the frame it is drawn at. the texels are half floats, which keeps the texture at 16 bytes per vertex per
+//frame. the baked texels are kept after the upload like the vertex data, so that the texture can be made again after
+//the mesh was evicted.
+//
+//the models of the world come without rigs or clips, so the swimming clip is generated: a wave travels from the head
+//to the tail and bends the body sideways, growing toward the tail.
+class VertexAnimation {
+public:
+    static const int TEXTURE_WIDTH = 1024; //width of the texture the frames are wrapped into
+    static const int FRAME_COUNT = 24; //number of frames baked for a clip
+    static constexpr float CLIP_SECONDS = 1.5f; //length of a swimming stroke
+    static constexpr float SWIM_AMPLITUDE = 0.06f; //sideways movement of the tail as a fraction of the body length
+    static constexpr float SWIM_WAVES = 0.8f; //number of waves along the body at once
+
+    std::vector<glm::uint64> texels; //offset and normal of every vertex in every frame, as four half floats each
+    int vertexCount; //number of vertices in a frame
+    int frameCount; //number of frames in the clip
+    float framesPerSecond; //rate the clip is played at
+    GLuint texture; //id of the texture, 0 while it is not uploaded
+    int allocation; //id of the texture in the residency manager
+
+    //constructor for the vertex animation class
+    VertexAnimation(int vertexCount, int frameCount, float seconds) {
+        this->vertexCount = vertexCount;
+        this->frameCount = frameCount;
+        framesPerSecond = frameCount / seconds;
+        texture = 0;
+        allocation = ResidencyManager::NO_ALLOCATION;
+        texels.resize((size_t)vertexCount * frameCount * 2);
+    }
+
+    //destructor for the vertex animation class
+    ~VertexAnimation() {
+        destroy();
+    }
+
+    //bakes the swimming clip of a mesh from its vertex data, returns NULL if the mesh has no positions and normals
+    //
+    //the mesh is assumed to be y up with the body along whichever of x and z it is longer in. the head is taken to be
+    //the end that most of the vertices lie toward, since the head of a fish is thicker than its tail.
+    static VertexAnimation* bakeSwim(std::vector<GLfloat>& vertexData, int attribCount, std::vector<int>& attributeSizes) {
+        PROFILE_ZONE("VertexAnimation::bakeSwim");
+
+        if (vertexData.empty() || attribCount == 0 || attributeSizes.size() < 2 || attributeSizes[0] != 3 || attributeSizes[1] != 3) {
+            return NULL;
+        }
+
+        int vertexCount = vertexData.size() / attribCount;
+        VertexAnimation* animation = new VertexAnimation(vertexCount, FRAME_COUNT, CLIP_SECONDS);
+
+        //find the length of the body and which end is the head
+        glm::vec3 minimum(vertexData[0], vertexData[1], vertexData[2]);
+        glm::vec3 maximum = minimum, sum(0.0f);
+        for (int i = 0; i < vertexCount; i++) {
+            glm::vec3 position(vertexData[i * attribCount], vertexData[i * attribCount + 1], vertexData[i * attribCount + 2]);
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+            sum += position;
+        }
+
+        int bodyAxis = maximum.x - minimum.x >= maximum.z - minimum.z ? 0 : 2;
+        int sideAxis = 2 - bodyAxis;
+        float length = glm::max(maximum[bodyAxis] - minimum[bodyAxis], 0.0001f);
+        float centroid = sum[bodyAxis] / glm::max(vertexCount, 1);
+        bool isHeadAtMinimum = centroid - minimum[bodyAxis] < maximum[bodyAxis] - centroid;
+
+        for (int frame = 0; frame < FRAME_COUNT; frame++) {
+            float phase = glm::two_pi<float>() * frame / FRAME_COUNT;
+
+            for (int i = 0; i < vertexCount; i++) {
+                GLfloat* vertex = &vertexData[i * attribCount];
+                glm::vec3 normal(vertex[3], vertex[4], vertex[5]);
+
+                //distance from the head as a fraction of the body length
+                float along = (vertex[bodyAxis] - minimum[bodyAxis]) / length;
+                if (!isHeadAtMinimum) {
+                    along = 1.0f - along;
+                }
+
+                //the head barely moves and the tail sweeps the most
+                float envelope = 0.2f + 0.8f * along * along;
+                float wave = phase - glm::two_pi<float>() * SWIM_WAVES * along;
+                float offset = SWIM_AMPLITUDE * length * envelope * glm::sin(wave);
+
+                //slope of the bent body, which shears the normal the opposite way
+                float slope = SWIM_AMPLITUDE * (1.6f * along * glm::sin(wave) - envelope * glm::two_pi<float>() * SWIM_WAVES * glm::cos(wave));
+                if (!isHeadAtMinimum) {
+                    slope = -slope;
+                }
+                normal[bodyAxis] -= slope * normal[sideAxis];
+
+                glm::vec3 displacement(0.0f);
+                displacement[sideAxis] = offset;
+
+                size_t texel = ((size_t)frame * vertexCount + i) * 2;
+                animation->texels[texel] = glm::packHalf4x16(glm::vec4(displacement, 0.0f));
+                animation->texels[texel + 1] = glm::packHalf4x16(glm::vec4(glm::normalize(normal), 0.0f));
+            }
+        }
+
+        return animation;
+    }
+
+    //returns the number of rows of the texture
+    int getRowCount() {
+        return (int)((texels.size() + TEXTURE_WIDTH - 1) / TEXTURE_WIDTH);
+    }
+
+    //returns the size of the texture on the gpu
+    long long getBytes() {
+        return (long long)TEXTURE_WIDTH * getRowCount() * sizeof(glm::uint64);
+    }
+
+    //returns the frame of the clip at a point in time, the fraction blends toward the next frame
+    float frameAt(float seconds) {
+        float frame = std::fmod(seconds * framesPerSecond, (float)frameCount);
+        return frame < 0.0f ? frame + frameCount : frame;
+    }
+
+    //creates the texture from the baked texels, must be called on the thread that owns the context
+    //
+    //returns false if the clip has more rows than the driver allows, the model is then drawn in its rest pose
+    bool upload(std::string name) {
+        PROFILE_ZONE("VertexAnimation::upload");
+
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        if (getRowCount() > maxSize) {
+            LOG_WARNING("ANIMATION", "[ANIMATION] The clip of {} needs {} rows, more than the {} the driver allows", name, getRowCount(), (int)maxSize);
+            return false;
+        }
+
+        //the last row is only partly used, so the texels are padded to a whole row
+        texels.resize((size_t)TEXTURE_WIDTH * getRowCount());
+
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, TEXTURE_WIDTH, getRowCount(), 0, GL_RGBA, GL_HALF_FLOAT, texels.data());
+
+        //the shader reads single texels, so the texture has no mipmaps and is never filtered
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        allocation = ResidencyManager::instance().track(ResidencyManager::TEXTURE, name + " animation", getBytes());
+        return true;
+    }
+
+    //deletes the texture, the texels are kept so that upload can make it again
+    void destroy() {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+        ResidencyManager::instance().release(allocation);
+    }
+
+    //binds the texture to a texture unit and sets the uniforms that locate the vertices of a frame
+    void bind(Shader& shader, int unit, float frame) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glUniform1i(glGetUniformLocation(shader.shaderProgram, "animationTexture"), unit);
+        glUniform1i(glGetUniformLocation(shader.shaderProgram, "animationVertexCount"), vertexCount);
+        glUniform1i(glGetUniformLocation(shader.shaderProgram, "animationFrameCount"), frameCount);
+        glUniform1f(glGetUniformLocation(shader.shaderProgram, "animationFrame"), frame);
+    }
+};
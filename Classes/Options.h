@@ -0,0 +1,144 @@
+#pragma once
+
+//Options class stores the settings passed through the command line
+class Options {
+public:
+    bool isTracing; //checks if the cpu profiler records zones from the start
+    bool isHeadless; //checks if the program renders offscreen without creating a window
+    int width, height; //resolution of the offscreen framebuffer
+    int frameCount; //number of frames rendered in headless mode
+    std::string outputDirectory; //directory where the headless frames are written, empty if frames are not saved
+    bool isBenchmarking; //checks if the scripted flythrough benchmark is run instead of the interactive session
+    std::string benchmarkPath; //file that contains the camera path of the benchmark
+    std::string benchmarkOutput; //file where the benchmark results are written
+    int benchmarkFrames; //number of frames of the benchmark, 0 to cover the whole path
+    bool isBenchmarkingJobs; //checks if the job system microbenchmark is run instead of the program
+    bool isBenchmarkingTransforms; //checks if the transform kernel benchmark is run instead of the program
+    bool isCheckingRenderGraph; //checks if the render graph self-check is run instead of the program
+    bool isLateLatching; //checks if camera drags are applied to the view right before the frame is drawn
+    int maxFramesInFlight; //number of frames the gpu may fall behind the cpu, 0 to let the driver decide
+    std::string logFile; //file where every log record is written as a line of json, empty if no file is written
+    std::string shaderCacheDirectory; //directory where linked shader programs are saved, empty if they are not cached
+    int vramBudgetMegabytes; //gpu memory the allocations should stay under, 0 if there is no budget
+    bool isInterceptingGL; //checks if every gl call is counted to find redundant calls and uploads
+    std::string glCapturePath; //file where the gl calls are captured (a .gltrace file), empty if they are not captured
+    int glCaptureFrames; //number of frames captured after the setup
+    std::string replayPath; //gl trace that is replayed instead of running the program, empty to run the program
+    int replayLoops; //number of times the frames of the trace are replayed
+    std::string replayOutput; //file where the replay results are written
+
+    //constructor for the options class which parses the command line arguments
+    Options(int argc, char** argv) {
+        isTracing = false;
+        isHeadless = false;
+        width = (int)WIDTH;
+        height = (int)HEIGHT;
+        frameCount = 1;
+        outputDirectory = "";
+        isBenchmarking = false;
+        benchmarkPath = "Benchmarks/flythrough.txt";
+        benchmarkOutput = "benchmark.json";
+        benchmarkFrames = 0;
+        isBenchmarkingJobs = false;
+        isBenchmarkingTransforms = false;
+        isCheckingRenderGraph = false;
+        isLateLatching = true;
+        maxFramesInFlight = 0;
+        logFile = "";
+        shaderCacheDirectory = "ShaderCache";
+        vramBudgetMegabytes = 512;
+        isInterceptingGL = false;
+        glCapturePath = "";
+        glCaptureFrames = 60;
+        replayPath = "";
+        replayLoops = 10;
+        replayOutput = "replay.json";
+
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "--trace") {
+                isTracing = true;
+            }
+            else if (argument == "--headless") {
+                isHeadless = true;
+            }
+            else if (argument == "--width" && hasValue) {
+                width = glm::max(1, atoi(argv[++i]));
+            }
+            else if (argument == "--height" && hasValue) {
+                height = glm::max(1, atoi(argv[++i]));
+            }
+            else if (argument == "--frames" && hasValue) {
+                frameCount = glm::max(1, atoi(argv[++i]));
+            }
+            else if (argument == "--output-dir" && hasValue) {
+                outputDirectory = argv[++i];
+            }
+            else if (argument == "--benchmark") {
+                isBenchmarking = true;
+            }
+            else if (argument == "--benchmark-path" && hasValue) {
+                isBenchmarking = true;
+                benchmarkPath = argv[++i];
+            }
+            else if (argument == "--benchmark-frames" && hasValue) {
+                isBenchmarking = true;
+                benchmarkFrames = glm::max(1, atoi(argv[++i]));
+            }
+            else if (argument == "--benchmark-output" && hasValue) {
+                isBenchmarking = true;
+                benchmarkOutput = argv[++i];
+            }
+            else if (argument == "--bench-jobs") {
+                isBenchmarkingJobs = true;
+            }
+            else if (argument == "--bench-transforms") {
+                isBenchmarkingTransforms = true;
+            }
+            else if (argument == "--check-render-graph") {
+                isCheckingRenderGraph = true;
+            }
+            else if (argument == "--no-late-latch") {
+                isLateLatching = false;
+            }
+            else if (argument == "--max-frames-in-flight" && hasValue) {
+                maxFramesInFlight = glm::max(0, atoi(argv[++i]));
+            }
+            else if (argument == "--log-file" && hasValue) {
+                logFile = argv[++i];
+            }
+            else if (argument == "--shader-cache" && hasValue) {
+                shaderCacheDirectory = argv[++i];
+            }
+            else if (argument == "--no-shader-cache") {
+                shaderCacheDirectory = "";
+            }
+            else if (argument == "--vram-budget" && hasValue) {
+                vramBudgetMegabytes = glm::max(0, atoi(argv[++i]));
+            }
+            else if (argument == "--gl-stats") {
+                isInterceptingGL = true;
+            }
+            else if (argument == "--gl-capture" && hasValue) {
+                glCapturePath = argv[++i];
+            }
+            else if (argument == "--gl-capture-frames" && hasValue) {
+                glCaptureFrames = glm::max(1, atoi(argv[++i]));
+            }
+            else if (argument == "--replay" && hasValue) {
+                replayPath = argv[++i];
+            }
+            else if (argument == "--replay-loops" && hasValue) {
+                replayLoops = glm::max(1, atoi(argv[++i]));
+            }
+            else if (argument == "--replay-output" && hasValue) {
+                replayOutput = argv[++i];
+            }
+            else {
+                LOG_WARNING("OPTIONS", "Unknown option: {}", argument);
+            }
+        }
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+//Framebuffer class stores an offscreen render target with a color and a depth attachment
+class Framebuffer {
+public:
+    GLuint FBO, colorRBO, depthRBO; //ids of the framebuffer and its attachments
+    int width, height; //resolution of the framebuffer
+    int allocation; //id of the attachments in the residency manager
+
+    //constructor for the framebuffer class
+    Framebuffer(int width, int height) {
+        this->width = width;
+        this->height = height;
+
+        glGenFramebuffers(1, &FBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+
+        //create the color attachment
+        glGenRenderbuffers(1, &colorRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, colorRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRBO);
+
+        //create the depth attachment
+        glGenRenderbuffers(1, &depthRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            LOG_ERROR("FRAMEBUFFER", "[FRAMEBUFFER] Framebuffer is incomplete");
+        }
+
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        //4 bytes for the color and 4 for the depth, which drivers store as 24 bit depth with 8 unused bits
+        allocation = ResidencyManager::instance().track(ResidencyManager::RENDER_TARGET, "Offscreen framebuffer", (long long)width * height * 8);
+    }
+
+    //destructor for the framebuffer class
+    ~Framebuffer() {
+        glDeleteRenderbuffers(1, &colorRBO);
+        glDeleteRenderbuffers(1, &depthRBO);
+        glDeleteFramebuffers(1, &FBO);
+        ResidencyManager::instance().release(allocation);
+    }
+
+    //renders the following draw calls into the framebuffer
+    void bind() {
+        glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+        glViewport(0, 0, width, height);
+    }
+
+    //writes the color attachment to a binary ppm image
+    bool saveImage(std::string path) {
+        std::vector<unsigned char> pixels(width * height * 3);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            LOG_ERROR("FRAMEBUFFER", "[FRAMEBUFFER] Unable to write {}", path);
+            return false;
+        }
+
+        file << "P6\n" << width << " " << height << "\n255\n";
+
+        //opengl stores the rows from the bottom up while images store them from the top down
+        for (int y = height - 1; y >= 0; y--) {
+            file.write((const char*)&pixels[y * width * 3], width * 3);
+        }
+
+        return true;
+    }
+};
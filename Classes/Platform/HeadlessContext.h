@@ -0,0 +1,144 @@
+#pragma once
+
+//HeadlessContext class creates an opengl context that is not attached to any window or display
+//
+//builds that define USE_EGL (linked with libEGL) create a surfaceless EGL context, which works with mesa llvmpipe on machines
+//without a gpu or a display server. other builds fall back to an invisible glfw window that asks for an OSMesa context.
+class HeadlessContext {
+public:
+#ifdef USE_EGL
+    EGLDisplay display; //egl display the context was created on
+    EGLContext context; //egl context
+#endif
+    GLFWwindow* window; //invisible window used by the glfw fallback
+    std::string description; //describes the backend that was used to create the context
+
+    //constructor for the headless context class
+    HeadlessContext() {
+#ifdef USE_EGL
+        display = EGL_NO_DISPLAY;
+        context = EGL_NO_CONTEXT;
+#endif
+        window = NULL;
+    }
+
+    //destructor for the headless context class
+    ~HeadlessContext() {
+        destroy();
+    }
+
+    //creates the context, makes it current, and loads the opengl functions
+    bool create() {
+#ifdef USE_EGL
+        if (createEGL()) {
+            return true;
+        }
+#endif
+        return createGLFW();
+    }
+
+#ifdef USE_EGL
+    //creates a surfaceless egl context
+    bool createEGL() {
+        //prefer the mesa surfaceless platform since it needs neither a gpu nor a display server
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) {
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        }
+        if (display == EGL_NO_DISPLAY) {
+            display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+
+        EGLint major, minor;
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+            LOG_ERROR("HEADLESS", "[HEADLESS] Unable to initialize an EGL display");
+            return false;
+        }
+
+        //rendering goes to a framebuffer object so the config does not need any surface
+        EGLint configAttributes[] = {
+            EGL_SURFACE_TYPE, 0,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+        };
+        EGLConfig config;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+            LOG_ERROR("HEADLESS", "[HEADLESS] No EGL config supports desktop OpenGL");
+            return false;
+        }
+
+        eglBindAPI(EGL_OPENGL_API);
+
+        //ask for the same compatibility profile that glad was generated for
+        EGLint contextAttributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+            EGL_NONE
+        };
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+        if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+            LOG_ERROR("HEADLESS", "[HEADLESS] Unable to create a surfaceless EGL context");
+            return false;
+        }
+
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+            LOG_ERROR("HEADLESS", "[HEADLESS] Unable to load the OpenGL functions");
+            return false;
+        }
+
+        description = "EGL " + std::to_string(major) + "." + std::to_string(minor) + " (surfaceless)";
+        return true;
+    }
+#endif
+
+    //creates an invisible glfw window that owns an osmesa (or native) context
+    bool createGLFW() {
+        if (!glfwInit()) {
+            LOG_ERROR("HEADLESS", "[HEADLESS] Unable to initialize GLFW");
+            return false;
+        }
+
+        //try the software osmesa context first and then the native context
+        int contextApis[] = { GLFW_OSMESA_CONTEXT_API, GLFW_NATIVE_CONTEXT_API };
+        for (int i = 0; i < 2 && !window; i++) {
+            glfwDefaultWindowHints();
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, contextApis[i]);
+            window = glfwCreateWindow(1, 1, "", NULL, NULL);
+            description = i == 0 ? "GLFW (OSMesa)" : "GLFW (hidden window)";
+        }
+
+        if (!window) {
+            LOG_ERROR("HEADLESS", "[HEADLESS] Unable to create an offscreen GLFW context");
+            glfwTerminate();
+            return false;
+        }
+
+        glfwMakeContextCurrent(window);
+        gladLoadGL();
+
+        return true;
+    }
+
+    //releases the context
+    void destroy() {
+#ifdef USE_EGL
+        if (display != EGL_NO_DISPLAY) {
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (context != EGL_NO_CONTEXT) {
+                eglDestroyContext(display, context);
+            }
+            eglTerminate(display);
+            display = EGL_NO_DISPLAY;
+            context = EGL_NO_CONTEXT;
+        }
+#endif
+        if (window) {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+            window = NULL;
+        }
+    }
+};
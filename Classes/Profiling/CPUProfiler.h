@@ -0,0 +1,190 @@
+#pragma once
+
+//CPUProfiler class records timed zones from any thread into per thread ring buffers and exports them as a chrome trace
+class CPUProfiler {
+public:
+    static const int BUFFER_CAPACITY = 1 << 16; //number of zones each thread keeps before the oldest ones are overwritten
+
+    //stores a single completed zone
+    struct ZoneEvent {
+        const char* name; //name of the zone (must be a string literal so that no memory is allocated while recording)
+        uint64_t start, end; //timestamps in ticks
+    };
+
+    //stores the zones recorded by a single thread, only the owning thread writes to it
+    struct ThreadBuffer {
+        std::vector<ZoneEvent> events; //ring of recorded zones
+        std::atomic<uint64_t> writeCount; //number of zones written since the buffer was created
+        int threadId; //id of the thread in the trace
+        std::string threadName; //name of the thread in the trace
+    };
+
+    std::atomic<bool> isEnabled; //checks if zones are currently being recorded
+    std::mutex registryMutex; //guards the list of buffers when a new thread records its first zone
+    std::vector<ThreadBuffer*> buffers; //buffers of every thread that has recorded a zone
+    uint64_t startTicks; //timestamp when the profiler was created
+    std::chrono::steady_clock::time_point startTime; //wall clock time when the profiler was created
+
+    //returns the profiler shared by every thread
+    static CPUProfiler& instance() {
+        static CPUProfiler profiler;
+        return profiler;
+    }
+
+    //returns the buffer of the calling thread, creating it the first time the thread records a zone
+    static ThreadBuffer* threadBuffer() {
+        thread_local ThreadBuffer* buffer = instance().registerThread();
+        return buffer;
+    }
+
+    //reads a high resolution timestamp (time stamp counter when available)
+    static uint64_t readTicks() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    //constructor for the cpu profiler class
+    CPUProfiler() {
+        isEnabled = false;
+        startTicks = readTicks();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    //destructor for the cpu profiler class
+    ~CPUProfiler() {
+        for (int i = 0; i < buffers.size(); i++) {
+            delete buffers[i];
+        }
+    }
+
+    //creates the buffer of a thread and adds it to the registry
+    ThreadBuffer* registerThread() {
+        ThreadBuffer* buffer = new ThreadBuffer();
+        buffer->events.resize(BUFFER_CAPACITY);
+        buffer->writeCount = 0;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffer->threadId = buffers.size() + 1;
+        buffer->threadName = buffer->threadId == 1 ? "Main" : "Thread " + std::to_string(buffer->threadId);
+        buffers.push_back(buffer);
+
+        return buffer;
+    }
+
+    //sets the name of the calling thread in the trace
+    void setThreadName(std::string name) {
+        ThreadBuffer* buffer = threadBuffer();
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffer->threadName = name;
+    }
+
+    //records a completed zone in the buffer of the calling thread
+    void record(const char* name, uint64_t start, uint64_t end) {
+        ThreadBuffer* buffer = threadBuffer();
+        uint64_t index = buffer->writeCount.load(std::memory_order_relaxed);
+
+        ZoneEvent& event = buffer->events[index % BUFFER_CAPACITY];
+        event.name = name;
+        event.start = start;
+        event.end = end;
+
+        //publish the zone only after it has been completely written
+        buffer->writeCount.store(index + 1, std::memory_order_release);
+    }
+
+    //returns the number of ticks in a microsecond by comparing the timestamps against the wall clock
+    double ticksPerMicrosecond() {
+        double elapsedMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+        uint64_t elapsedTicks = readTicks() - startTicks;
+
+        if (elapsedMicroseconds <= 0.0 || elapsedTicks == 0) {
+            return 1.0;
+        }
+
+        return elapsedTicks / elapsedMicroseconds;
+    }
+
+    //writes every zone that is still in the buffers to a chrome://tracing (trace event format) json file
+    void exportTrace(std::string path) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            return;
+        }
+
+        double tickScale = 1.0 / ticksPerMicrosecond();
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool isFirst = true;
+
+        for (int i = 0; i < buffers.size(); i++) {
+            ThreadBuffer* buffer = buffers[i];
+
+            //name the thread in the viewer
+            file << (isFirst ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+            isFirst = false;
+
+            //copy the zones that have been published so far
+            uint64_t writeCount = buffer->writeCount.load(std::memory_order_acquire);
+            uint64_t firstIndex = writeCount > BUFFER_CAPACITY ? writeCount - BUFFER_CAPACITY : 0;
+            std::vector<ZoneEvent> events;
+            for (uint64_t j = firstIndex; j < writeCount; j++) {
+                events.push_back(buffer->events[j % BUFFER_CAPACITY]);
+            }
+
+            //discard the zones that the owning thread may have overwritten while they were being copied
+            uint64_t latestCount = buffer->writeCount.load(std::memory_order_acquire);
+            uint64_t validIndex = latestCount > BUFFER_CAPACITY ? latestCount - BUFFER_CAPACITY : 0;
+            int skipCount = validIndex > firstIndex ? glm::min<uint64_t>(validIndex - firstIndex, events.size()) : 0;
+
+            for (int j = skipCount; j < events.size(); j++) {
+                double timestamp = (double)(int64_t)(events[j].start - startTicks) * tickScale;
+                double duration = (double)(events[j].end - events[j].start) * tickScale;
+
+                file << ",\n{\"name\":\"" << events[j].name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << std::fixed << std::setprecision(3) << timestamp << ",\"dur\":" << duration << "}";
+            }
+        }
+
+        file << "\n]}\n";
+    }
+};
+
+//CPUZone class records the time between its construction and destruction as a zone of the cpu profiler
+class CPUZone {
+public:
+    const char* name; //name of the zone
+    uint64_t start; //timestamp when the zone was opened, 0 if the profiler was disabled
+
+    //constructor for the cpu zone class which opens the zone
+    CPUZone(const char* name) {
+        this->name = name;
+
+        //only a relaxed load is paid when the profiler is disabled
+        start = CPUProfiler::instance().isEnabled.load(std::memory_order_relaxed) ? CPUProfiler::readTicks() : 0;
+    }
+
+    //destructor for the cpu zone class which closes the zone
+    ~CPUZone() {
+        if (start != 0) {
+            CPUProfiler::instance().record(name, start, CPUProfiler::readTicks());
+        }
+    }
+};
+
+//the zones can be compiled out completely by defining DISABLE_CPU_PROFILER
+#ifndef DISABLE_CPU_PROFILER
+#define PROFILE_ZONE_JOIN(a, b) a##b
+#define PROFILE_ZONE_NAME(line) PROFILE_ZONE_JOIN(cpuZone, line)
+#define PROFILE_ZONE(name) CPUZone PROFILE_ZONE_NAME(__LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
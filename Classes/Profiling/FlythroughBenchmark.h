@@ -0,0 +1,221 @@
+#pragma once
+
+//FlythroughBenchmark class replays a timestamped camera path and reports the frame times of the run
+class FlythroughBenchmark {
+public:
+    static const int FIRST_PERSON = 1; //camera value of the first person perspective camera
+    static const int THIRD_PERSON = 3; //camera value of the third person perspective camera
+    static const int ORTHO = 0; //camera value of the orthographic camera
+
+    //stores the state of the player and camera at a point of the path
+    struct Keyframe {
+        float time; //time of the keyframe in seconds
+        glm::vec3 position; //position of the player
+        float heading; //rotation of the player around the y axis in degrees
+        int camera; //camera used from this keyframe until the next one
+        float yaw, pitch; //orbit of the third person camera
+    };
+
+    std::string pathFile; //file the path was loaded from
+    std::vector<Keyframe> keyframes; //keyframes of the path sorted by time
+    float timeStep; //simulated time between two frames, independent of how long the frames actually take
+    int frameCount; //number of frames to render
+    int currentFrame; //index of the frame being rendered
+
+    std::chrono::steady_clock::time_point frameStart; //time when the current frame started
+    std::vector<double> cpuFrameTimes; //cpu time of every frame in milliseconds
+    std::vector<double> simulationTimes; //time spent simulating and building the snapshot of every frame in milliseconds
+    std::vector<double> submitTimes; //time spent issuing the gl calls of every frame in milliseconds
+    std::vector<double> drawCalls; //number of draw calls of every frame
+    std::vector<double> triangles; //number of triangles of every frame
+    std::vector<double> culledModels; //number of models outside the view in every frame
+    std::vector<double> glCalls; //number of gl calls of every frame, empty if the calls are not intercepted
+    std::vector<double> redundantGlCalls; //number of gl calls that changed nothing in every frame
+    std::vector<double> uploadBytes; //bytes passed to the buffer and texture uploads of every frame
+
+    //constructor for the flythrough benchmark class
+    FlythroughBenchmark(std::string pathFile, int frameCount, float timeStep) {
+        this->pathFile = pathFile;
+        this->timeStep = timeStep;
+        currentFrame = 0;
+        frameStart = std::chrono::steady_clock::now();
+
+        loadPath(pathFile);
+
+        //cover the whole path if no frame count was given
+        if (frameCount <= 0) {
+            frameCount = keyframes.empty() ? 1 : (int)(keyframes.back().time / timeStep) + 1;
+        }
+        this->frameCount = frameCount;
+    }
+
+    //loads the keyframes from a text file with the format: time x y z heading camera [yaw pitch]
+    void loadPath(std::string path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            LOG_ERROR("BENCHMARK", "[BENCHMARK] Unable to open {}", path);
+            return;
+        }
+
+        std::string line;
+        while (std::getline(file, line)) {
+            //skip the comments and the empty lines
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::istringstream stream(line);
+            Keyframe keyframe;
+            keyframe.yaw = -90.0f;
+            keyframe.pitch = 0.0f;
+
+            if (stream >> keyframe.time >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z >> keyframe.heading >> keyframe.camera) {
+                stream >> keyframe.yaw >> keyframe.pitch;
+                keyframes.push_back(keyframe);
+            }
+        }
+
+        std::sort(keyframes.begin(), keyframes.end(), [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+    }
+
+    //checks if every frame of the run has been rendered
+    bool isFinished() {
+        return currentFrame >= frameCount;
+    }
+
+    //moves the player and cameras to the state of the path at the current frame
+    void beginFrame(Environment* environment) {
+        frameStart = std::chrono::steady_clock::now();
+
+        applyFrame(environment, currentFrame);
+    }
+
+    //moves the player and cameras to the state of the path at the given frame
+    void applyFrame(Environment* environment, int frame) {
+        if (keyframes.empty()) {
+            return;
+        }
+
+        float time = frame * timeStep;
+
+        //the clips follow the time of the path so that every run draws the same poses
+        environment->animationSystem->time = time;
+
+        //find the keyframes surrounding the current time
+        int next = 0;
+        while (next < keyframes.size() && keyframes[next].time <= time) {
+            next++;
+        }
+        int previous = glm::max(next - 1, 0);
+        next = glm::min(next, (int)keyframes.size() - 1);
+
+        Keyframe& from = keyframes[previous];
+        Keyframe& to = keyframes[next];
+        float duration = to.time - from.time;
+        float factor = duration > 0.0f ? glm::clamp((time - from.time) / duration, 0.0f, 1.0f) : 0.0f;
+
+        //interpolate the player between the two keyframes
+        Player* player = environment->playerModel;
+        player->position = glm::mix(from.position, to.position, factor);
+        player->theta.y = glm::mix(from.heading, to.heading, factor);
+        player->updateDirection();
+
+        //interpolate the orbit of the third person camera
+        environment->thirdPerspectiveCamera->yaw = glm::mix(from.yaw, to.yaw, factor);
+        environment->thirdPerspectiveCamera->pitch = glm::mix(from.pitch, to.pitch, factor);
+
+        //switch to the camera of the current segment
+        switch (from.camera) {
+            case FIRST_PERSON:
+                environment->activeCamera = environment->firstPerspectiveCamera;
+                environment->lastPerspective = 1;
+                break;
+            case THIRD_PERSON:
+                environment->activeCamera = environment->thirdPerspectiveCamera;
+                environment->lastPerspective = 3;
+                break;
+            case ORTHO:
+                environment->useOrthoCamera();
+                break;
+        }
+    }
+
+    //records the measurements of the frame that was just presented
+    //the cpu time is measured from the previous frame, so pipelined frames report the interval between two presents
+    void endFrame(Environment* environment) {
+        std::chrono::steady_clock::time_point frameEnd = std::chrono::steady_clock::now();
+        double milliseconds = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+        frameStart = frameEnd;
+
+        cpuFrameTimes.push_back(milliseconds);
+        drawCalls.push_back(environment->renderStats.drawCalls);
+        triangles.push_back((double)environment->renderStats.triangles);
+        culledModels.push_back(environment->renderStats.culledModels);
+
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        if (interceptor.isInstalled) {
+            glCalls.push_back((double)interceptor.lastFrame.calls);
+            redundantGlCalls.push_back((double)interceptor.lastFrame.redundantCalls);
+            uploadBytes.push_back((double)(interceptor.lastFrame.bufferBytes + interceptor.lastFrame.textureBytes));
+        }
+
+        currentFrame++;
+    }
+
+    //records how long the two stages of a pipelined frame took
+    void recordStages(double simulationMilliseconds, double submitMilliseconds) {
+        simulationTimes.push_back(simulationMilliseconds);
+        submitTimes.push_back(submitMilliseconds);
+    }
+
+    //writes the mean, percentiles, and max of a series as a json object
+    static void writeSeries(std::ofstream& file, std::string name, std::vector<double> values, bool isLast) {
+        double sum = 0.0;
+        for (int i = 0; i < values.size(); i++) {
+            sum += values[i];
+        }
+        std::sort(values.begin(), values.end());
+
+        file << "  \"" << name << "\": { "
+            << "\"samples\": " << values.size()
+            << ", \"mean\": " << (values.empty() ? 0.0 : sum / values.size())
+            << ", \"p50\": " << GPUProfiler::percentile(values, 50.0)
+            << ", \"p95\": " << GPUProfiler::percentile(values, 95.0)
+            << ", \"p99\": " << GPUProfiler::percentile(values, 99.0)
+            << ", \"max\": " << (values.empty() ? 0.0 : values.back())
+            << " }" << (isLast ? "\n" : ",\n");
+    }
+
+    //writes the results of the run to a json file
+    void exportJSON(std::string path, std::vector<double> gpuFrameTimes) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            LOG_ERROR("BENCHMARK", "[BENCHMARK] Unable to write {}", path);
+            return;
+        }
+
+        file << "{\n";
+        file << "  \"path\": \"" << pathFile << "\",\n";
+        file << "  \"frames\": " << cpuFrameTimes.size() << ",\n";
+        file << "  \"timeStep\": " << timeStep << ",\n";
+        file << "  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n";
+        file << "  \"version\": \"" << glGetString(GL_VERSION) << "\",\n";
+        writeSeries(file, "cpuFrameMs", cpuFrameTimes, false);
+        writeSeries(file, "gpuFrameMs", gpuFrameTimes, false);
+        if (!simulationTimes.empty()) {
+            writeSeries(file, "simulationMs", simulationTimes, false);
+            writeSeries(file, "submitMs", submitTimes, false);
+        }
+        writeSeries(file, "drawCalls", drawCalls, false);
+        writeSeries(file, "culledModels", culledModels, false);
+        if (!glCalls.empty()) {
+            writeSeries(file, "glCalls", glCalls, false);
+            writeSeries(file, "redundantGlCalls", redundantGlCalls, false);
+            writeSeries(file, "uploadBytes", uploadBytes, false);
+        }
+        writeSeries(file, "triangles", triangles, true);
+        file << "}\n";
+
+        LOG_INFO("BENCHMARK", "[BENCHMARK] {} frames written to {}", cpuFrameTimes.size(), path);
+    }
+};
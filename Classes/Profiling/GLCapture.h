@@ -0,0 +1,427 @@
+#pragma once
+
+//GLCapture class writes every intercepted gl call with its arguments and the data it reads to a binary trace
+//
+//the capture goes through the hooks of the interceptor, so it records from the moment glad was loaded: the loading
+//of the environment and the first frame are the setup of the trace, which the replayer runs once, and the frames
+//after it are the ones it times. the trace starts with a header:
+//
+//  u32 MAGIC, u32 VERSION, u32 size of a pointer, i32 width, i32 height, i32 frames after the setup,
+//  u32 number of entry points, and the name of every entry point as a u16 length and its characters
+//
+//followed by the records. a record is the u16 index of its entry point in the names of the header, a u32 length,
+//and then the arguments as raw values with every pointer widened to a u64, the data the call reads from client
+//memory as blobs (a u32 length and the bytes), and the values the call returned or wrote, see GLRecorder. a u16
+//FRAME_MARKER with nothing after it ends a frame. the replayer finds the entry points by name, so a trace stays
+//readable when the list of intercepted calls changes.
+//
+//pixels read from the mapped upload ring are written as if they came from client memory since the writes of the
+//loading threads into the mapping are not gl calls. a linked program that was loaded with glProgramBinary only
+//replays on the driver that made it, so the shader cache is off while capturing.
+class GLCapture {
+public:
+    static const unsigned int MAGIC = 0x52544C47; //"GLTR" in a little endian file
+    static const unsigned int VERSION = 1; //version of the format, changed when the layout of a record changes
+    static const unsigned short FRAME_MARKER = 0xFFFF; //record that ends a frame
+
+    bool isRecording; //checks if the hooks write the calls to the trace
+    std::ofstream file; //trace that is being written
+    std::string path; //path of the trace
+    int frameLimit; //frames recorded after the setup, the capture stops after them
+    int frames; //frames ended since the capture started, the first one is the setup
+    long long bytesWritten; //size of the trace so far
+    std::vector<unsigned char> record; //record of the call that is being made
+    int call; //entry point of the record
+    GLint unpackAlignment; //row alignment of the pixels read by the texture uploads
+    std::unordered_map<GLuint, const unsigned char*> mappings; //start of every mapped pixel unpack buffer in client memory
+
+    //returns the capture shared by the whole program, since the hooks are plain functions
+    static GLCapture& instance() {
+        static GLCapture capture;
+        return capture;
+    }
+
+    //constructor for the gl capture class
+    GLCapture() {
+        isRecording = false;
+        frameLimit = 0;
+        frames = 0;
+        bytesWritten = 0;
+        call = 0;
+        unpackAlignment = 4;
+    }
+
+    //opens the trace and writes its header, the hooks must be installed right after glad was loaded
+    bool start(std::string path, int frameLimit, int width, int height) {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("GL", "[GL] Unable to write {}", path);
+            return false;
+        }
+
+        this->path = path;
+        this->frameLimit = frameLimit;
+        frames = 0;
+        bytesWritten = 0;
+        unpackAlignment = 4;
+        mappings.clear();
+
+        record.clear();
+        writeValue(MAGIC);
+        writeValue(VERSION);
+        writeValue((unsigned int)sizeof(void*));
+        writeValue(width);
+        writeValue(height);
+        writeValue(0); //frame count, written when the capture stops
+        writeValue((unsigned int)GL_CALL_COUNT);
+        for (int i = 0; i < GL_CALL_COUNT; i++) {
+            std::string name = GLInterceptor::getName(i);
+            writeValue((unsigned short)name.size());
+            write(name.data(), name.size());
+        }
+        flush();
+
+        isRecording = true;
+        LOG_INFO("GL", "[GL] Capturing the gl calls of the setup and {} frames to {}", frameLimit, path);
+        return true;
+    }
+
+    //writes the frame count in the header and closes the trace
+    void stop() {
+        if (!isRecording) {
+            return;
+        }
+
+        isRecording = false;
+        int recordedFrames = glm::max(0, frames - 1);
+        file.seekp(sizeof(unsigned int) * 3 + sizeof(int) * 2);
+        file.write((const char*)&recordedFrames, sizeof(recordedFrames));
+        file.close();
+
+        LOG_INFO("GL", "[GL] Captured {} frames in {.1} MB to {}", recordedFrames, bytesWritten / (1024.0 * 1024.0), path);
+    }
+
+    //ends the frame that was just submitted, the capture stops once the setup and every requested frame were written
+    void endFrame() {
+        if (!isRecording) {
+            return;
+        }
+
+        record.clear();
+        writeValue(FRAME_MARKER);
+        flush();
+
+        frames++;
+        if (frames > frameLimit) {
+            stop();
+        }
+    }
+
+    //starts the record of a call
+    void begin(int call) {
+        this->call = call;
+        record.clear();
+    }
+
+    //writes the record of the call to the trace
+    void end() {
+        std::vector<unsigned char> body;
+        body.swap(record);
+        writeValue((unsigned short)call);
+        writeValue((unsigned int)body.size());
+        record.insert(record.end(), body.begin(), body.end());
+        flush();
+    }
+
+    //adds bytes to the record
+    void write(const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        record.insert(record.end(), bytes, bytes + size);
+    }
+
+    //adds a value to the record as it is in memory
+    template <typename T>
+    void writeValue(T value) {
+        write(&value, sizeof(value));
+    }
+
+    //adds an argument to the record
+    template <typename T>
+    void writeArgument(T value) {
+        writeValue(value);
+    }
+
+    //adds a pointer argument to the record, widened so that offsets into buffers keep their value
+    template <typename T>
+    void writeArgument(T* pointer) {
+        writeValue((unsigned long long)(uintptr_t)pointer);
+    }
+
+    //adds every argument of a call to the record in order
+    template <typename... Args>
+    void writeArguments(Args... args) {
+        int expand[] = { 0, (writeArgument(args), 0)... };
+        (void)expand;
+    }
+
+    //adds data read from client memory to the record, an empty blob if there is none
+    void writeBlob(const void* data, size_t size) {
+        if (data == NULL) {
+            size = 0;
+        }
+        writeValue((unsigned int)size);
+        write(data, size);
+    }
+
+    //adds the pixels a texture upload reads to the record
+    //
+    //the pixels come from client memory, or from the mapped upload ring at the offset the pointer gives while a pixel
+    //buffer is bound. a pixel buffer that is not mapped was filled by gl calls, so the offset alone replays it.
+    void writePixels(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
+        const unsigned char* source = (const unsigned char*)pixels;
+        GLuint buffer = GLInterceptor::instance().pixelUnpackBuffer;
+        if (buffer != 0) {
+            std::unordered_map<GLuint, const unsigned char*>::iterator it = mappings.find(buffer);
+            source = it != mappings.end() ? it->second + (uintptr_t)pixels : NULL;
+        }
+
+        //the last row is not padded to the alignment
+        size_t rowSize = (size_t)width * GLInterceptor::getPixelSize(format, type);
+        size_t rowStride = (rowSize + unpackAlignment - 1) / unpackAlignment * unpackAlignment;
+        size_t rows = (size_t)height * depth;
+        writeBlob(source, rows > 0 ? rowStride * (rows - 1) + rowSize : 0);
+    }
+
+    //appends the finished record to the trace
+    void flush() {
+        file.write((const char*)record.data(), record.size());
+        bytesWritten += record.size();
+        record.clear();
+    }
+};
+
+//GLRecorder struct writes the data a call reads from client memory before the call reaches the driver, and the
+//values it returns or writes after the driver made it. the entry points without a specialization only write their
+//arguments, a pointer among them is an offset into a buffer that is bound or an output the replayer makes its own.
+template <int Call>
+struct GLRecorder {
+    template <typename... Args>
+    static void recordInput(GLCapture& /*capture*/, Args...) {
+    }
+
+    template <typename... Args>
+    static void recordOutput(GLCapture& /*capture*/, Args...) {
+    }
+};
+
+//starts the specialization of GLRecorder for an entry point, which keeps the empty functions it does not replace
+#define GL_RECORDER(name) template <> struct GLRecorder<GL_CALL_##name> : GLRecorder<-1>
+
+//writes the names made by a glGen function, which the replayer maps to the names its own calls make
+#define GL_RECORD_GENERATED(name) \
+    template <> struct GLRecorder<GL_CALL_##name> : GLRecorder<-1> { \
+        static void recordOutput(GLCapture& capture, GLsizei count, GLuint* names) { \
+            capture.writeBlob(names, count * sizeof(GLuint)); \
+        } \
+    };
+
+//writes the names passed to a glDelete function
+#define GL_RECORD_DELETED(name) \
+    template <> struct GLRecorder<GL_CALL_##name> : GLRecorder<-1> { \
+        static void recordInput(GLCapture& capture, GLsizei count, const GLuint* names) { \
+            capture.writeBlob(names, count * sizeof(GLuint)); \
+        } \
+    };
+
+GL_RECORD_GENERATED(glGenBuffers)
+GL_RECORD_GENERATED(glGenFramebuffers)
+GL_RECORD_GENERATED(glGenQueries)
+GL_RECORD_GENERATED(glGenRenderbuffers)
+GL_RECORD_GENERATED(glGenTextures)
+GL_RECORD_GENERATED(glGenVertexArrays)
+
+GL_RECORD_DELETED(glDeleteBuffers)
+GL_RECORD_DELETED(glDeleteFramebuffers)
+GL_RECORD_DELETED(glDeleteQueries)
+GL_RECORD_DELETED(glDeleteRenderbuffers)
+GL_RECORD_DELETED(glDeleteTextures)
+GL_RECORD_DELETED(glDeleteVertexArrays)
+
+#undef GL_RECORD_GENERATED
+#undef GL_RECORD_DELETED
+
+GL_RECORDER(glCreateShader) {
+    static void recordOutput(GLCapture& capture, GLuint shader, GLenum /*type*/) {
+        capture.writeValue(shader);
+    }
+};
+
+GL_RECORDER(glCreateProgram) {
+    static void recordOutput(GLCapture& capture, GLuint program) {
+        capture.writeValue(program);
+    }
+};
+
+GL_RECORDER(glFenceSync) {
+    static void recordOutput(GLCapture& capture, GLsync sync, GLenum /*condition*/, GLbitfield /*flags*/) {
+        capture.writeArgument(sync);
+    }
+};
+
+GL_RECORDER(glGetUniformLocation) {
+    static void recordInput(GLCapture& capture, GLuint /*program*/, const GLchar* name) {
+        capture.writeBlob(name, strlen(name) + 1);
+    }
+
+    static void recordOutput(GLCapture& capture, GLint location, GLuint /*program*/, const GLchar* /*name*/) {
+        capture.writeValue(location);
+    }
+};
+
+GL_RECORDER(glShaderSource) {
+    static void recordInput(GLCapture& capture, GLuint /*shader*/, GLsizei count, const GLchar* const* strings, const GLint* lengths) {
+        for (int i = 0; i < count; i++) {
+            bool hasLength = lengths != NULL && lengths[i] >= 0;
+            capture.writeBlob(strings[i], hasLength ? lengths[i] : strlen(strings[i]));
+        }
+    }
+};
+
+GL_RECORDER(glProgramBinary) {
+    static void recordInput(GLCapture& capture, GLuint /*program*/, GLenum /*format*/, const void* binary, GLsizei length) {
+        capture.writeBlob(binary, length);
+    }
+};
+
+GL_RECORDER(glMapBufferRange) {
+    static void recordOutput(GLCapture& capture, void* mapped, GLenum target, GLintptr offset, GLsizeiptr /*length*/, GLbitfield /*access*/) {
+        if (target == GL_PIXEL_UNPACK_BUFFER && mapped != NULL) {
+            capture.mappings[GLInterceptor::instance().pixelUnpackBuffer] = (const unsigned char*)mapped - offset;
+        }
+    }
+};
+
+GL_RECORDER(glUnmapBuffer) {
+    static void recordInput(GLCapture& capture, GLenum target) {
+        if (target == GL_PIXEL_UNPACK_BUFFER) {
+            capture.mappings.erase(GLInterceptor::instance().pixelUnpackBuffer);
+        }
+    }
+};
+
+GL_RECORDER(glPixelStorei) {
+    static void recordInput(GLCapture& capture, GLenum name, GLint value) {
+        if (name == GL_UNPACK_ALIGNMENT) {
+            capture.unpackAlignment = glm::max(1, value);
+        }
+    }
+};
+
+GL_RECORDER(glBufferData) {
+    static void recordInput(GLCapture& capture, GLenum /*target*/, GLsizeiptr size, const void* data, GLenum /*usage*/) {
+        capture.writeBlob(data, size);
+    }
+};
+
+GL_RECORDER(glBufferStorage) {
+    static void recordInput(GLCapture& capture, GLenum /*target*/, GLsizeiptr size, const void* data, GLbitfield /*flags*/) {
+        capture.writeBlob(data, size);
+    }
+};
+
+GL_RECORDER(glBufferSubData) {
+    static void recordInput(GLCapture& capture, GLenum /*target*/, GLintptr /*offset*/, GLsizeiptr size, const void* data) {
+        capture.writeBlob(data, size);
+    }
+};
+
+GL_RECORDER(glTexImage2D) {
+    static void recordInput(GLCapture& capture, GLenum /*target*/, GLint /*level*/, GLint /*internalFormat*/, GLsizei width, GLsizei height, GLint /*border*/, GLenum format, GLenum type, const void* pixels) {
+        capture.writePixels(width, height, 1, format, type, pixels);
+    }
+};
+
+GL_RECORDER(glTexImage3D) {
+    static void recordInput(GLCapture& capture, GLenum /*target*/, GLint /*level*/, GLint /*internalFormat*/, GLsizei width, GLsizei height, GLsizei depth, GLint /*border*/, GLenum format, GLenum type, const void* pixels) {
+        capture.writePixels(width, height, depth, format, type, pixels);
+    }
+};
+
+GL_RECORDER(glTexSubImage2D) {
+    static void recordInput(GLCapture& capture, GLenum /*target*/, GLint /*level*/, GLint /*x*/, GLint /*y*/, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+        capture.writePixels(width, height, 1, format, type, pixels);
+    }
+};
+
+GL_RECORDER(glTexSubImage3D) {
+    static void recordInput(GLCapture& capture, GLenum /*target*/, GLint /*level*/, GLint /*x*/, GLint /*y*/, GLint /*z*/, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
+        capture.writePixels(width, height, depth, format, type, pixels);
+    }
+};
+
+GL_RECORDER(glUniform2fv) {
+    static void recordInput(GLCapture& capture, GLint /*location*/, GLsizei count, const GLfloat* value) {
+        capture.writeBlob(value, count * 2 * sizeof(GLfloat));
+    }
+};
+
+GL_RECORDER(glUniform3fv) {
+    static void recordInput(GLCapture& capture, GLint /*location*/, GLsizei count, const GLfloat* value) {
+        capture.writeBlob(value, count * 3 * sizeof(GLfloat));
+    }
+};
+
+GL_RECORDER(glUniformMatrix3fv) {
+    static void recordInput(GLCapture& capture, GLint /*location*/, GLsizei count, GLboolean /*transpose*/, const GLfloat* value) {
+        capture.writeBlob(value, count * 9 * sizeof(GLfloat));
+    }
+};
+
+GL_RECORDER(glUniformMatrix4fv) {
+    static void recordInput(GLCapture& capture, GLint /*location*/, GLsizei count, GLboolean /*transpose*/, const GLfloat* value) {
+        capture.writeBlob(value, count * 16 * sizeof(GLfloat));
+    }
+};
+
+GL_RECORDER(glDrawBuffers) {
+    static void recordInput(GLCapture& capture, GLsizei count, const GLenum* buffers) {
+        capture.writeBlob(buffers, count * sizeof(GLenum));
+    }
+};
+
+GL_RECORDER(glClearBufferfv) {
+    //a color is four values, the depth a single one
+    static void recordInput(GLCapture& capture, GLenum buffer, GLint /*drawBuffer*/, const GLfloat* value) {
+        capture.writeBlob(value, (buffer == GL_COLOR ? 4 : 1) * sizeof(GLfloat));
+    }
+};
+
+#undef GL_RECORDER
+
+//GLCaptureCall struct makes a call between the data it reads and the values it returns in its record
+template <typename Result>
+struct GLCaptureCall {
+    template <int Call, typename... Args>
+    static Result forward(Result (APIENTRYP function)(Args...), Args... args) {
+        GLCapture& capture = GLCapture::instance();
+        capture.writeArguments(args...);
+        GLRecorder<Call>::recordInput(capture, args...);
+        Result result = function(args...);
+        GLRecorder<Call>::recordOutput(capture, result, args...);
+        capture.end();
+        return result;
+    }
+};
+
+template <>
+struct GLCaptureCall<void> {
+    template <int Call, typename... Args>
+    static void forward(void (APIENTRYP function)(Args...), Args... args) {
+        GLCapture& capture = GLCapture::instance();
+        capture.writeArguments(args...);
+        GLRecorder<Call>::recordInput(capture, args...);
+        function(args...);
+        GLRecorder<Call>::recordOutput(capture, args...);
+        capture.end();
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+//GLHook struct is the function put in place of a glad function pointer, it keeps the pointer to the driver function
+template <int Call, typename Function>
+struct GLHook;
+
+template <int Call, typename Result, typename... Args>
+struct GLHook<Call, Result (APIENTRYP)(Args...)> {
+    static Result (APIENTRYP original)(Args...); //driver function that glad loaded
+
+    //counts the call, checks if it is redundant, and forwards it to the driver, writing it to the trace while capturing
+    static Result APIENTRY call(Args... args) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        interceptor.count(Call);
+        if (GLObserver<Call>::observe(args...)) {
+            interceptor.countRedundant(Call);
+        }
+
+        GLCapture& capture = GLCapture::instance();
+        if (!capture.isRecording) {
+            return original(args...);
+        }
+        capture.begin(Call);
+        return GLCaptureCall<Result>::template forward<Call>(original, args...);
+    }
+
+    //puts the hook in place of a glad function pointer, a function the driver does not have is left alone
+    static void install(Result (APIENTRYP& pointer)(Args...)) {
+        original = pointer;
+        if (pointer) {
+            pointer = call;
+        }
+    }
+
+    //puts the driver function back
+    static void uninstall(Result (APIENTRYP& pointer)(Args...)) {
+        if (pointer) {
+            pointer = original;
+        }
+    }
+};
+
+template <int Call, typename Result, typename... Args>
+Result (APIENTRYP GLHook<Call, Result (APIENTRYP)(Args...)>::original)(Args...) = NULL;
+
+//GLHooks class installs and removes the hooks of every entry point of GL_INTERCEPTED_CALLS
+class GLHooks {
+public:
+    //wraps the glad function pointers, must be called on the thread that owns the context right after glad loaded them
+    static void install() {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        if (interceptor.isInstalled) {
+            return;
+        }
+
+#define GL_INSTALL_HOOK(name) GLHook<GL_CALL_##name, decltype(glad_##name)>::install(glad_##name);
+        GL_INTERCEPTED_CALLS(GL_INSTALL_HOOK)
+#undef GL_INSTALL_HOOK
+
+        interceptor.resetCounts();
+        interceptor.resetState();
+        interceptor.isInstalled = true;
+    }
+
+    //puts the driver functions back in the glad function pointers
+    static void uninstall() {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        if (!interceptor.isInstalled) {
+            return;
+        }
+
+#define GL_UNINSTALL_HOOK(name) GLHook<GL_CALL_##name, decltype(glad_##name)>::uninstall(glad_##name);
+        GL_INTERCEPTED_CALLS(GL_UNINSTALL_HOOK)
+#undef GL_UNINSTALL_HOOK
+
+        interceptor.isInstalled = false;
+    }
+};
@@ -0,0 +1,648 @@
+#pragma once
+
+//every gl function the program calls, each one is wrapped while the interceptor is installed
+#define GL_INTERCEPTED_CALLS(X) \
+    X(glActiveTexture) X(glAttachShader) X(glBindBuffer) X(glBindFramebuffer) X(glBindRenderbuffer) \
+    X(glBindTexture) X(glBindVertexArray) X(glBlendColor) X(glBlendEquation) X(glBlendFunc) \
+    X(glBufferData) X(glBufferStorage) X(glBufferSubData) X(glCheckFramebufferStatus) X(glClear) \
+    X(glClearBufferfv) X(glClientWaitSync) X(glCompileShader) X(glCopyImageSubData) X(glCreateProgram) \
+    X(glCreateShader) X(glDeleteBuffers) X(glDeleteFramebuffers) X(glDeleteProgram) X(glDeleteQueries) \
+    X(glDeleteRenderbuffers) X(glDeleteShader) X(glDeleteSync) X(glDeleteTextures) X(glDeleteVertexArrays) \
+    X(glDepthFunc) X(glDepthMask) X(glDetachShader) X(glDisable) X(glDrawArrays) \
+    X(glDrawBuffer) X(glDrawBuffers) X(glDrawElements) X(glEnable) X(glEnableVertexAttribArray) \
+    X(glFenceSync) X(glFinish) X(glFramebufferRenderbuffer) X(glFramebufferTexture2D) X(glGenBuffers) \
+    X(glGenFramebuffers) X(glGenQueries) X(glGenRenderbuffers) X(glGenTextures) X(glGenVertexArrays) \
+    X(glGenerateMipmap) X(glGetIntegerv) X(glGetProgramBinary) X(glGetProgramInfoLog) X(glGetProgramiv) \
+    X(glGetQueryObjectiv) X(glGetQueryObjectui64v) X(glGetShaderInfoLog) X(glGetShaderiv) X(glGetString) \
+    X(glGetUniformLocation) X(glIsEnabled) X(glLinkProgram) X(glMapBufferRange) X(glMaxShaderCompilerThreadsARB) \
+    X(glMaxShaderCompilerThreadsKHR) X(glPixelStorei) X(glProgramBinary) X(glProgramParameteri) X(glQueryCounter) \
+    X(glReadPixels) X(glRenderbufferStorage) X(glShaderSource) X(glTexImage2D) X(glTexImage3D) \
+    X(glTexParameteri) X(glTexSubImage2D) X(glTexSubImage3D) X(glUniform1f) X(glUniform1i) \
+    X(glUniform2fv) X(glUniform3fv) X(glUniformMatrix3fv) X(glUniformMatrix4fv) X(glUnmapBuffer) \
+    X(glUseProgram) X(glVertexAttribPointer) X(glViewport)
+
+//index of every intercepted gl function
+enum GLCall {
+#define GL_CALL_ENUM(name) GL_CALL_##name,
+    GL_INTERCEPTED_CALLS(GL_CALL_ENUM)
+#undef GL_CALL_ENUM
+    GL_CALL_COUNT
+};
+
+//gl work of a frame as seen by the interceptor
+struct GLFrameStats {
+    long long calls; //number of gl calls
+    long long redundantCalls; //number of calls that set a binding, state, or uniform to the value it already had
+    long long bufferBytes; //bytes passed to glBufferData, glBufferStorage, and glBufferSubData
+    long long textureBytes; //bytes passed to glTexImage and glTexSubImage
+};
+
+//GLInterceptor class counts the gl calls of every frame by replacing the function pointers that glad loaded
+//
+//while installed, every function of GL_INTERCEPTED_CALLS goes through a hook that counts it and forwards it to the
+//driver, so the program does not change at all and there is no cost when it is not installed. the hooks of the
+//binding, state, and uniform functions compare the new value with the value last set, which the interceptor tracks
+//from the default state of a new context, and count the calls that change nothing as redundant. a uniform is
+//remembered by a hash of its value per program and location, and a uniform at location -1 counts as redundant since
+//the call does nothing. the hooks of the upload functions add up the bytes read from client memory or from a pixel
+//buffer, writes through a mapped buffer are not seen.
+//
+//the gl calls must all be made on the thread that owns the context, which is true of the whole program.
+class GLInterceptor {
+public:
+    static const int MAX_TEXTURE_UNITS = 32; //texture units whose bindings are tracked
+    static const int TEXTURE_TARGETS = 4; //texture targets whose bindings are tracked, see getTargetIndex
+    static const int CAPABILITIES = 3; //capabilities of glEnable and glDisable that are tracked, see getCapabilityIndex
+
+    bool isInstalled; //checks if the hooks replace the glad function pointers
+    long long callCounts[GL_CALL_COUNT]; //calls of every entry point since the interceptor was installed
+    long long redundantCounts[GL_CALL_COUNT]; //redundant calls of every entry point since the interceptor was installed
+    GLFrameStats frame; //work of the frame that is being submitted
+    GLFrameStats lastFrame; //work of the frame that was last finished
+    std::vector<GLFrameStats> history; //work of every finished frame
+
+    //state as the program set it, starting from the default state of a new context
+    GLuint program; //program in use
+    GLenum activeTexture; //active texture unit
+    GLuint textures[MAX_TEXTURE_UNITS][TEXTURE_TARGETS]; //texture bound to every target of every unit
+    GLuint vertexArray; //vertex array that is bound
+    GLuint arrayBuffer, pixelUnpackBuffer, pixelPackBuffer; //buffers bound to the tracked targets
+    GLuint drawFramebuffer, readFramebuffer; //framebuffers that are bound
+    GLuint renderbuffer; //renderbuffer that is bound
+    int capabilities[CAPABILITIES]; //enabled state of the tracked capabilities
+    int depthMask; //depth mask
+    GLenum depthFunction; //depth test function
+    GLenum blendSource, blendDestination, blendEquation; //blend factors and equation
+    glm::vec4 blendColor; //constant blend color
+    GLint viewport[4]; //viewport rectangle, -1 until it is set since it starts at the size of the window
+    std::unordered_map<unsigned long long, unsigned long long> uniformHashes; //hash of the value of every uniform by program and location
+
+    //returns the interceptor shared by the whole program, since the hooks are plain functions
+    static GLInterceptor& instance() {
+        static GLInterceptor interceptor;
+        return interceptor;
+    }
+
+    //constructor for the gl interceptor class
+    GLInterceptor() {
+        isInstalled = false;
+        resetCounts();
+        resetState();
+    }
+
+    //returns the name of an entry point
+    static const char* getName(int call) {
+        static const char* names[GL_CALL_COUNT] = {
+#define GL_CALL_NAME(name) #name,
+            GL_INTERCEPTED_CALLS(GL_CALL_NAME)
+#undef GL_CALL_NAME
+        };
+        return names[call];
+    }
+
+    //clears the counters and the frames
+    void resetCounts() {
+        for (int i = 0; i < GL_CALL_COUNT; i++) {
+            callCounts[i] = 0;
+            redundantCounts[i] = 0;
+        }
+        frame = lastFrame = GLFrameStats();
+        history.clear();
+    }
+
+    //sets the tracked state to the default state of a new context
+    void resetState() {
+        program = 0;
+        activeTexture = GL_TEXTURE0;
+        for (int unit = 0; unit < MAX_TEXTURE_UNITS; unit++) {
+            for (int target = 0; target < TEXTURE_TARGETS; target++) {
+                textures[unit][target] = 0;
+            }
+        }
+        vertexArray = 0;
+        arrayBuffer = pixelUnpackBuffer = pixelPackBuffer = 0;
+        drawFramebuffer = readFramebuffer = 0;
+        renderbuffer = 0;
+        capabilities[0] = capabilities[1] = capabilities[2] = 0;
+        depthMask = GL_TRUE;
+        depthFunction = GL_LESS;
+        blendSource = GL_ONE;
+        blendDestination = GL_ZERO;
+        blendEquation = GL_FUNC_ADD;
+        blendColor = glm::vec4(0.0f);
+        viewport[0] = viewport[1] = viewport[2] = viewport[3] = -1;
+        uniformHashes.clear();
+    }
+
+    //counts a call to an entry point
+    void count(int call) {
+        callCounts[call]++;
+        frame.calls++;
+    }
+
+    //counts a call that did not change anything
+    void countRedundant(int call) {
+        redundantCounts[call]++;
+        frame.redundantCalls++;
+    }
+
+    //closes the counters of the frame that was just submitted
+    void endFrame() {
+        lastFrame = frame;
+        history.push_back(frame);
+        frame = GLFrameStats();
+    }
+
+    //returns the slot of a texture target in the tracked bindings, -1 if the target is not tracked
+    static int getTargetIndex(GLenum target) {
+        switch (target) {
+            case GL_TEXTURE_2D:
+                return 0;
+            case GL_TEXTURE_2D_ARRAY:
+                return 1;
+            case GL_TEXTURE_CUBE_MAP:
+                return 2;
+            case GL_TEXTURE_3D:
+                return 3;
+            default:
+                return -1;
+        }
+    }
+
+    //returns the slot of a capability in the tracked states, -1 if the capability is not tracked
+    static int getCapabilityIndex(GLenum capability) {
+        switch (capability) {
+            case GL_BLEND:
+                return 0;
+            case GL_DEPTH_TEST:
+                return 1;
+            case GL_CULL_FACE:
+                return 2;
+            default:
+                return -1;
+        }
+    }
+
+    //returns the size of a pixel of client data in bytes
+    static int getPixelSize(GLenum format, GLenum type) {
+        int components = 4;
+        switch (format) {
+            case GL_RED:
+            case GL_DEPTH_COMPONENT:
+                components = 1;
+                break;
+            case GL_RG:
+                components = 2;
+                break;
+            case GL_RGB:
+            case GL_BGR:
+                components = 3;
+                break;
+        }
+
+        switch (type) {
+            case GL_UNSIGNED_BYTE:
+            case GL_BYTE:
+                return components;
+            case GL_UNSIGNED_SHORT:
+            case GL_SHORT:
+            case GL_HALF_FLOAT:
+                return components * 2;
+            default:
+                return components * 4;
+        }
+    }
+
+    //sets a value of the tracked state and returns true if it already had that value
+    template <typename T>
+    static bool update(T& state, T value) {
+        bool isSame = state == value;
+        state = value;
+        return isSame;
+    }
+
+    //remembers the value of a uniform of the program in use and returns true if it already had that value
+    bool updateUniform(GLint location, const void* data, size_t size) {
+        if (location < 0) {
+            return true;
+        }
+
+        //64 bit fnv-1a of the bytes of the value
+        unsigned long long hash = 14695981039346656037ULL;
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+
+        unsigned long long key = ((unsigned long long)program << 32) | (unsigned int)location;
+        std::unordered_map<unsigned long long, unsigned long long>::iterator it = uniformHashes.find(key);
+        if (it != uniformHashes.end() && it->second == hash) {
+            return true;
+        }
+        uniformHashes[key] = hash;
+        return false;
+    }
+
+    //forgets the uniforms of a program, which are reset when it is linked or deleted
+    void forgetUniforms(GLuint program) {
+        std::unordered_map<unsigned long long, unsigned long long>::iterator it = uniformHashes.begin();
+        while (it != uniformHashes.end()) {
+            if ((it->first >> 32) == program) {
+                it = uniformHashes.erase(it);
+            }
+            else {
+                it++;
+            }
+        }
+    }
+
+    //unbinds a deleted object from the bindings that hold it, like the context does
+    static void unbind(GLuint& binding, GLsizei count, const GLuint* objects) {
+        for (int i = 0; i < count; i++) {
+            if (binding == objects[i]) {
+                binding = 0;
+            }
+        }
+    }
+
+    //returns the mean of a counter over the finished frames
+    double getFrameMean(long long GLFrameStats::* counter) {
+        long long sum = 0;
+        for (int i = 0; i < history.size(); i++) {
+            sum += history[i].*counter;
+        }
+        return history.empty() ? 0.0 : (double)sum / history.size();
+    }
+
+    //writes the counters of every finished frame to a csv file
+    void exportCSV(std::string path) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            LOG_ERROR("GL", "[GL] Unable to write {}", path);
+            return;
+        }
+
+        file << "frame,calls,redundant_calls,buffer_bytes,texture_bytes\n";
+        for (int i = 0; i < history.size(); i++) {
+            file << i << "," << history[i].calls << "," << history[i].redundantCalls << ","
+                << history[i].bufferBytes << "," << history[i].textureBytes << "\n";
+        }
+    }
+
+    //writes the means per frame and the counters of every entry point that was called to a json file
+    void exportJSON(std::string path) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            LOG_ERROR("GL", "[GL] Unable to write {}", path);
+            return;
+        }
+
+        file << "{\n";
+        file << "  \"frames\": " << history.size() << ",\n";
+        file << "  \"callsPerFrame\": " << getFrameMean(&GLFrameStats::calls) << ",\n";
+        file << "  \"redundantCallsPerFrame\": " << getFrameMean(&GLFrameStats::redundantCalls) << ",\n";
+        file << "  \"bufferBytesPerFrame\": " << getFrameMean(&GLFrameStats::bufferBytes) << ",\n";
+        file << "  \"textureBytesPerFrame\": " << getFrameMean(&GLFrameStats::textureBytes) << ",\n";
+        file << "  \"entryPoints\": [\n";
+
+        bool isFirst = true;
+        for (int i = 0; i < GL_CALL_COUNT; i++) {
+            if (callCounts[i] == 0) {
+                continue;
+            }
+
+            file << (isFirst ? "" : ",\n") << "    { \"name\": \"" << getName(i) << "\", \"calls\": " << callCounts[i]
+                << ", \"redundant\": " << redundantCounts[i] << " }";
+            isFirst = false;
+        }
+        file << "\n  ]\n}\n";
+    }
+
+    //logs the means per frame and the entry points that were called the most
+    void report() {
+        LOG_INFO("GL", "[GL] {} frames, {.1} calls and {.1} redundant per frame, {.1} KB of buffers and {.1} KB of textures uploaded per frame",
+            (int)history.size(), getFrameMean(&GLFrameStats::calls), getFrameMean(&GLFrameStats::redundantCalls),
+            getFrameMean(&GLFrameStats::bufferBytes) / 1024.0, getFrameMean(&GLFrameStats::textureBytes) / 1024.0);
+
+        std::vector<int> calls;
+        for (int i = 0; i < GL_CALL_COUNT; i++) {
+            if (callCounts[i] > 0) {
+                calls.push_back(i);
+            }
+        }
+        std::sort(calls.begin(), calls.end(), [this](int a, int b) { return callCounts[a] > callCounts[b]; });
+
+        for (int i = 0; i < calls.size() && i < 10; i++) {
+            LOG_INFO("GL", "[GL]   {} {} calls, {} redundant", getName(calls[i]), callCounts[calls[i]], redundantCounts[calls[i]]);
+        }
+    }
+
+    //writes the counters to a csv and a json file with the same base path
+    void exportResults(std::string basePath) {
+        exportCSV(basePath + ".csv");
+        exportJSON(basePath + ".json");
+    }
+};
+
+//GLObserver struct looks at the arguments of a call before it reaches the driver and returns true if it is redundant,
+//the entry points without a specialization are only counted
+template <int Call>
+struct GLObserver {
+    template <typename... Args>
+    static bool observe(Args...) {
+        return false;
+    }
+};
+
+//starts the specialization of GLObserver for an entry point
+#define GL_OBSERVER(name) template <> struct GLObserver<GL_CALL_##name>
+
+GL_OBSERVER(glUseProgram) {
+    static bool observe(GLuint program) {
+        return GLInterceptor::update(GLInterceptor::instance().program, program);
+    }
+};
+
+GL_OBSERVER(glActiveTexture) {
+    static bool observe(GLenum texture) {
+        return GLInterceptor::update(GLInterceptor::instance().activeTexture, texture);
+    }
+};
+
+GL_OBSERVER(glBindTexture) {
+    static bool observe(GLenum target, GLuint texture) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        int unit = interceptor.activeTexture - GL_TEXTURE0;
+        int index = GLInterceptor::getTargetIndex(target);
+        if (index < 0 || unit < 0 || unit >= GLInterceptor::MAX_TEXTURE_UNITS) {
+            return false;
+        }
+        return GLInterceptor::update(interceptor.textures[unit][index], texture);
+    }
+};
+
+GL_OBSERVER(glDeleteTextures) {
+    static bool observe(GLsizei count, const GLuint* textures) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        for (int unit = 0; unit < GLInterceptor::MAX_TEXTURE_UNITS; unit++) {
+            for (int target = 0; target < GLInterceptor::TEXTURE_TARGETS; target++) {
+                GLInterceptor::unbind(interceptor.textures[unit][target], count, textures);
+            }
+        }
+        return false;
+    }
+};
+
+GL_OBSERVER(glBindVertexArray) {
+    static bool observe(GLuint vertexArray) {
+        return GLInterceptor::update(GLInterceptor::instance().vertexArray, vertexArray);
+    }
+};
+
+GL_OBSERVER(glDeleteVertexArrays) {
+    static bool observe(GLsizei count, const GLuint* vertexArrays) {
+        GLInterceptor::unbind(GLInterceptor::instance().vertexArray, count, vertexArrays);
+        return false;
+    }
+};
+
+GL_OBSERVER(glBindBuffer) {
+    //the element array buffer belongs to the vertex array, so it is not tracked
+    static bool observe(GLenum target, GLuint buffer) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        switch (target) {
+            case GL_ARRAY_BUFFER:
+                return GLInterceptor::update(interceptor.arrayBuffer, buffer);
+            case GL_PIXEL_UNPACK_BUFFER:
+                return GLInterceptor::update(interceptor.pixelUnpackBuffer, buffer);
+            case GL_PIXEL_PACK_BUFFER:
+                return GLInterceptor::update(interceptor.pixelPackBuffer, buffer);
+            default:
+                return false;
+        }
+    }
+};
+
+GL_OBSERVER(glDeleteBuffers) {
+    static bool observe(GLsizei count, const GLuint* buffers) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        GLInterceptor::unbind(interceptor.arrayBuffer, count, buffers);
+        GLInterceptor::unbind(interceptor.pixelUnpackBuffer, count, buffers);
+        GLInterceptor::unbind(interceptor.pixelPackBuffer, count, buffers);
+        return false;
+    }
+};
+
+GL_OBSERVER(glBindFramebuffer) {
+    static bool observe(GLenum target, GLuint framebuffer) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        bool isDrawSame = interceptor.drawFramebuffer == framebuffer;
+        bool isReadSame = interceptor.readFramebuffer == framebuffer;
+        if (target != GL_READ_FRAMEBUFFER) {
+            interceptor.drawFramebuffer = framebuffer;
+        }
+        if (target != GL_DRAW_FRAMEBUFFER) {
+            interceptor.readFramebuffer = framebuffer;
+        }
+        return (target == GL_READ_FRAMEBUFFER || isDrawSame) && (target == GL_DRAW_FRAMEBUFFER || isReadSame);
+    }
+};
+
+GL_OBSERVER(glDeleteFramebuffers) {
+    static bool observe(GLsizei count, const GLuint* framebuffers) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        GLInterceptor::unbind(interceptor.drawFramebuffer, count, framebuffers);
+        GLInterceptor::unbind(interceptor.readFramebuffer, count, framebuffers);
+        return false;
+    }
+};
+
+GL_OBSERVER(glBindRenderbuffer) {
+    static bool observe(GLenum /*target*/, GLuint renderbuffer) {
+        return GLInterceptor::update(GLInterceptor::instance().renderbuffer, renderbuffer);
+    }
+};
+
+GL_OBSERVER(glDeleteRenderbuffers) {
+    static bool observe(GLsizei count, const GLuint* renderbuffers) {
+        GLInterceptor::unbind(GLInterceptor::instance().renderbuffer, count, renderbuffers);
+        return false;
+    }
+};
+
+GL_OBSERVER(glEnable) {
+    static bool observe(GLenum capability) {
+        int index = GLInterceptor::getCapabilityIndex(capability);
+        return index >= 0 && GLInterceptor::update(GLInterceptor::instance().capabilities[index], 1);
+    }
+};
+
+GL_OBSERVER(glDisable) {
+    static bool observe(GLenum capability) {
+        int index = GLInterceptor::getCapabilityIndex(capability);
+        return index >= 0 && GLInterceptor::update(GLInterceptor::instance().capabilities[index], 0);
+    }
+};
+
+GL_OBSERVER(glDepthMask) {
+    static bool observe(GLboolean flag) {
+        return GLInterceptor::update(GLInterceptor::instance().depthMask, (int)flag);
+    }
+};
+
+GL_OBSERVER(glDepthFunc) {
+    static bool observe(GLenum function) {
+        return GLInterceptor::update(GLInterceptor::instance().depthFunction, function);
+    }
+};
+
+GL_OBSERVER(glBlendFunc) {
+    static bool observe(GLenum source, GLenum destination) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        bool isSame = GLInterceptor::update(interceptor.blendSource, source);
+        return GLInterceptor::update(interceptor.blendDestination, destination) && isSame;
+    }
+};
+
+GL_OBSERVER(glBlendEquation) {
+    static bool observe(GLenum equation) {
+        return GLInterceptor::update(GLInterceptor::instance().blendEquation, equation);
+    }
+};
+
+GL_OBSERVER(glBlendColor) {
+    static bool observe(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+        return GLInterceptor::update(GLInterceptor::instance().blendColor, glm::vec4(red, green, blue, alpha));
+    }
+};
+
+GL_OBSERVER(glViewport) {
+    static bool observe(GLint x, GLint y, GLsizei width, GLsizei height) {
+        GLint* viewport = GLInterceptor::instance().viewport;
+        bool isSame = viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height;
+        viewport[0] = x;
+        viewport[1] = y;
+        viewport[2] = width;
+        viewport[3] = height;
+        return isSame;
+    }
+};
+
+GL_OBSERVER(glUniform1i) {
+    static bool observe(GLint location, GLint value) {
+        return GLInterceptor::instance().updateUniform(location, &value, sizeof(value));
+    }
+};
+
+GL_OBSERVER(glUniform1f) {
+    static bool observe(GLint location, GLfloat value) {
+        return GLInterceptor::instance().updateUniform(location, &value, sizeof(value));
+    }
+};
+
+GL_OBSERVER(glUniform2fv) {
+    static bool observe(GLint location, GLsizei count, const GLfloat* value) {
+        return GLInterceptor::instance().updateUniform(location, value, count * 2 * sizeof(GLfloat));
+    }
+};
+
+GL_OBSERVER(glUniform3fv) {
+    static bool observe(GLint location, GLsizei count, const GLfloat* value) {
+        return GLInterceptor::instance().updateUniform(location, value, count * 3 * sizeof(GLfloat));
+    }
+};
+
+GL_OBSERVER(glUniformMatrix3fv) {
+    static bool observe(GLint location, GLsizei count, GLboolean /*transpose*/, const GLfloat* value) {
+        return GLInterceptor::instance().updateUniform(location, value, count * 9 * sizeof(GLfloat));
+    }
+};
+
+GL_OBSERVER(glUniformMatrix4fv) {
+    static bool observe(GLint location, GLsizei count, GLboolean /*transpose*/, const GLfloat* value) {
+        return GLInterceptor::instance().updateUniform(location, value, count * 16 * sizeof(GLfloat));
+    }
+};
+
+GL_OBSERVER(glLinkProgram) {
+    static bool observe(GLuint program) {
+        GLInterceptor::instance().forgetUniforms(program);
+        return false;
+    }
+};
+
+GL_OBSERVER(glProgramBinary) {
+    static bool observe(GLuint program, GLenum /*format*/, const void* /*binary*/, GLsizei /*length*/) {
+        GLInterceptor::instance().forgetUniforms(program);
+        return false;
+    }
+};
+
+GL_OBSERVER(glDeleteProgram) {
+    static bool observe(GLuint program) {
+        GLInterceptor::instance().forgetUniforms(program);
+        return false;
+    }
+};
+
+GL_OBSERVER(glBufferData) {
+    static bool observe(GLenum /*target*/, GLsizeiptr size, const void* data, GLenum /*usage*/) {
+        if (data) {
+            GLInterceptor::instance().frame.bufferBytes += size;
+        }
+        return false;
+    }
+};
+
+GL_OBSERVER(glBufferStorage) {
+    static bool observe(GLenum /*target*/, GLsizeiptr size, const void* data, GLbitfield /*flags*/) {
+        if (data) {
+            GLInterceptor::instance().frame.bufferBytes += size;
+        }
+        return false;
+    }
+};
+
+GL_OBSERVER(glBufferSubData) {
+    static bool observe(GLenum /*target*/, GLintptr /*offset*/, GLsizeiptr size, const void* /*data*/) {
+        GLInterceptor::instance().frame.bufferBytes += size;
+        return false;
+    }
+};
+
+//the pixels come from client memory if the pointer is set, or from the pixel buffer that is bound at the offset it gives
+GL_OBSERVER(glTexImage2D) {
+    static bool observe(GLenum /*target*/, GLint /*level*/, GLint /*internalFormat*/, GLsizei width, GLsizei height, GLint /*border*/, GLenum format, GLenum type, const void* pixels) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        if (pixels || interceptor.pixelUnpackBuffer != 0) {
+            interceptor.frame.textureBytes += (long long)width * height * GLInterceptor::getPixelSize(format, type);
+        }
+        return false;
+    }
+};
+
+GL_OBSERVER(glTexImage3D) {
+    static bool observe(GLenum /*target*/, GLint /*level*/, GLint /*internalFormat*/, GLsizei width, GLsizei height, GLsizei depth, GLint /*border*/, GLenum format, GLenum type, const void* pixels) {
+        GLInterceptor& interceptor = GLInterceptor::instance();
+        if (pixels || interceptor.pixelUnpackBuffer != 0) {
+            interceptor.frame.textureBytes += (long long)width * height * depth * GLInterceptor::getPixelSize(format, type);
+        }
+        return false;
+    }
+};
+
+GL_OBSERVER(glTexSubImage2D) {
+    static bool observe(GLenum /*target*/, GLint /*level*/, GLint /*x*/, GLint /*y*/, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* /*pixels*/) {
+        GLInterceptor::instance().frame.textureBytes += (long long)width * height * GLInterceptor::getPixelSize(format, type);
+        return false;
+    }
+};
+
+GL_OBSERVER(glTexSubImage3D) {
+    static bool observe(GLenum /*target*/, GLint /*level*/, GLint /*x*/, GLint /*y*/, GLint /*z*/, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* /*pixels*/) {
+        GLInterceptor::instance().frame.textureBytes += (long long)width * height * depth * GLInterceptor::getPixelSize(format, type);
+        return false;
+    }
+};
+
+#undef GL_OBSERVER
@@ -0,0 +1,940 @@
+#pragma once
+
+//GLNameMap struct maps the names of gl objects in a trace to the names the replayed calls made for them
+struct GLNameMap {
+    std::unordered_map<GLuint, GLuint> names; //replayed name of every traced name
+
+    //returns the replayed name of a traced name, a name that was never made in the trace is kept as it is
+    GLuint get(GLuint name) {
+        std::unordered_map<GLuint, GLuint>::iterator it = names.find(name);
+        return it == names.end() ? name : it->second;
+    }
+
+    //remembers the replayed name of a traced name
+    void set(GLuint name, GLuint replayed) {
+        names[name] = replayed;
+    }
+
+    //forgets a traced name once its object was deleted
+    void erase(GLuint name) {
+        names.erase(name);
+    }
+};
+
+//GLReplayer class runs the calls of a trace written by GLCapture again and measures how long every frame takes
+//
+//the whole trace is read into memory before anything is timed. the setup is replayed once, then the frames are
+//replayed in order as many times as requested with a glFinish after each one, so the time of a frame covers both
+//issuing its calls and the gpu finishing them. the objects the trace made get new names in the replay, and a
+//uniform location is looked up again for the program it belongs to, so every call that names an object or a
+//location is mapped before it reaches the driver, see GLPlayer. the default framebuffer of the captured program is
+//stood in for by a framebuffer of the captured size, since the headless context of the replay has none.
+//
+//a frame that makes objects makes new ones on every loop, and the ones it deletes are deleted on every loop, so a
+//frame that streams in a model replays its uploads every time as well. the calls of an entry point that the
+//driver of the replay does not have are skipped and counted.
+class GLReplayer {
+public:
+    //byte range of the records of a frame in the trace
+    struct Frame {
+        size_t start; //first byte of the first record
+        size_t end; //first byte of the marker that ends the frame
+    };
+
+    std::string path; //path of the trace
+    std::vector<unsigned char> trace; //whole trace
+    int width, height; //size of the default framebuffer of the captured program
+    std::vector<int> calls; //entry point of this build for every entry point of the trace, -1 if it has none
+    Frame setup; //calls made before the first frame ended, replayed once
+    std::vector<Frame> frames; //calls of every timed frame
+    size_t cursor; //byte of the trace that is read next
+    size_t recordEnd; //first byte after the record that is being replayed
+    bool isRecordValid; //checks if the record that is being replayed had all the bytes it read
+
+    GLNameMap buffers, framebuffers, queries, renderbuffers, textures, vertexArrays; //objects made with glGen
+    GLNameMap shaderObjects; //shaders and programs, which share their names
+    std::unordered_map<unsigned long long, GLsync> syncs; //replayed fence of every traced fence
+    std::unordered_map<unsigned long long, GLint> uniformLocations; //replayed location by replayed program and traced location
+    GLuint program; //replayed program in use
+    GLuint pixelUnpackBuffer, pixelPackBuffer; //replayed buffers bound to the pixel targets
+    bool isUnpackRedirected; //checks if the pixel unpack buffer was unbound for pixels that are in the trace
+    std::vector<unsigned char> scratch; //memory the calls that return data write to
+
+    GLuint defaultFramebuffer, colorRBO, depthRBO; //stand in for the default framebuffer of the captured program
+    long long skippedCalls; //calls of entry points this build or driver does not have
+    long long invalidRecords; //records that were shorter than their arguments
+    double setupMilliseconds; //time to replay the setup
+    std::vector<std::vector<double>> frameMilliseconds; //time of every frame of every loop
+
+    //constructor for the gl replayer class
+    GLReplayer() {
+        width = height = 0;
+        setup.start = setup.end = 0;
+        cursor = recordEnd = 0;
+        isRecordValid = true;
+        program = 0;
+        pixelUnpackBuffer = pixelPackBuffer = 0;
+        isUnpackRedirected = false;
+        defaultFramebuffer = colorRBO = depthRBO = 0;
+        skippedCalls = 0;
+        invalidRecords = 0;
+        setupMilliseconds = 0.0;
+    }
+
+    //reads a trace and finds its frames, returns false if it is not a trace this build can replay
+    bool load(std::string path) {
+        PROFILE_ZONE("GLReplayer::load");
+        this->path = path;
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            LOG_ERROR("REPLAY", "[REPLAY] Unable to open {}", path);
+            return false;
+        }
+        trace.resize((size_t)file.tellg());
+        file.seekg(0);
+        file.read((char*)trace.data(), trace.size());
+
+        cursor = 0;
+        recordEnd = trace.size();
+        isRecordValid = true;
+        unsigned int magic = read<unsigned int>();
+        unsigned int version = read<unsigned int>();
+        unsigned int pointerSize = read<unsigned int>();
+        width = read<int>();
+        height = read<int>();
+        int frameCount = read<int>();
+        unsigned int callCount = read<unsigned int>();
+
+        if (!isRecordValid || magic != GLCapture::MAGIC) {
+            LOG_ERROR("REPLAY", "[REPLAY] {} is not a gl trace", path);
+            return false;
+        }
+        if (version != GLCapture::VERSION) {
+            LOG_ERROR("REPLAY", "[REPLAY] {} is version {} of the format, this build reads version {}", path, (int)version, (int)GLCapture::VERSION);
+            return false;
+        }
+        if (pointerSize != sizeof(void*)) {
+            LOG_ERROR("REPLAY", "[REPLAY] {} was captured by a {} bit build", path, (int)pointerSize * 8);
+            return false;
+        }
+
+        //find the entry points of the trace by name
+        calls.assign(callCount, -1);
+        for (int i = 0; i < callCount; i++) {
+            unsigned short length = read<unsigned short>();
+            if (!isRecordValid || cursor + length > trace.size()) {
+                LOG_ERROR("REPLAY", "[REPLAY] The header of {} is cut short", path);
+                return false;
+            }
+            std::string name((const char*)&trace[cursor], length);
+            cursor += length;
+
+            for (int call = 0; call < GL_CALL_COUNT; call++) {
+                if (name == GLInterceptor::getName(call)) {
+                    calls[i] = call;
+                }
+            }
+        }
+
+        //split the records at the frame markers, the calls after the last marker belong to no complete frame
+        size_t start = cursor;
+        bool isSetup = true;
+        while (cursor + sizeof(unsigned short) <= trace.size()) {
+            size_t position = cursor;
+            unsigned short id = read<unsigned short>();
+            if (id == GLCapture::FRAME_MARKER) {
+                Frame frame;
+                frame.start = start;
+                frame.end = position;
+                if (isSetup) {
+                    setup = frame;
+                    isSetup = false;
+                }
+                else {
+                    frames.push_back(frame);
+                }
+                start = cursor;
+                continue;
+            }
+
+            unsigned int size = read<unsigned int>();
+            if (!isRecordValid || cursor + size > trace.size()) {
+                break;
+            }
+            cursor += size;
+        }
+
+        if (isSetup) {
+            LOG_ERROR("REPLAY", "[REPLAY] {} does not contain a whole frame", path);
+            return false;
+        }
+        if (frames.size() != frameCount) {
+            LOG_WARNING("REPLAY", "[REPLAY] {} lists {} frames but holds {}", path, frameCount, (int)frames.size());
+        }
+
+        LOG_INFO("REPLAY", "[REPLAY] Loaded {} frames at {}x{} from {} ({.1} MB)", (int)frames.size(), width, height, path, trace.size() / (1024.0 * 1024.0));
+        return true;
+    }
+
+    //creates the framebuffer that stands in for the default framebuffer of the captured program
+    void createDefaultFramebuffer() {
+        glGenRenderbuffers(1, &colorRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, colorRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glGenRenderbuffers(1, &depthRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &defaultFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+        glViewport(0, 0, width, height);
+
+        framebuffers.set(0, defaultFramebuffer);
+    }
+
+    //replays the setup once and every frame loops times, must be called on the thread that owns the context
+    void run(int loops) {
+        PROFILE_ZONE("GLReplayer::run");
+        createDefaultFramebuffer();
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        play(setup);
+        glFinish();
+        setupMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        LOG_INFO("REPLAY", "[REPLAY] Replayed the setup in {.1} ms", setupMilliseconds);
+
+        frameMilliseconds.assign(loops, std::vector<double>());
+        for (int loop = 0; loop < loops; loop++) {
+            for (int i = 0; i < frames.size(); i++) {
+                PROFILE_ZONE("Replay Frame");
+                start = std::chrono::steady_clock::now();
+                play(frames[i]);
+                glFinish();
+                frameMilliseconds[loop].push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            }
+        }
+
+        if (skippedCalls > 0 || invalidRecords > 0) {
+            LOG_WARNING("REPLAY", "[REPLAY] Skipped {} calls the driver does not have and {} records that were cut short", skippedCalls, invalidRecords);
+        }
+    }
+
+    //replays the records of a frame in order
+    void play(Frame& frame) {
+        cursor = frame.start;
+        while (cursor < frame.end) {
+            unsigned short id = readRaw<unsigned short>(frame.end);
+            unsigned int size = readRaw<unsigned int>(frame.end);
+            recordEnd = glm::min(cursor + size, frame.end);
+            isRecordValid = true;
+
+            if (id < calls.size() && calls[id] >= 0) {
+                dispatch(calls[id]);
+            }
+            else {
+                skippedCalls++;
+            }
+
+            if (!isRecordValid) {
+                invalidRecords++;
+            }
+            cursor = recordEnd;
+        }
+    }
+
+    //replays a record of an entry point, defined after the players of the entry points
+    void dispatch(int call);
+
+    //reads a value of the record as it was in memory, or a zero past the end of the record
+    template <typename T>
+    T readRaw(size_t end) {
+        T value = T();
+        if (cursor + sizeof(T) > end) {
+            isRecordValid = false;
+            cursor = end;
+            return value;
+        }
+        memcpy(&value, &trace[cursor], sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    //reads a value of the record
+    template <typename T>
+    T readValue(T*) {
+        return readRaw<T>(recordEnd);
+    }
+
+    //reads a pointer of the record, which was widened to a u64
+    template <typename T>
+    T* readValue(T**) {
+        return (T*)(uintptr_t)readRaw<unsigned long long>(recordEnd);
+    }
+
+    //reads an argument of the record
+    template <typename T>
+    T read() {
+        return readValue((T*)NULL);
+    }
+
+    //reads a blob of the record, returns NULL if it is empty
+    const void* readBlob(unsigned int& size) {
+        size = read<unsigned int>();
+        if (cursor + size > recordEnd) {
+            isRecordValid = false;
+            size = 0;
+        }
+        const void* data = size > 0 ? &trace[cursor] : NULL;
+        cursor += size;
+        return data;
+    }
+
+    //reads a blob of the record
+    const void* readBlob() {
+        unsigned int size;
+        return readBlob(size);
+    }
+
+    //returns memory the driver can write a result to
+    void* getScratch(size_t size) {
+        if (scratch.size() < size) {
+            scratch.resize(size);
+        }
+        return scratch.data();
+    }
+
+    //returns the pixels a texture upload reads, the bytes in the trace with the pixel unpack buffer unbound if the
+    //trace has them, or the pointer as it was recorded
+    const void* beginUnpack(const void* pixels) {
+        unsigned int size;
+        const void* data = readBlob(size);
+        if (data == NULL) {
+            return pixels;
+        }
+
+        isUnpackRedirected = pixelUnpackBuffer != 0;
+        if (isUnpackRedirected) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        return data;
+    }
+
+    //binds the pixel unpack buffer again after an upload from the trace
+    void endUnpack() {
+        if (isUnpackRedirected) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelUnpackBuffer);
+            isUnpackRedirected = false;
+        }
+    }
+
+    //returns the replayed location of a traced location of the program in use
+    GLint getLocation(GLint location) {
+        std::unordered_map<unsigned long long, GLint>::iterator it = uniformLocations.find(((unsigned long long)program << 32) | (unsigned int)location);
+        return it == uniformLocations.end() ? location : it->second;
+    }
+
+    //returns the replayed fence of a traced fence
+    GLsync getSync(GLsync sync) {
+        std::unordered_map<unsigned long long, GLsync>::iterator it = syncs.find((unsigned long long)(uintptr_t)sync);
+        return it == syncs.end() ? NULL : it->second;
+    }
+
+    //makes objects with a glGen function and maps the names of the trace to them
+    template <typename Function>
+    void generate(GLNameMap& map, Function function, GLsizei count) {
+        const GLuint* names = (const GLuint*)readBlob();
+        std::vector<GLuint> replayed(glm::max(count, 0));
+        function(count, replayed.data());
+        for (int i = 0; names != NULL && i < count; i++) {
+            map.set(names[i], replayed[i]);
+        }
+    }
+
+    //deletes objects with a glDelete function and forgets their names
+    template <typename Function>
+    void remove(GLNameMap& map, Function function, GLsizei count) {
+        const GLuint* names = (const GLuint*)readBlob();
+        if (names == NULL) {
+            return;
+        }
+
+        std::vector<GLuint> replayed(count);
+        for (int i = 0; i < count; i++) {
+            replayed[i] = map.get(names[i]);
+            map.erase(names[i]);
+        }
+        function(count, replayed.data());
+    }
+
+    //returns the mean, percentiles, and max of the frame times of every loop
+    void getStatistics(double& mean, double& p50, double& p95, double& max) {
+        std::vector<double> values;
+        for (int loop = 0; loop < frameMilliseconds.size(); loop++) {
+            values.insert(values.end(), frameMilliseconds[loop].begin(), frameMilliseconds[loop].end());
+        }
+        std::sort(values.begin(), values.end());
+
+        double sum = 0.0;
+        for (int i = 0; i < values.size(); i++) {
+            sum += values[i];
+        }
+        mean = values.empty() ? 0.0 : sum / values.size();
+        p50 = GPUProfiler::percentile(values, 50.0);
+        p95 = GPUProfiler::percentile(values, 95.0);
+        max = values.empty() ? 0.0 : values.back();
+    }
+
+    //returns the mean time of a frame over the loops
+    double getFrameMean(int frame) {
+        double sum = 0.0;
+        for (int loop = 0; loop < frameMilliseconds.size(); loop++) {
+            sum += frameMilliseconds[loop][frame];
+        }
+        return frameMilliseconds.empty() ? 0.0 : sum / frameMilliseconds.size();
+    }
+
+    //logs the frame times and the slowest frame of the trace
+    void report() {
+        double mean, p50, p95, max;
+        getStatistics(mean, p50, p95, max);
+        LOG_INFO("REPLAY", "[REPLAY] {} frames x {} loops: {.3} ms mean, {.3} ms p50, {.3} ms p95, {.3} ms max",
+            (int)frames.size(), (int)frameMilliseconds.size(), mean, p50, p95, max);
+
+        int slowest = 0;
+        for (int i = 1; i < frames.size(); i++) {
+            if (getFrameMean(i) > getFrameMean(slowest)) {
+                slowest = i;
+            }
+        }
+        if (!frames.empty()) {
+            LOG_INFO("REPLAY", "[REPLAY] Slowest frame is {} at {.3} ms mean", slowest, getFrameMean(slowest));
+        }
+    }
+
+    //writes the frame times to a json file
+    void exportJSON(std::string outputPath) {
+        std::ofstream file(outputPath);
+        if (!file.is_open()) {
+            LOG_ERROR("REPLAY", "[REPLAY] Unable to write {}", outputPath);
+            return;
+        }
+
+        double mean, p50, p95, max;
+        getStatistics(mean, p50, p95, max);
+
+        file << std::fixed << std::setprecision(4);
+        file << "{\n";
+        file << "  \"trace\": \"" << path << "\",\n";
+        file << "  \"renderer\": \"" << (const char*)glGetString(GL_RENDERER) << "\",\n";
+        file << "  \"version\": \"" << (const char*)glGetString(GL_VERSION) << "\",\n";
+        file << "  \"frames\": " << frames.size() << ",\n";
+        file << "  \"loops\": " << frameMilliseconds.size() << ",\n";
+        file << "  \"skippedCalls\": " << skippedCalls << ",\n";
+        file << "  \"setupMs\": " << setupMilliseconds << ",\n";
+        file << "  \"frameMs\": { \"mean\": " << mean << ", \"p50\": " << p50 << ", \"p95\": " << p95 << ", \"max\": " << max << " },\n";
+        file << "  \"frameMeanMs\": [";
+        for (int i = 0; i < frames.size(); i++) {
+            file << (i > 0 ? ", " : "") << getFrameMean(i);
+        }
+        file << "]\n}\n";
+
+        LOG_INFO("REPLAY", "[REPLAY] Results written to {}", outputPath);
+    }
+};
+
+//GLPlayer struct makes the call of a record with the arguments read from it, the entry points without a
+//specialization are called with the arguments as they were recorded
+template <int Call>
+struct GLPlayer {
+    template <typename Function, typename... Args>
+    static void play(GLReplayer& /*replayer*/, Function function, Args... args) {
+        function(args...);
+    }
+};
+
+//starts the specialization of GLPlayer for an entry point
+#define GL_PLAYER(name) template <> struct GLPlayer<GL_CALL_##name>
+
+//makes objects with a glGen function
+#define GL_PLAY_GENERATED(name, map) \
+    template <> struct GLPlayer<GL_CALL_##name> { \
+        template <typename Function> \
+        static void play(GLReplayer& replayer, Function function, GLsizei count, GLuint* /*names*/) { \
+            replayer.generate(replayer.map, function, count); \
+        } \
+    };
+
+//deletes objects with a glDelete function
+#define GL_PLAY_DELETED(name, map) \
+    template <> struct GLPlayer<GL_CALL_##name> { \
+        template <typename Function> \
+        static void play(GLReplayer& replayer, Function function, GLsizei count, const GLuint* /*names*/) { \
+            replayer.remove(replayer.map, function, count); \
+        } \
+    };
+
+GL_PLAY_GENERATED(glGenBuffers, buffers)
+GL_PLAY_GENERATED(glGenFramebuffers, framebuffers)
+GL_PLAY_GENERATED(glGenQueries, queries)
+GL_PLAY_GENERATED(glGenRenderbuffers, renderbuffers)
+GL_PLAY_GENERATED(glGenTextures, textures)
+GL_PLAY_GENERATED(glGenVertexArrays, vertexArrays)
+
+GL_PLAY_DELETED(glDeleteBuffers, buffers)
+GL_PLAY_DELETED(glDeleteFramebuffers, framebuffers)
+GL_PLAY_DELETED(glDeleteQueries, queries)
+GL_PLAY_DELETED(glDeleteRenderbuffers, renderbuffers)
+GL_PLAY_DELETED(glDeleteTextures, textures)
+GL_PLAY_DELETED(glDeleteVertexArrays, vertexArrays)
+
+#undef GL_PLAY_GENERATED
+#undef GL_PLAY_DELETED
+
+GL_PLAYER(glBindBuffer) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLuint buffer) {
+        GLuint replayed = replayer.buffers.get(buffer);
+        if (target == GL_PIXEL_UNPACK_BUFFER) {
+            replayer.pixelUnpackBuffer = replayed;
+        }
+        if (target == GL_PIXEL_PACK_BUFFER) {
+            replayer.pixelPackBuffer = replayed;
+        }
+        function(target, replayed);
+    }
+};
+
+GL_PLAYER(glBindFramebuffer) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLuint framebuffer) {
+        function(target, replayer.framebuffers.get(framebuffer));
+    }
+};
+
+GL_PLAYER(glBindRenderbuffer) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLuint renderbuffer) {
+        function(target, replayer.renderbuffers.get(renderbuffer));
+    }
+};
+
+GL_PLAYER(glBindTexture) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLuint texture) {
+        function(target, replayer.textures.get(texture));
+    }
+};
+
+GL_PLAYER(glBindVertexArray) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint vertexArray) {
+        function(replayer.vertexArrays.get(vertexArray));
+    }
+};
+
+GL_PLAYER(glFramebufferTexture2D) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLenum attachment, GLenum textureTarget, GLuint texture, GLint level) {
+        function(target, attachment, textureTarget, replayer.textures.get(texture), level);
+    }
+};
+
+GL_PLAYER(glFramebufferRenderbuffer) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLenum attachment, GLenum renderbufferTarget, GLuint renderbuffer) {
+        function(target, attachment, renderbufferTarget, replayer.renderbuffers.get(renderbuffer));
+    }
+};
+
+GL_PLAYER(glCopyImageSubData) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint source, GLenum sourceTarget, GLint sourceLevel, GLint sourceX, GLint sourceY, GLint sourceZ,
+        GLuint destination, GLenum destinationTarget, GLint destinationLevel, GLint destinationX, GLint destinationY, GLint destinationZ, GLsizei width, GLsizei height, GLsizei depth) {
+        GLNameMap& sourceMap = sourceTarget == GL_RENDERBUFFER ? replayer.renderbuffers : replayer.textures;
+        GLNameMap& destinationMap = destinationTarget == GL_RENDERBUFFER ? replayer.renderbuffers : replayer.textures;
+        function(sourceMap.get(source), sourceTarget, sourceLevel, sourceX, sourceY, sourceZ,
+            destinationMap.get(destination), destinationTarget, destinationLevel, destinationX, destinationY, destinationZ, width, height, depth);
+    }
+};
+
+GL_PLAYER(glQueryCounter) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint query, GLenum target) {
+        function(replayer.queries.get(query), target);
+    }
+};
+
+GL_PLAYER(glGetQueryObjectiv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint query, GLenum name, GLint* /*value*/) {
+        function(replayer.queries.get(query), name, (GLint*)replayer.getScratch(sizeof(GLint)));
+    }
+};
+
+GL_PLAYER(glGetQueryObjectui64v) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint query, GLenum name, GLuint64* /*value*/) {
+        function(replayer.queries.get(query), name, (GLuint64*)replayer.getScratch(sizeof(GLuint64)));
+    }
+};
+
+GL_PLAYER(glFenceSync) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum condition, GLbitfield flags) {
+        GLsync sync = function(condition, flags);
+        replayer.syncs[replayer.read<unsigned long long>()] = sync;
+    }
+};
+
+GL_PLAYER(glClientWaitSync) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLsync sync, GLbitfield flags, GLuint64 timeout) {
+        GLsync replayed = replayer.getSync(sync);
+        if (replayed) {
+            function(replayed, flags, timeout);
+        }
+    }
+};
+
+GL_PLAYER(glDeleteSync) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLsync sync) {
+        GLsync replayed = replayer.getSync(sync);
+        if (replayed) {
+            function(replayed);
+            replayer.syncs.erase((unsigned long long)(uintptr_t)sync);
+        }
+    }
+};
+
+GL_PLAYER(glGetIntegerv) {
+    //no query of the program returns more than a rectangle
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum name, GLint* /*values*/) {
+        function(name, (GLint*)replayer.getScratch(16 * sizeof(GLint)));
+    }
+};
+
+GL_PLAYER(glReadPixels) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels) {
+        if (replayer.pixelPackBuffer != 0) {
+            function(x, y, width, height, format, type, pixels);
+            return;
+        }
+
+        //room for the rows at any pack alignment
+        size_t rowSize = (size_t)width * GLInterceptor::getPixelSize(format, type) + 8;
+        function(x, y, width, height, format, type, replayer.getScratch(rowSize * height));
+    }
+};
+
+GL_PLAYER(glCreateShader) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum type) {
+        GLuint shader = function(type);
+        replayer.shaderObjects.set(replayer.read<GLuint>(), shader);
+    }
+};
+
+GL_PLAYER(glCreateProgram) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function) {
+        GLuint program = function();
+        replayer.shaderObjects.set(replayer.read<GLuint>(), program);
+    }
+};
+
+GL_PLAYER(glShaderSource) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint shader, GLsizei count, const GLchar* const* /*strings*/, const GLint* /*lengths*/) {
+        std::vector<const GLchar*> sources(count);
+        std::vector<GLint> sourceLengths(count);
+        for (int i = 0; i < count; i++) {
+            unsigned int size;
+            sources[i] = (const GLchar*)replayer.readBlob(size);
+            sourceLengths[i] = size;
+        }
+        function(replayer.shaderObjects.get(shader), count, sources.data(), sourceLengths.data());
+    }
+};
+
+GL_PLAYER(glCompileShader) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint shader) {
+        function(replayer.shaderObjects.get(shader));
+    }
+};
+
+GL_PLAYER(glGetShaderiv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint shader, GLenum name, GLint* /*value*/) {
+        function(replayer.shaderObjects.get(shader), name, (GLint*)replayer.getScratch(sizeof(GLint)));
+    }
+};
+
+GL_PLAYER(glGetShaderInfoLog) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint shader, GLsizei size, GLsizei* /*length*/, GLchar* /*log*/) {
+        function(replayer.shaderObjects.get(shader), size, NULL, (GLchar*)replayer.getScratch(glm::max(size, 1)));
+    }
+};
+
+GL_PLAYER(glDeleteShader) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint shader) {
+        function(replayer.shaderObjects.get(shader));
+        replayer.shaderObjects.erase(shader);
+    }
+};
+
+GL_PLAYER(glAttachShader) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, GLuint shader) {
+        function(replayer.shaderObjects.get(program), replayer.shaderObjects.get(shader));
+    }
+};
+
+GL_PLAYER(glDetachShader) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, GLuint shader) {
+        function(replayer.shaderObjects.get(program), replayer.shaderObjects.get(shader));
+    }
+};
+
+GL_PLAYER(glProgramParameteri) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, GLenum name, GLint value) {
+        function(replayer.shaderObjects.get(program), name, value);
+    }
+};
+
+GL_PLAYER(glLinkProgram) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program) {
+        function(replayer.shaderObjects.get(program));
+    }
+};
+
+GL_PLAYER(glProgramBinary) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, GLenum format, const void* /*binary*/, GLsizei length) {
+        const void* data = replayer.readBlob();
+        function(replayer.shaderObjects.get(program), format, data, length);
+    }
+};
+
+GL_PLAYER(glGetProgramBinary) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, GLsizei size, GLsizei* /*length*/, GLenum* /*format*/, void* /*binary*/) {
+        GLenum* replayedFormat = (GLenum*)replayer.getScratch(sizeof(GLenum) + glm::max(size, 1));
+        function(replayer.shaderObjects.get(program), size, NULL, replayedFormat, replayedFormat + 1);
+    }
+};
+
+GL_PLAYER(glGetProgramiv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, GLenum name, GLint* /*value*/) {
+        function(replayer.shaderObjects.get(program), name, (GLint*)replayer.getScratch(sizeof(GLint)));
+    }
+};
+
+GL_PLAYER(glGetProgramInfoLog) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, GLsizei size, GLsizei* /*length*/, GLchar* /*log*/) {
+        function(replayer.shaderObjects.get(program), size, NULL, (GLchar*)replayer.getScratch(glm::max(size, 1)));
+    }
+};
+
+GL_PLAYER(glDeleteProgram) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program) {
+        function(replayer.shaderObjects.get(program));
+        replayer.shaderObjects.erase(program);
+    }
+};
+
+GL_PLAYER(glUseProgram) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program) {
+        replayer.program = replayer.shaderObjects.get(program);
+        function(replayer.program);
+    }
+};
+
+GL_PLAYER(glGetUniformLocation) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLuint program, const GLchar* /*name*/) {
+        GLuint replayedProgram = replayer.shaderObjects.get(program);
+        GLint location = function(replayedProgram, (const GLchar*)replayer.readBlob());
+        GLint tracedLocation = replayer.read<GLint>();
+        if (tracedLocation >= 0) {
+            replayer.uniformLocations[((unsigned long long)replayedProgram << 32) | (unsigned int)tracedLocation] = location;
+        }
+    }
+};
+
+GL_PLAYER(glUniform1i) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLint location, GLint value) {
+        function(replayer.getLocation(location), value);
+    }
+};
+
+GL_PLAYER(glUniform1f) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLint location, GLfloat value) {
+        function(replayer.getLocation(location), value);
+    }
+};
+
+GL_PLAYER(glUniform2fv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLint location, GLsizei count, const GLfloat* /*value*/) {
+        function(replayer.getLocation(location), count, (const GLfloat*)replayer.readBlob());
+    }
+};
+
+GL_PLAYER(glUniform3fv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLint location, GLsizei count, const GLfloat* /*value*/) {
+        function(replayer.getLocation(location), count, (const GLfloat*)replayer.readBlob());
+    }
+};
+
+GL_PLAYER(glUniformMatrix3fv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLint location, GLsizei count, GLboolean transpose, const GLfloat* /*value*/) {
+        function(replayer.getLocation(location), count, transpose, (const GLfloat*)replayer.readBlob());
+    }
+};
+
+GL_PLAYER(glUniformMatrix4fv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLint location, GLsizei count, GLboolean transpose, const GLfloat* /*value*/) {
+        function(replayer.getLocation(location), count, transpose, (const GLfloat*)replayer.readBlob());
+    }
+};
+
+GL_PLAYER(glBufferData) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLsizeiptr size, const void* /*data*/, GLenum usage) {
+        function(target, size, replayer.readBlob(), usage);
+    }
+};
+
+GL_PLAYER(glBufferStorage) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLsizeiptr size, const void* /*data*/, GLbitfield flags) {
+        function(target, size, replayer.readBlob(), flags);
+    }
+};
+
+GL_PLAYER(glBufferSubData) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLintptr offset, GLsizeiptr size, const void* /*data*/) {
+        const void* replayed = replayer.readBlob();
+        if (replayed) {
+            function(target, offset, size, replayed);
+        }
+    }
+};
+
+GL_PLAYER(glTexImage2D) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+        function(target, level, internalFormat, width, height, border, format, type, replayer.beginUnpack(pixels));
+        replayer.endUnpack();
+    }
+};
+
+GL_PLAYER(glTexImage3D) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels) {
+        function(target, level, internalFormat, width, height, depth, border, format, type, replayer.beginUnpack(pixels));
+        replayer.endUnpack();
+    }
+};
+
+GL_PLAYER(glTexSubImage2D) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+        function(target, level, x, y, width, height, format, type, replayer.beginUnpack(pixels));
+        replayer.endUnpack();
+    }
+};
+
+GL_PLAYER(glTexSubImage3D) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
+        function(target, level, x, y, z, width, height, depth, format, type, replayer.beginUnpack(pixels));
+        replayer.endUnpack();
+    }
+};
+
+GL_PLAYER(glDrawBuffers) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLsizei count, const GLenum* /*buffers*/) {
+        function(count, (const GLenum*)replayer.readBlob());
+    }
+};
+
+GL_PLAYER(glClearBufferfv) {
+    template <typename Function>
+    static void play(GLReplayer& replayer, Function function, GLenum buffer, GLint drawBuffer, const GLfloat* /*value*/) {
+        function(buffer, drawBuffer, (const GLfloat*)replayer.readBlob());
+    }
+};
+
+#undef GL_PLAYER
+
+//GLArgumentReader struct reads the arguments of a record one at a time in order and passes them to the player
+template <int Call, typename Function, typename... Remaining>
+struct GLArgumentReader;
+
+template <int Call, typename Function>
+struct GLArgumentReader<Call, Function> {
+    template <typename... Read>
+    static void play(GLReplayer& replayer, Function function, Read... read) {
+        GLPlayer<Call>::play(replayer, function, read...);
+    }
+};
+
+template <int Call, typename Function, typename Next, typename... Remaining>
+struct GLArgumentReader<Call, Function, Next, Remaining...> {
+    template <typename... Read>
+    static void play(GLReplayer& replayer, Function function, Read... read) {
+        Next next = replayer.read<Next>();
+        GLArgumentReader<Call, Function, Remaining...>::play(replayer, function, read..., next);
+    }
+};
+
+//GLPlayback struct reads the arguments of a record with the types of the glad function pointer of its entry point
+template <int Call, typename Function>
+struct GLPlayback;
+
+template <int Call, typename Result, typename... Args>
+struct GLPlayback<Call, Result (APIENTRYP)(Args...)> {
+    static void play(GLReplayer& replayer, Result (APIENTRYP function)(Args...)) {
+        GLArgumentReader<Call, Result (APIENTRYP)(Args...), Args...>::play(replayer, function);
+    }
+};
+
+inline void GLReplayer::dispatch(int call) {
+    switch (call) {
+#define GL_PLAY_CALL(name) \
+        case GL_CALL_##name: \
+            if (glad_##name == NULL) { \
+                skippedCalls++; \
+                return; \
+            } \
+            GLPlayback<GL_CALL_##name, decltype(glad_##name)>::play(*this, glad_##name); \
+            break;
+        GL_INTERCEPTED_CALLS(GL_PLAY_CALL)
+#undef GL_PLAY_CALL
+    }
+}
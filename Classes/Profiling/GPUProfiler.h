@@ -0,0 +1,299 @@
+#pragma once
+
+//GPUProfiler class measures the gpu time spent inside named scopes of a frame using timestamp queries
+class GPUProfiler {
+public:
+    static const int BUFFER_COUNT = 2; //number of frames that own a set of queries (results are read one frame late so the cpu never waits)
+    static const int MAX_SCOPES = 64; //maximum number of scopes that can be recorded in a single frame
+    static const int WINDOW_SIZE = 300; //number of samples kept per scope for the rolling statistics
+    static const int DROPPED_SCOPE = -1; //entry of the scope stack for a scope that got no queries
+
+    //stores a scope that was recorded during a frame
+    struct ScopeRecord {
+        std::string name; //name of the scope
+        int depth; //nesting level of the scope
+        GLuint beginQuery, endQuery; //timestamp queries issued at the start and the end of the scope
+    };
+
+    //stores the summarized timings of a scope in milliseconds
+    struct ScopeStats {
+        std::string name;
+        int depth;
+        int sampleCount;
+        double min, avg, p99, last;
+    };
+
+    std::vector<GLuint> queries; //pool of query objects shared by all the frame buffers
+    std::vector<ScopeRecord> frames[BUFFER_COUNT]; //scopes recorded in each of the frame buffers
+    bool isPending[BUFFER_COUNT]; //checks if the frame buffer contains results that have not been read yet
+    std::vector<int> scopeStack; //indices of the scopes that are currently open
+    int frameIndex; //number of frames that have been started
+    int droppedFrames; //number of frames whose results were not ready when their queries had to be reused
+
+    std::vector<std::string> scopeOrder; //names of the scopes in the order they first appeared
+    std::map<std::string, int> scopeDepths; //nesting level of each scope
+    std::map<std::string, std::deque<double>> samples; //rolling window of the timings of each scope in milliseconds
+    bool isKeepingHistory; //checks if every timing is also kept outside of the rolling window
+    std::map<std::string, std::vector<double>> history; //every timing of each scope since the history was enabled
+
+    //constructor for the gpu profiler class
+    GPUProfiler() {
+        //generate all the queries up front so that no gl objects are created while rendering
+        queries.resize(BUFFER_COUNT * MAX_SCOPES * 2);
+        glGenQueries(queries.size(), queries.data());
+
+        for (int i = 0; i < BUFFER_COUNT; i++) {
+            isPending[i] = false;
+        }
+
+        frameIndex = 0;
+        droppedFrames = 0;
+        isKeepingHistory = false;
+    }
+
+    //destructor for the gpu profiler class
+    ~GPUProfiler() {
+        glDeleteQueries(queries.size(), queries.data());
+    }
+
+    //starts recording the scopes of a new frame
+    void beginFrame() {
+        int buffer = frameIndex % BUFFER_COUNT;
+
+        //read the results of the frame that last used this buffer before its queries are reused
+        if (isPending[buffer]) {
+            collectResults(buffer);
+        }
+
+        frames[buffer].clear();
+        scopeStack.clear();
+
+        beginScope("Frame");
+    }
+
+    //finishes recording the scopes of the current frame
+    void endFrame() {
+        //close any scope that was left open so that the frame is always complete
+        while (!scopeStack.empty()) {
+            endScope();
+        }
+
+        isPending[frameIndex % BUFFER_COUNT] = true;
+        frameIndex++;
+    }
+
+    //marks the start of a named scope on the gpu timeline
+    void beginScope(const std::string& name) {
+        int buffer = frameIndex % BUFFER_COUNT;
+        std::vector<ScopeRecord>& records = frames[buffer];
+
+        //ignore the scope if the query pool of the frame is exhausted, its end still has to close it and not the scope around it
+        if (records.size() >= MAX_SCOPES) {
+            scopeStack.push_back((int)DROPPED_SCOPE);
+            return;
+        }
+
+        //assign a pair of queries from the pool of the current frame buffer
+        int queryOffset = (buffer * MAX_SCOPES + records.size()) * 2;
+
+        ScopeRecord record;
+        record.name = name;
+        record.depth = scopeStack.size();
+        record.beginQuery = queries[queryOffset];
+        record.endQuery = queries[queryOffset + 1];
+
+        //timestamps can be nested unlike GL_TIME_ELAPSED queries
+        glQueryCounter(record.beginQuery, GL_TIMESTAMP);
+
+        scopeStack.push_back(records.size());
+        records.push_back(record);
+    }
+
+    //marks the end of the most recently opened scope on the gpu timeline
+    void endScope() {
+        if (scopeStack.empty()) {
+            return;
+        }
+
+        std::vector<ScopeRecord>& records = frames[frameIndex % BUFFER_COUNT];
+        if (scopeStack.back() != DROPPED_SCOPE) {
+            glQueryCounter(records[scopeStack.back()].endQuery, GL_TIMESTAMP);
+        }
+        scopeStack.pop_back();
+    }
+
+    //reads the query results of a frame buffer and adds them to the rolling window
+    void collectResults(int buffer) {
+        std::vector<ScopeRecord>& records = frames[buffer];
+        isPending[buffer] = false;
+
+        if (records.empty()) {
+            return;
+        }
+
+        //the frame scope is closed last, so checking its end query is enough to know if the whole frame is ready
+        GLint isAvailable = 0;
+        glGetQueryObjectiv(records[0].endQuery, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (!isAvailable) {
+            //skip the frame instead of stalling the pipeline
+            droppedFrames++;
+            return;
+        }
+
+        for (int i = 0; i < records.size(); i++) {
+            GLuint64 beginTime = 0, endTime = 0;
+            glGetQueryObjectui64v(records[i].beginQuery, GL_QUERY_RESULT, &beginTime);
+            glGetQueryObjectui64v(records[i].endQuery, GL_QUERY_RESULT, &endTime);
+
+            addSample(records[i].name, records[i].depth, (endTime - beginTime) / 1000000.0);
+        }
+    }
+
+    //waits for the gpu and reads the results of every frame that is still pending
+    void flush() {
+        glFinish();
+
+        for (int i = 1; i <= BUFFER_COUNT; i++) {
+            int buffer = (frameIndex + i) % BUFFER_COUNT;
+            if (isPending[buffer]) {
+                collectResults(buffer);
+            }
+        }
+    }
+
+    //adds a timing to the rolling window of a scope
+    void addSample(std::string name, int depth, double milliseconds) {
+        //register the scope the first time it is seen
+        if (samples.find(name) == samples.end()) {
+            scopeOrder.push_back(name);
+            scopeDepths[name] = depth;
+        }
+
+        std::deque<double>& window = samples[name];
+        window.push_back(milliseconds);
+
+        if (isKeepingHistory) {
+            history[name].push_back(milliseconds);
+        }
+
+        //discard the oldest sample once the window is full
+        if (window.size() > WINDOW_SIZE) {
+            window.pop_front();
+        }
+    }
+
+    //computes the min, average, and 99th percentile of a series of timings
+    static ScopeStats computeStats(std::string name, int depth, std::vector<double> values) {
+        ScopeStats stats;
+        stats.name = name;
+        stats.depth = depth;
+        stats.sampleCount = values.size();
+        stats.min = stats.avg = stats.p99 = stats.last = 0.0;
+
+        if (values.empty()) {
+            return stats;
+        }
+
+        stats.last = values.back();
+
+        double sum = 0.0;
+        for (int i = 0; i < values.size(); i++) {
+            sum += values[i];
+        }
+        stats.avg = sum / values.size();
+
+        std::sort(values.begin(), values.end());
+        stats.min = values.front();
+        stats.p99 = percentile(values, 99.0);
+
+        return stats;
+    }
+
+    //returns the value at the given percentile of a sorted series using the nearest rank
+    static double percentile(const std::vector<double>& sortedValues, double rank) {
+        if (sortedValues.empty()) {
+            return 0.0;
+        }
+
+        int index = (int)std::ceil(rank / 100.0 * sortedValues.size()) - 1;
+        index = glm::clamp(index, 0, (int)sortedValues.size() - 1);
+
+        return sortedValues[index];
+    }
+
+    //returns the statistics of every scope that has been recorded
+    std::vector<ScopeStats> getStats() {
+        std::vector<ScopeStats> stats;
+
+        for (int i = 0; i < scopeOrder.size(); i++) {
+            std::deque<double>& window = samples[scopeOrder[i]];
+            stats.push_back(computeStats(scopeOrder[i], scopeDepths[scopeOrder[i]], std::vector<double>(window.begin(), window.end())));
+        }
+
+        return stats;
+    }
+
+    //writes the statistics of every scope to a csv file
+    void exportCSV(std::string path) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            return;
+        }
+
+        std::vector<ScopeStats> stats = getStats();
+
+        file << "scope,depth,samples,min_ms,avg_ms,p99_ms,last_ms\n";
+        for (int i = 0; i < stats.size(); i++) {
+            file << stats[i].name << "," << stats[i].depth << "," << stats[i].sampleCount << ","
+                << stats[i].min << "," << stats[i].avg << "," << stats[i].p99 << "," << stats[i].last << "\n";
+        }
+    }
+
+    //writes the statistics of every scope to a json file
+    void exportJSON(std::string path) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            return;
+        }
+
+        std::vector<ScopeStats> stats = getStats();
+
+        file << "{\n";
+        file << "  \"frames\": " << frameIndex << ",\n";
+        file << "  \"droppedFrames\": " << droppedFrames << ",\n";
+        file << "  \"windowSize\": " << WINDOW_SIZE << ",\n";
+        file << "  \"scopes\": [\n";
+        for (int i = 0; i < stats.size(); i++) {
+            file << "    { \"name\": \"" << stats[i].name << "\", \"depth\": " << stats[i].depth
+                << ", \"samples\": " << stats[i].sampleCount
+                << ", \"minMs\": " << stats[i].min << ", \"avgMs\": " << stats[i].avg
+                << ", \"p99Ms\": " << stats[i].p99 << ", \"lastMs\": " << stats[i].last << " }"
+                << (i + 1 < stats.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n";
+        file << "}\n";
+    }
+
+    //writes the statistics in both csv and json using the same base path
+    void exportResults(std::string basePath) {
+        exportCSV(basePath + ".csv");
+        exportJSON(basePath + ".json");
+    }
+};
+
+//GPUScope class records a gpu profiler scope for as long as it is alive
+class GPUScope {
+public:
+    GPUProfiler* profiler;
+
+    //constructor for the gpu scope class which opens the scope
+    GPUScope(GPUProfiler* profiler, const std::string& name) {
+        this->profiler = profiler;
+        this->profiler->beginScope(name);
+    }
+
+    //destructor for the gpu scope class which closes the scope
+    ~GPUScope() {
+        profiler->endScope();
+    }
+};
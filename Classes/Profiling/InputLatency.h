@@ -0,0 +1,41 @@
+#pragma once
+
+//InputLatency class measures the time from an input event to the present of the first frame that shows it
+class InputLatency {
+public:
+    std::vector<double> samples; //latency of every frame that showed new input in milliseconds
+    double lastInputTime; //time of the newest input that was already measured
+
+    //constructor for the input latency class
+    InputLatency() {
+        lastInputTime = 0.0;
+    }
+
+    //records the latency of a presented frame if it shows input that no earlier frame showed
+    void record(double inputTime, double presentTime) {
+        if (inputTime <= lastInputTime) {
+            return;
+        }
+
+        samples.push_back((presentTime - inputTime) * 1000.0);
+        lastInputTime = inputTime;
+    }
+
+    //prints the mean and percentiles of the measured latencies
+    void print() {
+        if (samples.empty()) {
+            return;
+        }
+
+        double sum = 0.0;
+        for (int i = 0; i < samples.size(); i++) {
+            sum += samples[i];
+        }
+
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        LOG_INFO("INPUT", "[INPUT] input to present latency over {} frames: mean {.2} ms, p50 {.2} ms, p95 {.2} ms",
+            samples.size(), sum / samples.size(), GPUProfiler::percentile(sorted, 50.0), GPUProfiler::percentile(sorted, 95.0));
+    }
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+//RenderStats class counts the work submitted to the gpu during a frame
+class RenderStats {
+public:
+    int drawCalls; //number of draw calls issued in the frame
+    long long triangles; //number of triangles submitted in the frame
+    int culledModels; //number of models skipped because they were outside the view
+
+    //constructor for the render stats class
+    RenderStats() {
+        reset();
+    }
+
+    //clears the counters at the start of a frame
+    void reset() {
+        drawCalls = 0;
+        triangles = 0;
+        culledModels = 0;
+    }
+
+    //counts a draw call with the given number of triangles
+    void addDraw(long long triangleCount) {
+        drawCalls++;
+        triangles += triangleCount;
+    }
+};
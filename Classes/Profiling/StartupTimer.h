@@ -0,0 +1,44 @@
+#pragma once
+
+//StartupTimer class measures how long the program takes to show its first frame and to finish loading every model
+//
+//the two are reported separately since the models stream in after the first frame. the timer starts when it is
+//constructed, so a global timer measures from the launch of the program.
+class StartupTimer {
+public:
+    std::chrono::steady_clock::time_point startTime; //time when the timer was created
+    double firstFrameMilliseconds; //time until the first frame was presented, -1 until it was
+    double fullyLoadedMilliseconds; //time until every model was loaded, -1 until they were
+
+    //constructor for the startup timer class
+    StartupTimer() {
+        startTime = std::chrono::steady_clock::now();
+        firstFrameMilliseconds = -1.0;
+        fullyLoadedMilliseconds = -1.0;
+    }
+
+    //returns the milliseconds since the timer was created
+    double elapsedMilliseconds() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    //records the first frame, later calls are ignored
+    void markFirstFrame() {
+        if (firstFrameMilliseconds >= 0.0) {
+            return;
+        }
+
+        firstFrameMilliseconds = elapsedMilliseconds();
+        LOG_INFO("STARTUP", "[STARTUP] Time to first frame: {.1} ms", firstFrameMilliseconds);
+    }
+
+    //records the moment every model was loaded, later calls are ignored
+    void markFullyLoaded() {
+        if (fullyLoadedMilliseconds >= 0.0) {
+            return;
+        }
+
+        fullyLoadedMilliseconds = elapsedMilliseconds();
+        LOG_INFO("STARTUP", "[STARTUP] Time to fully loaded: {.1} ms", fullyLoadedMilliseconds);
+    }
+};
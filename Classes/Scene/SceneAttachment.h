@@ -0,0 +1,8 @@
+#pragma once
+
+//SceneAttachment class is the base of the objects that follow a node of the scene graph, such as cameras and lights
+class SceneAttachment {
+public:
+    //moves the object to the world transformation of the node it is attached to
+    virtual void followTransform(glm::mat4 worldTransform) = 0;
+};
@@ -0,0 +1,221 @@
+#pragma once
+
+//identifies a node in the scene graph
+typedef int SceneNode;
+
+//SceneGraph class stores a hierarchy of transformations where every node is placed relative to its parent
+//
+//the nodes are kept in flat arrays sorted breadth first, so a parent is always stored before its children and the
+//world matrices are computed in a single pass from the front of the arrays. a node is only recomputed when its local
+//transformation changed or one of its ancestors was recomputed in the same pass, and the objects attached to a node
+//are only moved when the node was recomputed.
+class SceneGraph {
+public:
+    static const int NO_PARENT = -1; //parent of the root nodes
+
+    //object that follows a node
+    struct Attachment {
+        SceneNode node; //node that the object follows
+        SceneAttachment* object; //object that is moved when the node changes
+    };
+
+    std::vector<int> slots; //index of every node in the flat arrays
+
+    //flat arrays sorted breadth first, the same index refers to the same node in every array
+    std::vector<SceneNode> nodes; //node stored at each index
+    std::vector<int> parents; //index of the parent of each node, NO_PARENT for the roots
+    std::vector<glm::mat4> localTransforms; //transformation relative to the parent
+    std::vector<glm::mat4> worldTransforms; //transformation relative to the world
+    std::vector<unsigned char> dirtyFlags; //checks if the local transformation changed since the last update
+    std::vector<unsigned char> updatedFlags; //checks if the world transformation was recomputed in the last update
+
+    std::vector<Attachment> attachments; //objects that follow the nodes
+    bool isOrderDirty; //checks if nodes were added or moved since the arrays were last sorted
+
+    //constructor for the scene graph class
+    SceneGraph() {
+        isOrderDirty = false;
+    }
+
+    //returns the number of nodes
+    int size() {
+        return nodes.size();
+    }
+
+    //returns the index of a node in the flat arrays, NO_PARENT stays NO_PARENT
+    int indexOf(SceneNode node) {
+        if (node == NO_PARENT) {
+            return -1;
+        }
+        return slots[node];
+    }
+
+    //creates a node placed relative to a parent node, or relative to the world if the parent is NO_PARENT
+    SceneNode create(SceneNode parent, glm::mat4 localTransform) {
+        SceneNode node = slots.size();
+        slots.push_back(nodes.size());
+
+        nodes.push_back(node);
+        parents.push_back(indexOf(parent));
+        localTransforms.push_back(localTransform);
+        worldTransforms.push_back(localTransform);
+        dirtyFlags.push_back(1);
+        updatedFlags.push_back(0);
+
+        isOrderDirty = true;
+        return node;
+    }
+
+    //places a node under another parent, keeping its local transformation
+    void setParent(SceneNode node, SceneNode parent) {
+        int index = slots[node];
+        parents[index] = indexOf(parent);
+        dirtyFlags[index] = 1;
+        isOrderDirty = true;
+    }
+
+    //changes the transformation of a node relative to its parent, the node is left clean if nothing changed
+    void setLocalTransform(SceneNode node, glm::mat4 localTransform) {
+        int index = slots[node];
+        if (localTransforms[index] == localTransform) {
+            return;
+        }
+
+        localTransforms[index] = localTransform;
+        dirtyFlags[index] = 1;
+    }
+
+    //returns the transformation of a node relative to the world as of the last update
+    glm::mat4 getWorldTransform(SceneNode node) {
+        return worldTransforms[slots[node]];
+    }
+
+    //checks if the world transformation of a node was recomputed in the last update
+    bool wasUpdated(SceneNode node) {
+        return updatedFlags[slots[node]] != 0;
+    }
+
+    //makes an object follow a node, the object is moved on the next update
+    void attach(SceneNode node, SceneAttachment* object) {
+        Attachment attachment;
+        attachment.node = node;
+        attachment.object = object;
+        attachments.push_back(attachment);
+
+        dirtyFlags[slots[node]] = 1;
+    }
+
+    //recomputes the world transformation of the changed nodes and moves the objects attached to them
+    //returns the number of nodes that were recomputed
+    int update() {
+        PROFILE_ZONE("SceneGraph::update");
+
+        if (isOrderDirty) {
+            sortBreadthFirst();
+        }
+
+        //the parents come first, so their world transformations are final when their children are reached
+        int updatedCount = 0;
+        for (int i = 0; i < nodes.size(); i++) {
+            int parent = parents[i];
+            bool isParentUpdated = parent != NO_PARENT && updatedFlags[parent];
+
+            updatedFlags[i] = dirtyFlags[i] || isParentUpdated;
+            dirtyFlags[i] = 0;
+
+            if (updatedFlags[i]) {
+                worldTransforms[i] = parent == NO_PARENT ? localTransforms[i] : worldTransforms[parent] * localTransforms[i];
+                updatedCount++;
+            }
+        }
+
+        for (int i = 0; i < attachments.size(); i++) {
+            int index = slots[attachments[i].node];
+            if (updatedFlags[index]) {
+                attachments[i].object->followTransform(worldTransforms[index]);
+            }
+        }
+
+        return updatedCount;
+    }
+
+    //reorders the flat arrays so that the roots come first, followed by their children, then their grandchildren
+    void sortBreadthFirst() {
+        int count = nodes.size();
+
+        //link the children of every node in the order they are stored
+        std::vector<int> firstChild(count, -1);
+        std::vector<int> lastChild(count, -1);
+        std::vector<int> nextSibling(count, -1);
+        std::vector<int> order;
+        order.reserve(count);
+
+        for (int i = 0; i < count; i++) {
+            int parent = parents[i];
+            if (parent == NO_PARENT) {
+                order.push_back(i);
+            }
+            else if (firstChild[parent] == NO_PARENT) {
+                firstChild[parent] = lastChild[parent] = i;
+            }
+            else {
+                nextSibling[lastChild[parent]] = i;
+                lastChild[parent] = i;
+            }
+        }
+
+        //visit the nodes level by level, the order array doubles as the queue of the search
+        for (int i = 0; i < order.size(); i++) {
+            for (int child = firstChild[order[i]]; child != NO_PARENT; child = nextSibling[child]) {
+                order.push_back(child);
+            }
+        }
+
+        //nodes whose parents form a cycle are never reached, so they are kept at the end as roots
+        if (order.size() < count) {
+            std::vector<unsigned char> isVisited(count, 0);
+            for (int i = 0; i < order.size(); i++) {
+                isVisited[order[i]] = 1;
+            }
+            for (int i = 0; i < count; i++) {
+                if (!isVisited[i]) {
+                    parents[i] = NO_PARENT;
+                    order.push_back(i);
+                }
+            }
+        }
+
+        //find where every old index moved to
+        std::vector<int> newIndex(count);
+        for (int i = 0; i < count; i++) {
+            newIndex[order[i]] = i;
+        }
+
+        std::vector<SceneNode> sortedNodes(count);
+        std::vector<int> sortedParents(count);
+        std::vector<glm::mat4> sortedLocal(count);
+        std::vector<glm::mat4> sortedWorld(count);
+        std::vector<unsigned char> sortedDirty(count);
+        std::vector<unsigned char> sortedUpdated(count);
+
+        for (int i = 0; i < count; i++) {
+            int from = order[i];
+            sortedNodes[i] = nodes[from];
+            sortedParents[i] = parents[from] == NO_PARENT ? -1 : newIndex[parents[from]];
+            sortedLocal[i] = localTransforms[from];
+            sortedWorld[i] = worldTransforms[from];
+            sortedDirty[i] = dirtyFlags[from];
+            sortedUpdated[i] = updatedFlags[from];
+            slots[nodes[from]] = i;
+        }
+
+        nodes.swap(sortedNodes);
+        parents.swap(sortedParents);
+        localTransforms.swap(sortedLocal);
+        worldTransforms.swap(sortedWorld);
+        dirtyFlags.swap(sortedDirty);
+        updatedFlags.swap(sortedUpdated);
+
+        isOrderDirty = false;
+    }
+};
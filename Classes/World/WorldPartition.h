@@ -0,0 +1,412 @@
+#pragma once
+
+//a square of the world grid and the models placed in it
+struct WorldCell {
+    int x, z; //coordinates of the cell in the grid, the cell covers [x, x + 1) * cellSize on the x axis and likewise on z
+    std::vector<ModelRequest> models; //manifest of the models in the cell
+    bool isLoaded; //checks if the entities of the cell exist
+    std::vector<Entity> entities; //entity of every model while the cell is loaded
+    std::vector<Model*> assets; //mesh and textures of every model, NULL until the model arrives
+};
+
+//WorldPartition class splits the world into a grid of cells that are loaded around a point and unloaded away from it
+//
+//the world is described by a manifest that lists the models of every cell. a cell is loaded once its closest point is
+//within loadRadius of the player: its models get placeholder entities right away and are requested from the streamer,
+//which reads them on the loader thread. a cell is unloaded once it is farther than unloadRadius, which is larger so
+//that moving back and forth over the edge of a cell does not load it again and again. the resident models are bounded
+//by the cells within the unload radius instead of by the size of the world.
+//
+//the snapshot that is drawn next may have been built before a cell was unloaded, so the models of an unloaded cell
+//are deleted and their texture layers freed on the following update.
+//
+//the loaded models also stay within the gpu memory budget of the residency manager. while the allocations are over
+//it, the model that was drawn least recently is demoted to a smaller texture array until its color map reaches the
+//minimum size, and then has its mesh evicted so that it is drawn as its placeholder. a model gets its mesh back once
+//its placeholder is drawn and is read again at full size once it is drawn and the budget has room for it. evicted
+//meshes and replaced layers are freed on the following update for the same reason as the unloaded models.
+class WorldPartition {
+public:
+    static const int IDLE_FRAMES = 120; //frames a model must go undrawn before its memory is reclaimed
+
+    float cellSize; //width and depth of a cell in world units
+    float loadRadius; //distance within which a cell is loaded
+    float unloadRadius; //distance beyond which a loaded cell is unloaded
+    std::vector<WorldCell> cells; //cells of the manifest, the grid may have gaps
+    std::map<std::pair<int, int>, int> cellIndices; //index of every cell by its coordinates
+    std::vector<int> loadedCells; //indices of the loaded cells
+    std::map<int, std::pair<int, int>> loading; //cell and slot of every request that has not arrived yet, by request id
+    std::vector<Model*> retiredModels; //models of unloaded cells that are deleted on the next update
+    std::vector<Model*> evictedMeshes; //models whose buffers are deleted on the next update
+    std::vector<TextureLayer> demotedLayers; //layers that demoted models were moved out of, removed on the next update
+    bool isBudgetWarned; //checks if the budget was reported as exceeded with nothing left to reclaim
+    int nextRequestId; //id given to the next request
+    EntityStore* entities; //store the entities of the models are created in
+    ModelStreamer* streamer; //reads the models of the loaded cells
+    TextureArrayManager* textureArrays; //layers that hold the color maps of the models
+    UploadRing* uploadRing; //staging memory of the layers that were read
+    ImpostorBaker* impostorBaker; //renders the impostors of the large models as they arrive, NULL if none are made
+
+    //constructor for the world partition class
+    WorldPartition(float loadRadius, float unloadRadius, EntityStore* entities, ModelStreamer* streamer, TextureArrayManager* textureArrays, UploadRing* uploadRing, ImpostorBaker* impostorBaker = NULL) {
+        this->loadRadius = loadRadius;
+        this->unloadRadius = unloadRadius;
+        this->entities = entities;
+        this->streamer = streamer;
+        this->textureArrays = textureArrays;
+        this->uploadRing = uploadRing;
+        this->impostorBaker = impostorBaker;
+        cellSize = 1.0f;
+        nextRequestId = 0;
+        isBudgetWarned = false;
+    }
+
+    //destructor for the world partition class, the streamer must have been stopped
+    ~WorldPartition() {
+        for (int i = 0; i < demotedLayers.size(); i++) {
+            textureArrays->remove(demotedLayers[i]);
+        }
+
+        for (int i = 0; i < loadedCells.size(); i++) {
+            WorldCell& cell = cells[loadedCells[i]];
+            for (int j = 0; j < cell.assets.size(); j++) {
+                delete cell.assets[j];
+            }
+        }
+
+        for (int i = 0; i < retiredModels.size(); i++) {
+            delete retiredModels[i];
+        }
+    }
+
+    //reads the manifest of the world, returns false if it could not be opened
+    //
+    //the manifest is a text file with the lines:
+    //  cellSize <size>
+    //  cell <x> <z>
+    //  model <mesh> <texture> <position xyz> <scale xyz> <rotation xyz> <bounds center xyz> <bounds radius> [swim]
+    //where a model belongs to the cell above it and swim makes it play the swimming clip. empty lines and lines
+    //starting with # are skipped.
+    bool load(std::string path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            LOG_ERROR("WORLD", "[WORLD] Unable to open {}", path);
+            return false;
+        }
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+
+            //skip the comments and the empty lines
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::istringstream stream(line);
+            std::string keyword;
+            stream >> keyword;
+
+            if (keyword == "cellSize") {
+                if (stream >> cellSize && cellSize > 0.0f) {
+                    continue;
+                }
+                cellSize = 1.0f;
+            }
+            else if (keyword == "cell") {
+                WorldCell cell;
+                if (stream >> cell.x >> cell.z) {
+                    cell.isLoaded = false;
+                    cellIndices[std::make_pair(cell.x, cell.z)] = cells.size();
+                    cells.push_back(cell);
+                    continue;
+                }
+            }
+            else if (keyword == "model" && !cells.empty()) {
+                ModelRequest request;
+                request.id = -1;
+                glm::vec4& bounds = request.placeholderBounds;
+                if (stream >> request.meshPath >> request.texturePath >>
+                    request.position.x >> request.position.y >> request.position.z >>
+                    request.scale.x >> request.scale.y >> request.scale.z >>
+                    request.theta.x >> request.theta.y >> request.theta.z >>
+                    bounds.x >> bounds.y >> bounds.z >> bounds.w) {
+                    std::string animation;
+                    if (!(stream >> animation) || animation == "swim") {
+                        request.animation = animation;
+                        cells.back().models.push_back(request);
+                        continue;
+                    }
+                }
+            }
+
+            LOG_WARNING("WORLD", "[WORLD] {}:{} could not be read", path, lineNumber);
+        }
+
+        int modelCount = 0;
+        for (int i = 0; i < cells.size(); i++) {
+            modelCount += cells[i].models.size();
+        }
+        LOG_INFO("WORLD", "[WORLD] {} cells with {} models in {}", (int)cells.size(), modelCount, path);
+        return true;
+    }
+
+    //returns the distance on the xz plane from a point to the closest point of a cell
+    float distanceTo(WorldCell& cell, glm::vec3 point) {
+        glm::vec2 minimum(cell.x * cellSize, cell.z * cellSize);
+        glm::vec2 closest = glm::clamp(glm::vec2(point.x, point.z), minimum, minimum + glm::vec2(cellSize));
+        return glm::distance(closest, glm::vec2(point.x, point.z));
+    }
+
+    //loads the cells near a point and unloads the cells far from it, must be called while no snapshot is being built
+    void update(glm::vec3 center) {
+        PROFILE_ZONE("WorldPartition::update");
+
+        //the snapshots that could still draw these models were drawn since the last update
+        for (int i = 0; i < evictedMeshes.size(); i++) {
+            evictedMeshes[i]->destroyBuffers();
+        }
+        evictedMeshes.clear();
+
+        for (int i = 0; i < demotedLayers.size(); i++) {
+            textureArrays->remove(demotedLayers[i]);
+        }
+        demotedLayers.clear();
+
+        for (int i = 0; i < retiredModels.size(); i++) {
+            textureArrays->remove(retiredModels[i]->albedoLayer);
+            delete retiredModels[i];
+        }
+        retiredModels.clear();
+
+        for (int i = loadedCells.size() - 1; i >= 0; i--) {
+            if (distanceTo(cells[loadedCells[i]], center) > unloadRadius) {
+                unloadCell(loadedCells[i]);
+                loadedCells.erase(loadedCells.begin() + i);
+            }
+        }
+
+        //only the grid squares around the point are looked up, so the cost does not grow with the world
+        std::vector<std::pair<float, int>> nearbyCells;
+        int minX = (int)std::floor((center.x - loadRadius) / cellSize);
+        int maxX = (int)std::floor((center.x + loadRadius) / cellSize);
+        int minZ = (int)std::floor((center.z - loadRadius) / cellSize);
+        int maxZ = (int)std::floor((center.z + loadRadius) / cellSize);
+        for (int z = minZ; z <= maxZ; z++) {
+            for (int x = minX; x <= maxX; x++) {
+                std::map<std::pair<int, int>, int>::iterator it = cellIndices.find(std::make_pair(x, z));
+                if (it == cellIndices.end() || cells[it->second].isLoaded) {
+                    continue;
+                }
+
+                float distance = distanceTo(cells[it->second], center);
+                if (distance <= loadRadius) {
+                    nearbyCells.push_back(std::make_pair(distance, it->second));
+                }
+            }
+        }
+
+        //the loader reads the requests in order, so the closest cells are requested first
+        std::sort(nearbyCells.begin(), nearbyCells.end());
+        for (int i = 0; i < nearbyCells.size(); i++) {
+            loadCell(nearbyCells[i].second);
+            loadedCells.push_back(nearbyCells[i].second);
+        }
+    }
+
+    //places a placeholder for every model of a cell and requests the models from the streamer
+    void loadCell(int index) {
+        WorldCell& cell = cells[index];
+        LOG_INFO("WORLD", "[WORLD] Loading cell ({}, {}) with {} models", cell.x, cell.z, (int)cell.models.size());
+
+        cell.isLoaded = true;
+        cell.entities.clear();
+        cell.assets.assign(cell.models.size(), NULL);
+
+        for (int i = 0; i < cell.models.size(); i++) {
+            ModelRequest& request = cell.models[i];
+            cell.entities.push_back(entities->createPlaceholder(request.position, request.theta, request.scale, request.placeholderBounds));
+            requestModel(index, i);
+        }
+    }
+
+    //asks the streamer to read a model of a cell, the model replaces the one in its slot when it arrives
+    void requestModel(int index, int slot) {
+        ModelRequest request = cells[index].models[slot];
+        request.id = nextRequestId++;
+
+        loading[request.id] = std::make_pair(index, slot);
+        streamer->request(request);
+    }
+
+    //checks if a model of a cell was requested and has not arrived yet
+    bool isLoading(int index, int slot) {
+        for (std::map<int, std::pair<int, int>>::iterator it = loading.begin(); it != loading.end(); ++it) {
+            if (it->second.first == index && it->second.second == slot) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //removes the entities of a cell, cancels its requests, and retires the models that arrived
+    void unloadCell(int index) {
+        WorldCell& cell = cells[index];
+        LOG_INFO("WORLD", "[WORLD] Unloading cell ({}, {})", cell.x, cell.z);
+
+        for (std::map<int, std::pair<int, int>>::iterator it = loading.begin(); it != loading.end();) {
+            if (it->second.first == index) {
+                //a model that is already being read is thrown away when it arrives
+                streamer->cancel(it->first);
+                it = loading.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        for (int i = 0; i < cell.models.size(); i++) {
+            entities->destroy(cell.entities[i]);
+            if (cell.assets[i]) {
+                retiredModels.push_back(cell.assets[i]);
+            }
+        }
+
+        cell.isLoaded = false;
+        cell.entities.clear();
+        cell.assets.clear();
+    }
+
+    //uploads the models that were read until the byte budget is used up and swaps them in for their placeholders,
+    //returns true if one arrived
+    //
+    //the first model is always taken so that a model larger than the budget still arrives. a model that was read again
+    //to restore its color map replaces the model in its slot, which is deleted on the next update.
+    bool receive(long long byteBudget, int frame) {
+        bool isFirst = true;
+        int id;
+        Model* model;
+        while (streamer->take(id, model, isFirst ? LLONG_MAX : byteBudget)) {
+            PROFILE_ZONE("WorldPartition::receive");
+
+            //the cell of the model was unloaded while it was read
+            std::map<int, std::pair<int, int>>::iterator it = loading.find(id);
+            if (it == loading.end()) {
+                model->releaseStaged(*uploadRing);
+                delete model;
+                continue;
+            }
+
+            byteBudget -= model->getUploadBytes();
+            isFirst = false;
+
+            model->upload(*textureArrays, *uploadRing);
+
+            //the views are taken as the model arrives, while its color map is at full size
+            if (impostorBaker && impostorBaker->isWorthBaking(*model)) {
+                model->impostor = impostorBaker->bake(*model);
+            }
+
+            WorldCell& cell = cells[it->second.first];
+            int slot = it->second.second;
+            loading.erase(it);
+
+            if (cell.assets[slot]) {
+                retiredModels.push_back(cell.assets[slot]);
+            }
+
+            //the model counts as drawn so that it is not reclaimed before it had a chance to be seen
+            model->lastDrawnFrame = frame;
+            cell.assets[slot] = model;
+            entities->setAsset(cell.entities[slot], model);
+
+            LOG_INFO("SETUP", "[ {} LOADED ]... ", cell.models[slot].meshPath);
+        }
+
+        return !isFirst;
+    }
+
+    //restores the models that are drawn again and reclaims the memory of the least recently drawn model while the
+    //allocations are over the budget, must be called after update while no snapshot is being built
+    //
+    //at most byteBudget of meshes are restored and one model is reclaimed per call so that the cost is spread over
+    //the frames.
+    void updateResidency(int frame, long long byteBudget) {
+        PROFILE_ZONE("WorldPartition::updateResidency");
+
+        ResidencyManager& residency = ResidencyManager::instance();
+        long long arrayBytes = ResidencyManager::textureBytes(textureArrays->layerSize, textureArrays->layerSize, 4, true) * textureArrays->layersPerArray;
+        bool isPromoting = false;
+        Model* leastRecent = NULL;
+        Entity leastRecentEntity = 0;
+
+        for (int i = 0; i < loadedCells.size(); i++) {
+            WorldCell& cell = cells[loadedCells[i]];
+            for (int j = 0; j < cell.assets.size(); j++) {
+                Model* model = cell.assets[j];
+                if (!model) {
+                    continue;
+                }
+
+                bool isDrawn = model->lastDrawnFrame == frame;
+
+                //the placeholder of an evicted mesh was drawn
+                if (isDrawn && model->VAO == 0 && model->getUploadBytes() <= byteBudget && residency.hasRoomFor(model->getUploadBytes())) {
+                    byteBudget -= model->getUploadBytes();
+                    model->createBuffers();
+                    entities->setAsset(cell.entities[j], model);
+                    LOG_INFO("RESIDENCY", "[RESIDENCY] Restored the mesh of {}", model->name);
+                }
+
+                //the layer may need a new array, so the budget must have room for a whole one
+                int layerSize = textureArrays->sizeOf(model->albedoLayer);
+                if (isDrawn && !isPromoting && layerSize > 0 && layerSize < textureArrays->layerSize && residency.hasRoomFor(arrayBytes) && !isLoading(loadedCells[i], j)) {
+                    isPromoting = true;
+                    requestModel(loadedCells[i], j);
+                    LOG_INFO("RESIDENCY", "[RESIDENCY] Reading {} again to restore its color map", model->name);
+                }
+
+                bool isReclaimable = model->VAO != 0 || textureArrays->canDemote(model->albedoLayer);
+                if (frame - model->lastDrawnFrame >= IDLE_FRAMES && isReclaimable && (!leastRecent || model->lastDrawnFrame < leastRecent->lastDrawnFrame)) {
+                    leastRecent = model;
+                    leastRecentEntity = cell.entities[j];
+                }
+            }
+        }
+
+        if (!residency.isOverBudget()) {
+            isBudgetWarned = false;
+            return;
+        }
+
+        if (!leastRecent) {
+            if (!isBudgetWarned) {
+                LOG_WARNING("RESIDENCY", "[RESIDENCY] {.1} MB resident is over the budget and every model is in use", ResidencyManager::toMegabytes(residency.totalBytes));
+                isBudgetWarned = true;
+            }
+            return;
+        }
+
+        //the old layer is read by the snapshot that is drawn next, so it is removed on the next update
+        if (textureArrays->canDemote(leastRecent->albedoLayer)) {
+            demotedLayers.push_back(leastRecent->albedoLayer);
+            leastRecent->albedoLayer = textureArrays->demote(leastRecent->albedoLayer);
+            entities->setAsset(leastRecentEntity, leastRecent);
+
+            int size = textureArrays->sizeOf(leastRecent->albedoLayer);
+            residency.resize(leastRecent->albedoAllocation, ResidencyManager::textureBytes(size, size, 4, true));
+            LOG_INFO("RESIDENCY", "[RESIDENCY] Demoted the color map of {} to {}x{}", leastRecent->name, size, size);
+            return;
+        }
+
+        entities->clearMesh(leastRecentEntity);
+        evictedMeshes.push_back(leastRecent);
+        LOG_INFO("RESIDENCY", "[RESIDENCY] Evicted the mesh of {}", leastRecent->name);
+    }
+
+    //checks if every model of the loaded cells has arrived
+    bool isSettled() {
+        return loading.empty();
+    }
+};
@@ -0,0 +1,88 @@
+#version 330 core //version
+
+//feature defines set by the variant that is compiled:
+//USE_TEXTURE - uses the color of the views, otherwise the impostors are a flat shade of green like the models
+//POINT_LIGHT_COUNT - number of point lights added to the directional and spot light
+#include "lighting.glsl"
+
+uniform sampler2D albedoAtlas; //color (rgb) and coverage (a) of every view
+uniform sampler2D normalDepthAtlas; //object space normal (rgb) and depth (a) of every view
+uniform vec3 localCamera; //camera position in the unit sphere around the mesh
+uniform vec3 frameDirections[3]; //directions the three views closest to the camera were taken from
+uniform vec2 frameCells[3]; //cells of the three views in the atlases
+uniform vec3 frameWeights; //blend weight of each view
+uniform float gridSize; //number of views along each side of the atlases
+uniform float frameSize; //width and height of a view in texels
+uniform mat3 normalMatrix; //inverse transpose of the transformation matrix
+
+uniform DirectionalLight directionalLight; //directional light
+uniform SpotLight spotLight; //point light
+#if POINT_LIGHT_COUNT > 0
+uniform PointLight pointLights[POINT_LIGHT_COUNT]; //point lights
+#endif
+
+uniform vec3 cameraPos; //camera position
+
+in vec3 localPosition; //point of the quad in the unit sphere around the mesh
+in vec3 fragPos; //fragment position
+
+out vec4 FragColor; //output fragment color
+
+//returns where a point of a view is in the atlases, half a texel away from the border so the next view is not sampled
+vec2 toAtlas(vec2 uv, int frame) {
+    uv = clamp(uv, 0.5f / frameSize, 1.0f - 0.5f / frameSize);
+    return (frameCells[frame] + uv) / gridSize;
+}
+
+void main () {
+    vec3 ray = normalize(localPosition - localCamera);
+    vec4 albedo = vec4(0.0f);
+    vec4 normalDepth = vec4(0.0f);
+
+    for (int i = 0; i < 3; i++) {
+        //the basis of the view, which matches the camera the baker used
+        vec3 forward = -frameDirections[i];
+        vec3 up = abs(forward.y) > 0.999f ? vec3(0.0f, 0.0f, 1.0f) : vec3(0.0f, 1.0f, 0.0f);
+        vec3 right = normalize(cross(forward, up));
+        up = cross(right, forward);
+        vec2 uv = vec2(dot(localPosition, right), dot(localPosition, up)) * 0.5f + 0.5f;
+
+        //follow the ray from the quad to the depth the view stored under it
+        float depth = texture(normalDepthAtlas, toAtlas(uv, i)).a * 2.0f - 1.0f;
+        float travel = (depth - dot(localPosition, forward)) / max(dot(ray, forward), 0.1f);
+        uv += vec2(dot(ray, right), dot(ray, up)) * travel * 0.5f;
+
+        albedo += texture(albedoAtlas, toAtlas(uv, i)) * frameWeights[i];
+        normalDepth += texture(normalDepthAtlas, toAtlas(uv, i)) * frameWeights[i];
+    }
+
+    if (albedo.a < 0.5f) {
+        discard;
+    }
+
+    vec3 normal = normalize(normalMatrix * (normalDepth.rgb * 2.0f - 1.0f));
+    vec3 viewDir = normalize(cameraPos - fragPos); //view direction
+    vec3 total = vec3(0.0f); //stores the sum of the lights
+
+    //calculate directional light
+    total += calculateDirectionalLight(directionalLight, normal, viewDir);
+
+    //calculate spot light
+    total += calculateSpotLight(spotLight, normal, viewDir, fragPos);
+
+#if POINT_LIGHT_COUNT > 0
+    //calculate point lights
+    for (int i = 0; i < POINT_LIGHT_COUNT; i++) {
+        total += calculatePointLight(pointLights[i], normal, viewDir, fragPos);
+    }
+#endif
+
+#ifdef USE_TEXTURE
+    //the uncovered texels are black, so the blended color is divided by the coverage
+    vec4 pixelColor = vec4(albedo.rgb / albedo.a, 1.0f);
+#else
+    vec4 pixelColor = vec4(0.0f, 1.0f, 0.25f, 1.0f);
+#endif
+
+    FragColor = vec4(total, 1.0f) * pixelColor;
+}
@@ -0,0 +1,29 @@
+#version 330 core
+
+//the quad has no vertex buffer, its corners are made from gl_VertexID and drawn as a triangle strip
+
+out vec3 localPosition; //point of the quad in the unit sphere around the mesh
+out vec3 fragPos; //output vertices
+
+uniform mat4 projection; //projection matrix
+uniform mat4 view; //view matrix
+uniform mat4 transform; //transformation matrix
+uniform vec3 boundsCenter; //center of the sphere the views were taken of, in object space
+uniform float boundsRadius; //radius of the sphere the views were taken of
+uniform vec3 localCamera; //camera position in the unit sphere around the mesh
+
+void main () {
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+
+	//the quad passes through the center and faces the camera
+	vec3 forward = normalize(localCamera);
+	vec3 up = abs(forward.y) > 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+	vec3 right = normalize(cross(up, forward));
+	up = cross(forward, right);
+	localPosition = right * corner.x + up * corner.y;
+
+	vec4 position = transform * vec4(boundsCenter + localPosition * boundsRadius, 1.0);
+	gl_Position = projection * view * position; //compute the final position of the vertex
+
+	fragPos = vec3(position); //calculate the fragment position after transformation
+}
@@ -0,0 +1,17 @@
+#version 330 core //version
+
+uniform sampler2DArray textureArray; //texture array that holds the color maps of the models
+uniform int textureLayer; //layer of the texture array that holds the color map of this model
+
+in vec2 texCoord; //texture coordinates
+in vec3 normCoord; //normal coordinates
+
+layout(location = 0) out vec4 albedo; //color (rgb) and coverage (a) of the view
+layout(location = 1) out vec4 normalDepth; //object space normal (rgb) and depth from the front of the sphere (a)
+
+void main () {
+    albedo = vec4(texture(textureArray, vec3(texCoord, textureLayer)).rgb, 1.0f);
+
+    //the orthographic depth runs from the front (0) to the back (1) of the sphere
+    normalDepth = vec4(normalize(normCoord) * 0.5f + 0.5f, gl_FragCoord.z);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos; //vertices
+layout(location = 1) in vec3 vertexNormal; //normals
+layout(location = 2) in vec2 aTex; //textures
+
+out vec3 normCoord; //output normals
+out vec2 texCoord; //output textures
+
+uniform mat4 projection; //orthographic projection around the unit sphere
+uniform mat4 view; //view matrix of the view that is baked
+uniform mat4 transform; //moves the mesh into the unit sphere, the scale is uniform so the normals are kept as they are
+
+void main () {
+	gl_Position = projection * view * transform * vec4(aPos, 1.0); //compute the final position of the vertex
+
+	texCoord = aTex; //output the texture coordinate
+
+	normCoord = vertexNormal; //the normals are stored in object space
+}
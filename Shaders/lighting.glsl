@@ -0,0 +1,146 @@
+//lighting module shared by the model and player shaders, included with #include "lighting.glsl"
+//
+//the light functions take the shading normal instead of computing it so that the caller decides if it comes from
+//the vertex normal or from a normal map, and the normal is only computed once per fragment
+
+struct DirectionalLight {
+    vec3 direction; //direction of the directional light
+    vec3 color; //color of the light
+    float intensity; //intesity of the light
+    float ambientStr; //ambient strength
+    float specStr; //specular strength
+    float specPhong; //specular phong
+};
+
+struct PointLight {
+    vec3 position; //position of the point light
+    vec3 color; //color of the light
+    float intensity; //intesity of the light
+    float ambientStr; //ambient strength
+    float specStr; //specular strength
+    float specPhong; //specular phong
+    float constant; //constant factor for attentuation
+    float linear; //linear factor for attentuation
+    float quadratic; //quadratic factor for attentuation
+};
+
+struct SpotLight {
+    vec3 position; //position of the spot light
+    vec3 direction; //direction of the spot light
+    vec3 color; //color of the light
+    float intensity; //intesity of the light
+    float ambientStr; //ambient strength
+    float specStr; //specular strength
+    float specPhong; //specular phong
+    float constant; //constant factor for attentuation
+    float linear; //linear factor for attentuation
+    float quadratic; //quadratic factor for attentuation
+    float cutoff; //cutoff for the spotlight
+    float outerCutoff; //outer cutoff for the spotlight
+};
+
+//number of point lights in the point light array, the point light code is left out when there are none
+#ifndef POINT_LIGHT_COUNT
+#define POINT_LIGHT_COUNT 0
+#endif
+
+vec3 calculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir) {
+    vec3 lightDir = normalize(-light.direction);
+
+    //ambient
+    vec3 ambient = light.ambientStr * light.color;
+
+    //diffuse
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = diff * light.color;
+    
+    // specular
+    vec3 reflectDir = reflect(-lightDir, normal);
+
+    float spec = pow(max(dot(viewDir, reflectDir), 0.1f), light.specPhong);
+    vec3 specular = light.specStr * spec * light.color;  
+
+    //scale the ambient, diffuse, and specular based on the light intensity
+    ambient *= light.intensity;
+    diffuse *= light.intensity;
+    specular *= light.intensity;
+
+    return ambient + diffuse + specular;
+}
+
+//formula from https://ogldev.org/www/tutorial20/tutorial20.html for more flexible point light
+float calculateAttenuation(vec3 lightPos, float constant, float linear, float quadratic, vec3 fragPos) {
+    float distance = length(lightPos - fragPos); //calculate the euclidean distance between the light and fragment
+    return 1.0f / (constant + linear * distance + quadratic * (distance * distance));
+}
+
+#if POINT_LIGHT_COUNT > 0
+vec3 calculatePointLight(PointLight light, vec3 normal, vec3 viewDir, vec3 fragPos) {
+    vec3 lightDir = normalize(light.position - fragPos); //light direction
+    
+    //ambient
+    vec3 ambient = light.ambientStr * light.color;
+
+    //diffuse
+    float diff = max(dot(normal, lightDir), 0.0f);
+    vec3 diffuse = diff * light.color;
+
+    // specular
+    vec3 reflectDir = reflect(-lightDir, normal); //reflection direction
+
+    //calculate specular light
+    float spec = pow(max(dot(reflectDir, viewDir), 0.1f), light.specPhong);
+    vec3 specular = light.specStr * spec * light.color;  
+
+    //scale the diffuse, ambient, and speculation based on the distance of the object from the light source
+    float attenuation = calculateAttenuation(light.position, light.constant, light.linear, light.quadratic, fragPos);
+    ambient *= attenuation;
+    diffuse *= attenuation;
+    specular *= attenuation;
+
+    //scale the ambient, diffuse, and specular based on the light intensity
+    ambient *= light.intensity;
+    diffuse *= light.intensity;
+    specular *= light.intensity;
+
+    return ambient + diffuse + specular;
+}
+#endif
+
+vec3 calculateSpotLight(SpotLight light, vec3 normal, vec3 viewDir, vec3 fragPos) {
+    vec3 lightDir = normalize(light.position - fragPos); //light direction
+    
+    //ambient
+    vec3 ambient = light.ambientStr * light.color;
+
+    //diffuse
+    float diff = max(dot(normal, lightDir), 0.0f);
+    vec3 diffuse = diff * light.color;
+
+    // specular
+    vec3 reflectDir = reflect(-lightDir, normal); //reflection direction
+
+    //calculate specular light
+    float spec = pow(max(dot(reflectDir, viewDir), 0.1f), light.specPhong);
+    vec3 specular = light.specStr * spec * light.color;  
+
+    //scale the diffuse, ambient, and speculation based on the distance of the object from the light source
+    float attenuation = calculateAttenuation(light.position, light.constant, light.linear, light.quadratic, fragPos);
+    ambient *= attenuation;
+    diffuse *= attenuation;
+    specular *= attenuation;
+
+    //scale the ambient, diffuse, and specular based on the light intensity
+    ambient *= light.intensity;
+    diffuse *= light.intensity;
+    specular *= light.intensity;
+
+    //spotlight with soft edges
+    float theta = dot(lightDir, normalize(-light.direction)); 
+    float epsilon = (light.cutoff - light.outerCutoff);
+    float scale = clamp((theta - light.outerCutoff) / epsilon, 0.0, 1.0); 
+    diffuse  *= scale;
+    specular *= scale;
+
+    return ambient + diffuse + specular; 
+}
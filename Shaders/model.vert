@@ -1,5 +1,8 @@
 #version 330 core
 
+//feature defines set by the variant that is compiled:
+//USE_VERTEX_ANIMATION - poses the vertices with the frames of a clip baked into a texture
+
 layout(location = 0) in vec3 aPos; //vertices
 layout(location = 1) in vec3 vertexNormal; //normals
 layout(location = 2) in vec2 aTex; //textures
@@ -11,14 +14,40 @@ out vec2 texCoord; //output textures
 uniform mat4 projection; //projection matrix
 uniform mat4 view; //view matrix
 uniform mat4 transform; //transformation matrix
+uniform mat3 normalMatrix; //inverse transpose of the transformation matrix
+
+#ifdef USE_VERTEX_ANIMATION
+uniform sampler2D animationTexture; //offset (texel 0) and normal (texel 1) of every vertex in every frame of the clip
+uniform int animationVertexCount; //number of vertices in a frame
+uniform int animationFrameCount; //number of frames in the clip
+uniform float animationFrame; //frame the mesh is posed at, the fraction blends toward the next frame
+
+//reads a texel of this vertex in a frame, the texels are stored in drawing order and wrap at the width of the texture
+vec3 fetchAnimation(int frame, int channel) {
+	int texel = (frame * animationVertexCount + gl_VertexID) * 2 + channel;
+	int width = textureSize(animationTexture, 0).x;
+	return texelFetch(animationTexture, ivec2(texel % width, texel / width), 0).xyz;
+}
+#endif
 
 void main () {
+	vec3 position = aPos;
+	vec3 normal = vertexNormal;
+
+#ifdef USE_VERTEX_ANIMATION
+	//blend the pose of the two frames around the current time, the clip loops
+	int frame = int(animationFrame);
+	int nextFrame = (frame + 1) % animationFrameCount;
+	float blend = fract(animationFrame);
+	position += mix(fetchAnimation(frame, 0), fetchAnimation(nextFrame, 0), blend);
+	normal = mix(fetchAnimation(frame, 1), fetchAnimation(nextFrame, 1), blend);
+#endif
 
-	gl_Position = projection * view * transform * vec4(aPos, 1.0); //compute the final position of the vertex
+	gl_Position = projection * view * transform * vec4(position, 1.0); //compute the final position of the vertex
 
 	texCoord = aTex; //output the texture coordinate
 
-	normCoord = mat3(transpose(inverse(transform))) * vertexNormal; //apply normal matrix to the normal data
+	normCoord = normalMatrix * normal; //apply normal matrix to the normal data
 
-	fragPos = vec3(transform * vec4(aPos, 1.0)); //calculate the fragment position after transformation
+	fragPos = vec3(transform * vec4(position, 1.0)); //calculate the fragment position after transformation
 }
@@ -1,46 +1,20 @@
 #version 330 core //version
 
-struct DirectionalLight {
-    vec3 direction; //direction of the directional light
-    vec3 color; //color of the light
-    float intensity; //intesity of the light
-    float ambientStr; //ambient strength
-    float specStr; //specular strength
-    float specPhong; //specular phong
-};
-
-struct PointLight {
-    vec3 position; //position of the point light
-    vec3 color; //color of the light
-    float intensity; //intesity of the light
-    float ambientStr; //ambient strength
-    float specStr; //specular strength
-    float specPhong; //specular phong
-    float constant; //constant factor for attentuation
-    float linear; //linear factor for attentuation
-    float quadratic; //quadratic factor for attentuation
-};
-
-struct SpotLight {
-    vec3 position; //position of the spot light
-    vec3 direction; //direction of the spot light
-    vec3 color; //color of the light
-    float intensity; //intesity of the light
-    float ambientStr; //ambient strength
-    float specStr; //specular strength
-    float specPhong; //specular phong
-    float constant; //constant factor for attentuation
-    float linear; //linear factor for attentuation
-    float quadratic; //quadratic factor for attentuation
-    float cutoff; //cutoff for the spotlight
-    float outerCutoff; //outer cutoff for the spotlight
-};
+//feature defines set by the variant that is compiled:
+//USE_NORMAL_MAP - takes the normal from the normal map instead of the vertex normal
+//POINT_LIGHT_COUNT - number of point lights added to the directional and spot light
+#include "lighting.glsl"
 
 uniform sampler2D tex0; //index of the texture
-uniform sampler2D norm_tex;
+#ifdef USE_NORMAL_MAP
+uniform sampler2D norm_tex; //index of the normal map
+#endif
 
 uniform DirectionalLight directionalLight; //directional light
 uniform SpotLight spotLight; //point light
+#if POINT_LIGHT_COUNT > 0
+uniform PointLight pointLights[POINT_LIGHT_COUNT]; //point lights
+#endif
 
 uniform vec3 cameraPos; //camera position
 
@@ -48,132 +22,35 @@ in vec2 texCoord; //texture coordinates
 in vec3 normCoord; //normal coordinates
 in vec3 fragPos; //fragment position
 
+#ifdef USE_NORMAL_MAP
 in mat3 TBN;
+#endif
 
 out vec4 FragColor; //output fragment color
 
-vec3 calculateDirectionalLight (DirectionalLight light) {
-    vec3 normal = texture(norm_tex,  texCoord).rgb;
-    normal = normalize(normal * 2.0 - 1.0); //convert rgb(0 to 1) to xyz (-1 to 1)
-    normal = normalize(TBN * normal);
-
-    vec3 lightDir = normalize(-light.direction);
-
-    //ambient
-    vec3 ambient = light.ambientStr * light.color;
-
-    //diffuse
-    float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = diff * light.color;
-    
-    // specular
-    vec3 viewDir = normalize(cameraPos - fragPos);
-    vec3 reflectDir = reflect(-lightDir, normal);
-
-    float spec = pow(max(dot(viewDir, reflectDir), 0.1f), light.specPhong);
-    vec3 specular = light.specStr * spec * light.color;  
-
-    //scale the ambient, diffuse, and specular based on the light intensity
-    ambient *= light.intensity;
-    diffuse *= light.intensity;
-    specular *= light.intensity;
-
-    return ambient + diffuse + specular;
-}
-
-vec3 calculatePointLight(PointLight light) {
-    vec3 normal = texture(norm_tex,  texCoord).rgb;
-    normal = normalize(normal * 2.0 - 1.0); //convert rgb(0 to 1) to xyz (-1 to 1)
-    normal = normalize(TBN * normal);
-
-    vec3 lightDir = normalize(light.position - fragPos); //light direction
-    
-    //ambient
-    vec3 ambient = light.ambientStr * light.color;
-
-    //diffuse
-    float diff = max(dot(normal, lightDir), 0.0f);
-    vec3 diffuse = diff * light.color;
-
-    // specular
-    vec3 viewDir = normalize(cameraPos - fragPos); //view direction
-    vec3 reflectDir = reflect(-lightDir, normal); //reflection direction
-
-    //calculate specular light
-    float spec = pow(max(dot(reflectDir, viewDir), 0.1f), light.specPhong);
-    vec3 specular = light.specStr * spec * light.color;  
-
-    //calculate attenuation
-    float distance = length(light.position - fragPos); //calculate the euclidean distance between the light and fragment
-    float attenuation = 1.0f / (light.constant + light.linear * distance + light.quadratic * (distance * distance)); //formula from  https://ogldev.org/www/tutorial20/tutorial20.html) for more flexible point light
-
-    //scale the diffuse, ambient, and speculation based on the distance of the object from the light source
-    ambient *= attenuation;
-    diffuse *= attenuation;
-    specular *= attenuation;
-
-    //scale the ambient, diffuse, and specular based on the light intensity
-    ambient *= light.intensity;
-    diffuse *= light.intensity;
-    specular *= light.intensity;
-
-    return ambient + diffuse + specular;
-}
-
-vec3 calculateSpotLight(SpotLight light) {
+void main () {
+#ifdef USE_NORMAL_MAP
     vec3 normal = texture(norm_tex,  texCoord).rgb;
     normal = normalize(normal * 2.0 - 1.0); //convert rgb(0 to 1) to xyz (-1 to 1)
     normal = normalize(TBN * normal);
-
-    vec3 lightDir = normalize(light.position - fragPos); //light direction
-    
-    //ambient
-    vec3 ambient = light.ambientStr * light.color;
-
-    //diffuse
-    float diff = max(dot(normal, lightDir), 0.0f);
-    vec3 diffuse = diff * light.color;
-
-    // specular
+#else
+    vec3 normal = normalize(normCoord);
+#endif
     vec3 viewDir = normalize(cameraPos - fragPos); //view direction
-    vec3 reflectDir = reflect(-lightDir, normal); //reflection direction
-
-    //calculate specular light
-    float spec = pow(max(dot(reflectDir, viewDir), 0.1f), light.specPhong);
-    vec3 specular = light.specStr * spec * light.color;  
-
-    //calculate attenuation
-    float distance = length(light.position - fragPos); //calculate the euclidean distance between the light and fragment
-    float attenuation = 1.0f / (light.constant + light.linear * distance + light.quadratic * (distance * distance)); //formula from  https://ogldev.org/www/tutorial20/tutorial20.html) for more flexible point light
-
-    //scale the diffuse, ambient, and speculation based on the distance of the object from the light source
-    ambient *= attenuation;
-    diffuse *= attenuation;
-    specular *= attenuation;
-
-    //scale the ambient, diffuse, and specular based on the light intensity
-    ambient *= light.intensity;
-    diffuse *= light.intensity;
-    specular *= light.intensity;
-
-    //spotlight with soft edges
-    float theta = dot(lightDir, normalize(-light.direction)); 
-    float epsilon = (light.cutoff - light.outerCutoff);
-    float scale = clamp((theta - light.outerCutoff) / epsilon, 0.0, 1.0); 
-    diffuse  *= scale;
-    specular *= scale;
-
-    return ambient + diffuse + specular; 
-}
-
-void main () {
-    vec3 total; //stores the sum of the lights
+    vec3 total = vec3(0.0f); //stores the sum of the lights
     
     //calculate directional light
-    total += calculateDirectionalLight(directionalLight);
+    total += calculateDirectionalLight(directionalLight, normal, viewDir);
 
     //calculate spot light
-    total += calculateSpotLight(spotLight);
+    total += calculateSpotLight(spotLight, normal, viewDir, fragPos);
+
+#if POINT_LIGHT_COUNT > 0
+    //calculate point lights
+    for (int i = 0; i < POINT_LIGHT_COUNT; i++) {
+        total += calculatePointLight(pointLights[i], normal, viewDir, fragPos);
+    }
+#endif
 
     FragColor = vec4(total, 1.0f) * texture(tex0, texCoord);
-}
\ No newline at end of file
+}
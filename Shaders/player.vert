@@ -3,18 +3,23 @@
 layout(location = 0) in vec3 aPos; //vertices
 layout(location = 1) in vec3 vertexNormal; //normals
 layout(location = 2) in vec2 aTex; //textures
+#ifdef USE_NORMAL_MAP
 layout(location = 3) in vec3 m_tan;
 layout(location = 4) in vec3 m_btan;
+#endif
 
 out vec3 fragPos; //output vertices
 out vec3 normCoord; //output normals
 out vec2 texCoord; //output textures
 
+#ifdef USE_NORMAL_MAP
 out mat3 TBN;
+#endif
 
 uniform mat4 projection; //projection matrix
 uniform mat4 view; //view matrix
 uniform mat4 transform; //transformation matrix
+uniform mat3 normalMatrix; //inverse transpose of the transformation matrix
 
 void main () {
 
@@ -22,15 +27,17 @@ void main () {
 
 	texCoord = aTex; //output the texture coordinate
 
-	mat3 modelMat =mat3(transpose(inverse(transform)));
+	mat3 modelMat = normalMatrix;
 
 	normCoord = modelMat* vertexNormal; //apply normal matrix to the normal data
 
+#ifdef USE_NORMAL_MAP
 	vec3 T = normalize(modelMat * m_tan);
 	vec3 B = normalize(modelMat * m_btan);
 	vec3 N = normalize(normCoord);
 
 	TBN = mat3(T, B, N);
+#endif
 
 	fragPos = vec3(transform * vec4(aPos, 1.0)); //calculate the fragment position after transformation
 }
\ No newline at end of file
@@ -2,6 +2,12 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+//egl is only used by the headless mode on linux builds
+#ifdef USE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
 //define tinyobjloader implementation
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
@@ -14,19 +20,103 @@
 #include <string>
 #include <iostream>
 
+//libraries for the profilers
+#include <map>
+#include <unordered_map>
+#include <deque>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+
+//libraries for the frame pipeline and the job system
+#include <thread>
+#include <condition_variable>
+#include <functional>
+
+//libraries for the logger
+#include <cstdio>
+#include <fstream>
+
+//libraries for the shader cache
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+//libraries for the texture uploads
+#include <climits>
+#include <limits>
+
 //glm headers
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/packing.hpp>
 
 //width and height of the window
 #define WIDTH 720.0f
 #define HEIGHT 720.0f
 
+// Profiler Classes
+#include "Classes/Profiling/GPUProfiler.h"
+#include "Classes/Profiling/CPUProfiler.h"
+#include "Classes/Profiling/RenderStats.h"
+
+// Logging Classes
+#include "Classes/Logging/LogRecord.h"
+#include "Classes/Logging/LogQueue.h"
+#include "Classes/Logging/Logger.h"
+
+#include "Classes/Profiling/InputLatency.h"
+#include "Classes/Profiling/StartupTimer.h"
+#include "Classes/Profiling/GLInterceptor.h"
+#include "Classes/Profiling/GLCapture.h"
+#include "Classes/Profiling/GLHooks.h"
+
+// Math Classes
+#include "Classes/Math/TransformBatch.h"
+
+// Memory Classes
+#include "Classes/Memory/LinearAllocator.h"
+#include "Classes/Memory/PoolAllocator.h"
+
+// Job Classes
+#include "Classes/Jobs/Job.h"
+#include "Classes/Jobs/JobCounter.h"
+#include "Classes/Jobs/WorkStealingQueue.h"
+#include "Classes/Jobs/JobSystem.h"
+
+// Engine Classes
+#include "Classes/Engine/InputState.h"
+#include "Classes/Engine/InputEvent.h"
+#include "Classes/Engine/InputQueue.h"
+#include "Classes/Engine/FixedTimestep.h"
+
+// Scene Classes
+#include "Classes/Scene/SceneAttachment.h"
+#include "Classes/Scene/SceneGraph.h"
+
 // Model Class
+#include "Classes/Models/ObjMesh.h"
 #include "Classes/Models/Model.h"
 #include "Classes/Models/Player.h"
 #include "Classes/Models/Skybox.h"
+#include "Classes/Models/ModelStreamer.h"
+#include "Classes/Models/PlaceholderBox.h"
+#include "Classes/Models/ImpostorBaker.h"
 
 // Camera Classes
 #include "Classes/Cameras/PerspectiveCamera.h"
@@ -36,69 +126,94 @@
 #include "Classes/Light/DirectionalLight.h"
 #include "Classes/Light/SpotLight.h"
 
+// Pipeline Classes
+#include "Classes/Engine/Frustum.h"
+#include "Classes/Engine/RenderSnapshot.h"
+#include "Classes/Engine/FramePipeline.h"
+#include "Classes/Engine/LateLatch.h"
+#include "Classes/Engine/FrameLimiter.h"
+#include "Classes/Engine/RenderGraph.h"
+#include "Classes/Engine/RenderGraphCheck.h"
+
+// Entity Classes
+#include "Classes/Entities/EntityStore.h"
+#include "Classes/Entities/TransformSystem.h"
+#include "Classes/Entities/AnimationSystem.h"
+#include "Classes/Entities/VisibilitySystem.h"
+
+// World Classes
+#include "Classes/World/WorldPartition.h"
+
 // Environment Class
 #include "Classes/Environment.h"
 
+// Benchmark Classes
+#include "Classes/Profiling/FlythroughBenchmark.h"
+#include "Classes/Jobs/JobBenchmark.h"
+#include "Classes/Math/TransformBenchmark.h"
+
+// Platform Classes
+#include "Classes/Options.h"
+#include "Classes/Platform/HeadlessContext.h"
+#include "Classes/Platform/Framebuffer.h"
+#include "Classes/Profiling/GLReplayer.h"
+
 //----------GLOBAL VARIABLES----------
+JobSystem* jobSystem; //pointer to the job system shared by the loading and the frame jobs
 Environment* environment; //pointer to the environment object
+ProgramCache* programCache = NULL; //pointer to the cache of linked shader programs, NULL if programs are not cached
+FlythroughBenchmark* benchmark = NULL; //pointer to the running benchmark, NULL during an interactive session
+InputQueue* inputQueue = NULL; //events from the callbacks that are applied by the next simulation
+StartupTimer startupTimer; //measures the startup from the launch of the program
+double cursorEventTime = 0.0; //time the newest cursor event arrived, read by the late latch
 
 //----------CALLBACK FUNCTIONS----------
+//queues an event for the simulation, the callbacks never change the environment themselves since it can be simulated on another thread
+void pushInput(int type, int code, int action, double x, double y) {
+    if (!inputQueue) {
+        return;
+    }
+
+    InputEvent event;
+    event.type = type;
+    event.code = code;
+    event.action = action;
+    event.x = x;
+    event.y = y;
+    event.time = glfwGetTime();
+    inputQueue->push(event);
+}
+
 //callback function for key presses
 void Key_Callback(GLFWwindow* window, int key, int scanCode, int action, int mods) {
+    PROFILE_ZONE("Key_Callback");
 
-    // player movement
-    if ((key == GLFW_KEY_W || key == GLFW_KEY_S || key == GLFW_KEY_A || key == GLFW_KEY_D || key == GLFW_KEY_Q || key == GLFW_KEY_E) && action == GLFW_REPEAT) {
-        // insert a flag for the camera being used e.g. camera is 1st person or 3rd person
-        if (environment->activeCamera == environment->thirdPerspectiveCamera || environment->activeCamera == environment->firstPerspectiveCamera) {
-            environment->playerModel->processKeyboard(key);
-        }
-        /* Birds-eye view */
-        if (environment->activeCamera == environment->orthoCamera) {
-            environment->orthoCamera->processKeyboard(key);
-        }
+    // the benchmark controls the player and cameras, only allow it to be cancelled
+    if (benchmark && key != GLFW_KEY_ESCAPE) {
+        return;
     }
 
-    // cycle the light intensity
-    if (key == GLFW_KEY_F && action == GLFW_PRESS) {
-        environment->spotLight->processKeyboard(key);
+    // the light and camera keys are applied by the simulation
+    pushInput(InputEvent::KEY, key, action, 0.0, 0.0);
+
+    // save the current gpu timings
+    if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+        environment->gpuProfiler->exportResults("gpu_profile");
     }
 
-    // change the camera view
-    if (key == GLFW_KEY_1 && action == GLFW_PRESS) {
-        if (environment->activeCamera == environment->firstPerspectiveCamera) {
-            environment->activeCamera = environment->thirdPerspectiveCamera;
-            environment->lastPerspective = 3;
-        }
-        else
-        if (environment->activeCamera == environment->thirdPerspectiveCamera) {
-            environment->activeCamera = environment->firstPerspectiveCamera;
-            environment->lastPerspective = 1;
-        }
+    // save the recorded cpu zones
+    if (key == GLFW_KEY_T && action == GLFW_PRESS) {
+        CPUProfiler::instance().exportTrace("cpu_trace.json");
     }
 
-    if (key == GLFW_KEY_2 && action == GLFW_PRESS) {
-        // toggle off - the current camera is in ortho already
-        if (environment->activeCamera == environment->orthoCamera) {
-            switch (environment->lastPerspective) {
-                case 1:
-                    environment->activeCamera = environment->firstPerspectiveCamera;
-                    break;
-                case 3:
-                    environment->activeCamera = environment->thirdPerspectiveCamera;
-                    break;
-            }
-        }
-        // toggle on - save the last used perspective and switch the camera to ortho
-        else {
-            // set the position and target of ortho be on top of the player
-            environment->orthoCamera->position.x = environment->playerModel->position.x;
-            environment->orthoCamera->target.x = environment->playerModel->position.x;
-            environment->orthoCamera->position.z = environment->playerModel->position.z + 0.1f; // 0.1f add to avoid looking straight down exactly
-            environment->orthoCamera->target.z = environment->playerModel->position.z;
-
-            // set the camera to switch to ortho
-            environment->activeCamera = environment->orthoCamera;
-        }
+    // save the gl call counters
+    if (key == GLFW_KEY_G && action == GLFW_PRESS && GLInterceptor::instance().isInstalled) {
+        GLInterceptor::instance().exportResults("gl_calls");
+    }
+
+    // show the gpu memory used by every asset
+    if (key == GLFW_KEY_R && action == GLFW_PRESS) {
+        ResidencyManager::instance().report();
     }
 
     // escaping the game
@@ -109,45 +224,321 @@ void Key_Callback(GLFWwindow* window, int key, int scanCode, int action, int mod
 
 //callback function for cursor movement
 void Cursor_Callback(GLFWwindow* window, double xPos, double yPos) {
-    //move the camera view for the third person perspective camera
-    if (environment->activeCamera == environment->thirdPerspectiveCamera) {
-        environment->thirdPerspectiveCamera->processMouse(xPos, yPos, environment->isMouseClicked);
+    PROFILE_ZONE("Cursor_Callback");
+
+    //ignore the mouse while the benchmark controls the cameras
+    if (benchmark) {
+        return;
+    }
+
+    //the cameras are moved by the simulation
+    cursorEventTime = glfwGetTime();
+    pushInput(InputEvent::CURSOR, 0, 0, xPos, yPos);
+}
+
+void Mouse_Button_Callback(GLFWwindow* /*window*/, int button, int action, int mods) {
+    PROFILE_ZONE("Mouse_Button_Callback");
+
+    //ignore the mouse while the benchmark controls the cameras
+    if (benchmark) {
+        return;
+    }
+
+    //the simulation decides if the click starts a drag, the cursor is captured once it did
+    pushInput(InputEvent::MOUSE_BUTTON, button, action, 0.0, 0.0);
+}
+
+//opens the cache of linked shader programs, needs a current context since the key depends on the driver
+void createProgramCache(Options& options) {
+    //a captured program is compiled from its sources so that the trace replays on any driver
+    if (!options.shaderCacheDirectory.empty() && options.glCapturePath.empty()) {
+        programCache = new ProgramCache(options.shaderCacheDirectory);
+    }
+}
+
+//wraps the gl functions to count the calls of every frame or capture them if it was requested in the command line,
+//must be called right after glad is loaded so that the tracked state starts at the default state of the context
+void startGLInterception(Options& options, int width, int height) {
+    if (!options.isInterceptingGL && options.glCapturePath.empty()) {
+        return;
     }
 
-    //pan the camera view for the orthographic camera
-    if (environment->activeCamera == environment->orthoCamera) {
-        environment->orthoCamera->processMouse(xPos, yPos, environment->isMouseClicked);
+    GLHooks::install();
+    if (options.isInterceptingGL) {
+        LOG_INFO("GL", "[GL] Counting the gl calls of every frame");
+    }
+    if (!options.glCapturePath.empty()) {
+        GLCapture::instance().start(options.glCapturePath, options.glCaptureFrames, width, height);
     }
-    
 }
 
-void Mouse_Button_Callback(GLFWwindow* window, int button, int action, int mods) {
+//closes the capture, reports and writes the gl call counters of the session, and puts the driver functions back
+void finishGLInterception(Options& options) {
+    GLInterceptor& interceptor = GLInterceptor::instance();
+    if (!interceptor.isInstalled) {
+        return;
+    }
 
-    if (environment->activeCamera == environment->thirdPerspectiveCamera || environment->activeCamera == environment->orthoCamera) {
+    GLCapture::instance().stop();
+    if (options.isInterceptingGL) {
+        interceptor.report();
+        interceptor.exportResults("gl_calls");
+    }
+    GLHooks::uninstall();
+}
 
-        //implement dragging using mouse
-        if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-            environment->isMouseClicked = true;
-            //prevent the mouse from going out the window
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+//creates the benchmark if it was requested in the command line
+void startBenchmark(Options& options) {
+    if (!options.isBenchmarking) {
+        return;
+    }
+
+    //the benchmark always advances by 1/60 of a second so that every run renders the same frames
+    benchmark = new FlythroughBenchmark(options.benchmarkPath, options.benchmarkFrames, 1.0f / 60.0f);
+
+    //keep every gpu frame time instead of only the rolling window
+    environment->gpuProfiler->isKeepingHistory = true;
+
+    //every run of the benchmark has to draw the same scene, so the models are not streamed in during the path
+    environment->waitForModels();
+    startupTimer.markFullyLoaded();
+}
+
+//swaps in a model that finished loading, must be called while no snapshot is being built
+void streamModels() {
+    environment->streamModels();
+    if (environment->isFullyLoaded()) {
+        startupTimer.markFullyLoaded();
+    }
+}
+
+//writes the results of the benchmark and removes it
+void finishBenchmark(Options& options) {
+    if (!benchmark) {
+        return;
+    }
+
+    //read the timings of the frames that are still in flight
+    environment->gpuProfiler->flush();
+
+    benchmark->exportJSON(options.benchmarkOutput, environment->gpuProfiler->history["Frame"]);
+
+    delete benchmark;
+    benchmark = NULL;
+}
+
+//updates the uniform values in the shaders and draws the objects recorded in a snapshot
+void submitFrame(RenderSnapshot& snapshot) {
+    //start measuring the gpu time of the frame
+    environment->gpuProfiler->beginFrame();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    //update the uniform values in the shaders and draw the object on the screen
+    environment->submitSnapshot(snapshot);
+
+    //stop measuring the gpu time of the frame
+    environment->gpuProfiler->endFrame();
+
+    //close the gl call counters and the captured calls of the frame, the calls made between frames count toward the next one
+    if (GLInterceptor::instance().isInstalled) {
+        GLInterceptor::instance().endFrame();
+        GLCapture::instance().endFrame();
+    }
+}
+
+//builds and draws a single frame on the calling thread
+void renderFrame(float alpha) {
+    //draw the state between the last two simulation ticks
+    environment->interpolate(alpha);
+    environment->buildSnapshot(*environment->snapshot);
+
+    submitFrame(*environment->snapshot);
+}
+
+//checks the culling, ordering, and aliasing of the render graph in an offscreen context
+int runRenderGraphCheck() {
+    HeadlessContext context;
+
+    //terminate the program if no offscreen context can be created
+    if (!context.create()) {
+        return -1;
+    }
+
+    RenderGraphCheck check;
+    int result = check.run() ? 0 : 1;
+
+    context.destroy();
+
+    return result;
+}
+
+//replays a captured gl trace in an offscreen context and times its frames, nothing of the environment is loaded
+int runReplay(Options& options) {
+    HeadlessContext context;
+
+    //terminate the program if no offscreen context can be created
+    if (!context.create()) {
+        return -1;
+    }
+
+    LOG_INFO("REPLAY", "[REPLAY] {} - {}", context.description, glGetString(GL_RENDERER));
+
+    GLReplayer* replayer = new GLReplayer();
+    int result = -1;
+    if (replayer->load(options.replayPath)) {
+        replayer->run(options.replayLoops);
+        replayer->report();
+        replayer->exportJSON(options.replayOutput);
+        result = 0;
+    }
+
+    delete replayer;
+    context.destroy();
+
+    return result;
+}
+
+//renders the environment into an offscreen framebuffer without creating a window
+int runHeadless(Options& options) {
+    HeadlessContext context;
+
+    //terminate the program if no offscreen context can be created
+    if (!context.create()) {
+        return -1;
+    }
+
+    LOG_INFO("HEADLESS", "[HEADLESS] {} - {}", context.description, glGetString(GL_RENDERER));
+
+    startGLInterception(options, options.width, options.height);
+
+    createProgramCache(options);
+
+    //create an environment object which stores the models, lights, shaders, and cameras
+    {
+        PROFILE_ZONE("Load Environment");
+        environment = new Environment(jobSystem, programCache);
+    }
+
+    //create the render target at the requested resolution
+    Framebuffer* framebuffer = new Framebuffer(options.width, options.height);
+    framebuffer->bind();
+
+    startBenchmark(options);
+    int frameCount = benchmark ? benchmark->frameCount : options.frameCount;
+
+    for (int i = 0; i < frameCount; i++) {
+        PROFILE_ZONE("Frame");
+
+        if (benchmark) {
+            benchmark->beginFrame(environment);
         }
 
-        //implement dragging using mouse
-        if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE) {
-            environment->isMouseClicked = false;
-            //revert to normal cursor behavior
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+        streamModels();
+
+        //draw the objects on the framebuffer, headless runs have no input so the latest state is drawn as is
+        renderFrame(1.0f);
+        startupTimer.markFirstFrame();
+
+        if (benchmark) {
+            benchmark->endFrame(environment);
+        }
+
+        //write the frame to disk if an output directory was given
+        if (!options.outputDirectory.empty()) {
+            PROFILE_ZONE("Save Frame");
+            std::ostringstream path;
+            path << options.outputDirectory << "/frame_" << std::setw(5) << std::setfill('0') << i << ".ppm";
+            framebuffer->saveImage(path.str());
         }
     }
+
+    finishBenchmark(options);
+    finishGLInterception(options);
+
+    //wait for the gpu so that the last frame is complete before the context is removed
+    glFinish();
+
+    delete framebuffer;
+    delete environment; //deallocate the memory for environment
+    delete programCache;
+
+    context.destroy();
+
+    return 0;
 }
 
-int main(void)
+int main(int argc, char** argv)
 {
     GLFWwindow* window;
 
+    //read the settings from the command line
+    Options options(argc, argv);
+
+    //keep a structured copy of the log for the log collector
+    if (!options.logFile.empty() && !Logger::instance().openFile(options.logFile)) {
+        LOG_ERROR("LOG", "[LOG] Unable to open {}", options.logFile);
+    }
+
+    //start recording cpu zones right away when a trace is requested
+    CPUProfiler::instance().isEnabled = options.isTracing;
+    CPUProfiler::instance().setThreadName("Main");
+
+    //keep the gpu memory of the streamed models under the budget
+    ResidencyManager::instance().budgetBytes = (long long)options.vramBudgetMegabytes * 1024 * 1024;
+
+    //measure how the job system scales without loading anything else
+    if (options.isBenchmarkingJobs) {
+        JobBenchmark jobBenchmark;
+        jobBenchmark.run(JobSystem::defaultWorkerCount() + 1);
+        return 0;
+    }
+
+    //measure the transform kernels without loading anything else
+    if (options.isBenchmarkingTransforms) {
+        TransformBenchmark transformBenchmark;
+        transformBenchmark.run();
+        return 0;
+    }
+
+    //check the render graph on a small graph without loading anything else
+    if (options.isCheckingRenderGraph) {
+        return runRenderGraphCheck();
+    }
+
+    //run the calls of a captured trace again without loading anything else
+    if (!options.replayPath.empty()) {
+        int result = runReplay(options);
+
+        //save the cpu zones of the replay if they were recorded
+        if (options.isTracing) {
+            CPUProfiler::instance().exportTrace("cpu_trace.json");
+        }
+
+        return result;
+    }
+
+    //create the worker threads, this thread takes part in the jobs whenever it waits for them
+    jobSystem = new JobSystem(JobSystem::defaultWorkerCount());
+
+    //render offscreen when there is no display to open a window on
+    if (options.isHeadless) {
+        int result = runHeadless(options);
+        delete jobSystem;
+
+        //save the cpu zones of the session if they were recorded
+        if (options.isTracing) {
+            CPUProfiler::instance().exportTrace("cpu_trace.json");
+        }
+
+        return result;
+    }
+
     //initialize the library
-    if (!glfwInit())
+    if (!glfwInit()) {
+        delete jobSystem;
         return -1;
+    }
 
     //create a windowed mode window and its OpenGL context
     window = glfwCreateWindow(WIDTH, HEIGHT, "[Group 24] GRAPHIX Machine Project - No Man's Submarine", NULL, NULL);
@@ -155,6 +546,7 @@ int main(void)
     //terminate the program if a window is not created
     if (!window)
     {
+        delete jobSystem;
         glfwTerminate();
         return -1;
     }
@@ -164,34 +556,169 @@ int main(void)
 
     //load the glad library
     gladLoadGL();
+    startGLInterception(options, (int)WIDTH, (int)HEIGHT);
 
-    //set callbacks for key presses and cursor movement
+    createProgramCache(options);
+
+    //set callbacks for key presses and cursor movement, they queue the events for the simulation
+    inputQueue = new InputQueue();
     glfwSetKeyCallback(window, Key_Callback);
     glfwSetCursorPosCallback(window, Cursor_Callback);
     glfwSetMouseButtonCallback(window, Mouse_Button_Callback);
 
     //create an environment object which stores the models, lights, shaders, and cameras
-    environment = new Environment();
+    {
+        PROFILE_ZONE("Load Environment");
+        environment = new Environment(jobSystem, programCache);
+    }
 
     //set the size of the viewport
     glViewport(0, 0, WIDTH, HEIGHT);
 
+    //pace the frames with the display, except for the benchmark so that its frame times are not capped by the refresh rate
+    startBenchmark(options);
+    glfwSwapInterval(benchmark ? 0 : 1);
+
+    //simulate the movement at a fixed rate no matter how fast the frames are drawn
+    FixedTimestep timestep(60.0);
+    InputState input;
+
+    //keep the gpu from queueing frames ahead and measure how long input takes to reach the screen
+    FrameLimiter* frameLimiter = new FrameLimiter(options.maxFramesInFlight);
+    InputLatency inputLatency;
+    bool isCursorCaptured = false;
+
+    //build the next frame on the job system while the main thread draws the current one
+    FramePipeline* pipeline = new FramePipeline(jobSystem, environment->createSnapshot(), environment->createSnapshot());
+    int builtFrame = 0; //frame of the benchmark path that was last built
+
+    //build the first frame right away so that the pipeline has a snapshot to draw
+    if (benchmark) {
+        benchmark->applyFrame(environment, builtFrame);
+    }
+    environment->interpolate(1.0f);
+    environment->buildSnapshot(pipeline->getFront());
+
     //loop until the user closes the window
     while (!glfwWindowShouldClose(window))
     {
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        PROFILE_ZONE("Frame");
+
+        //poll for events, the callbacks queue them for the simulation of the frame that is built next
+        {
+            PROFILE_ZONE("glfwPollEvents");
+            glfwPollEvents();
+        }
+
+        std::function<void()> simulate;
+        float alpha = 1.0f;
+        if (benchmark) {
+            //follow the path of the benchmark
+            int frame = ++builtFrame;
+            simulate = [frame]() {
+                benchmark->applyFrame(environment, frame);
+            };
+        }
+        else {
+            //run as many ticks as the time since the last frame covers
+            int ticks = timestep.advance(glfwGetTime());
+            float tickLength = (float)timestep.tickLength;
+            alpha = timestep.getAlpha();
+
+            input.poll(window);
+            simulate = [ticks, tickLength, &input]() {
+                //apply the events that arrived before this frame started, then advance the ticks
+                environment->processInput(*inputQueue);
+                for (int i = 0; i < ticks; i++) {
+                    environment->simulate(input, tickLength);
+                }
+            };
+        }
 
-        //update the uniform values in the shaders and draw the object on the screen
-        environment->updateScreen();
+        //simulate the next frame and record it into the back snapshot on the job system
+        pipeline->beginBuild(simulate, [alpha](RenderSnapshot& snapshot) {
+            environment->interpolate(alpha);
+            environment->buildSnapshot(snapshot);
+        });
+
+        //wait until the gpu has room for the frame so that the input is read as late as possible
+        frameLimiter->waitForGpu();
+
+        //redo the view of the current frame with the cursor position from right now, the events that arrive
+        //here are queued and applied for good by the next simulation
+        RenderSnapshot& front = pipeline->getFront();
+        if (options.isLateLatching && !benchmark) {
+            PROFILE_ZONE("LateLatch");
+            glfwPollEvents();
+
+            double cursorX, cursorY;
+            glfwGetCursorPos(window, &cursorX, &cursorY);
+            if (LateLatch::apply(front, cursorX, cursorY)) {
+                //the frame now shows the newest cursor event, the latency is measured from when it arrived
+                front.inputTime = glm::max(front.inputTime, cursorEventTime);
+            }
+        }
+
+        //draw the objects of the current frame on the screen
+        std::chrono::steady_clock::time_point submitStart = std::chrono::steady_clock::now();
+        submitFrame(front);
 
         //swap front and back buffers
-        glfwSwapBuffers(window);
+        {
+            PROFILE_ZONE("glfwSwapBuffers");
+            glfwSwapBuffers(window);
+        }
+        startupTimer.markFirstFrame();
+        double submitMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submitStart).count();
+        frameLimiter->endFrame();
+        inputLatency.record(front.inputTime, glfwGetTime());
+
+        //draw the frame that the jobs built on the next iteration
+        pipeline->waitForBuild();
+        pipeline->swap();
+
+        //the build of the next frame has not started yet, so the models can be swapped in here
+        streamModels();
+
+        //capture the cursor while the simulation drags a camera, the window can only be changed on this thread
+        if (environment->isMouseClicked != isCursorCaptured) {
+            isCursorCaptured = environment->isMouseClicked;
+            glfwSetInputMode(window, GLFW_CURSOR, isCursorCaptured ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+        }
 
-        //poll for and process events
-        glfwPollEvents();
+        //close the window once every frame of the benchmark has been presented
+        if (benchmark) {
+            benchmark->recordStages(pipeline->buildMilliseconds, submitMilliseconds);
+            benchmark->endFrame(environment);
+
+            if (benchmark->isFinished()) {
+                glfwSetWindowShouldClose(window, GL_TRUE);
+            }
+        }
     }
 
+    delete pipeline;
+    delete frameLimiter;
+    inputLatency.print();
+
+    finishBenchmark(options);
+    finishGLInterception(options);
+
     delete environment; //deallocate the memory for environment
+    delete programCache;
+    delete jobSystem;
+
+    //stop queueing events before the queue is removed
+    glfwSetKeyCallback(window, NULL);
+    glfwSetCursorPosCallback(window, NULL);
+    glfwSetMouseButtonCallback(window, NULL);
+    delete inputQueue;
+    inputQueue = NULL;
+
+    //save the cpu zones of the session if they were recorded
+    if (CPUProfiler::instance().isEnabled) {
+        CPUProfiler::instance().exportTrace("cpu_trace.json");
+    }
 
     glfwTerminate();
 